@@ -198,10 +198,14 @@
 #define YASOLR_LBL_192 "Device: Reboot Reason"
 #define YASOLR_LBL_193 "Update SafeBoot partition"
 #define YASOLR_LBL_194 "SafeBoot Update"
-#define YASOLR_LBL_195 "Victron"
-#define YASOLR_LBL_196 "Victron Modbus TCP Server"
-#define YASOLR_LBL_197 "Victron Modbus TCP Port"
-// #define YASOLR_LBL_197
-// #define YASOLR_LBL_198
-// #define YASOLR_LBL_199
-// #define YASOLR_LBL_200
+#define YASOLR_LBL_195 "Modbus TCP Meter"
+#define YASOLR_LBL_196 "Modbus TCP Meter Server"
+#define YASOLR_LBL_197 "Modbus TCP Meter Port"
+#define YASOLR_LBL_198 "Modbus TCP Meter Model"
+#define YASOLR_LBL_199 "HTTP Meter"
+#define YASOLR_LBL_200 "HTTP Meter Server"
+#define YASOLR_LBL_201 "HTTP Meter Port"
+#define YASOLR_LBL_202 "HTTP Meter Model"
+#define YASOLR_LBL_203 "Charts Range"
+#define YASOLR_LBL_204 "7 days"
+#define YASOLR_LBL_205 "DS18 Resolution (bits)"
@@ -198,9 +198,14 @@
 #define YASOLR_LBL_192 "Micro-contrôleur: Raison du reboot"
 #define YASOLR_LBL_193 "Mettre à jour partition SafeBoot"
 #define YASOLR_LBL_194 "Mise à jour SafeBoot"
-#define YASOLR_LBL_195 "Victron"
-#define YASOLR_LBL_196 "Victron: Serveur Modbus TCP"
-#define YASOLR_LBL_197 "Victron: Port Modbus TCP"
-// #define YASOLR_LBL_198
-// #define YASOLR_LBL_199
-// #define YASOLR_LBL_200
+#define YASOLR_LBL_195 "Compteur Modbus TCP"
+#define YASOLR_LBL_196 "Compteur Modbus TCP: Serveur"
+#define YASOLR_LBL_197 "Compteur Modbus TCP: Port"
+#define YASOLR_LBL_198 "Compteur Modbus TCP: Modèle"
+#define YASOLR_LBL_199 "Compteur HTTP"
+#define YASOLR_LBL_200 "Compteur HTTP: Serveur"
+#define YASOLR_LBL_201 "Compteur HTTP: Port"
+#define YASOLR_LBL_202 "Compteur HTTP: Modèle"
+#define YASOLR_LBL_203 "Période des graphiques"
+#define YASOLR_LBL_204 "7 jours"
+#define YASOLR_LBL_205 "Résolution DS18 (bits)"
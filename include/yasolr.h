@@ -14,10 +14,12 @@
 #include <LittleFS.h>
 #include <StreamString.h>
 
+#include <MycilaAdaptiveInterval.h>
 #include <MycilaAppInfo.h>
+#include <MycilaCPUProfiler.h>
 #include <MycilaCircularBuffer.h>
 #include <MycilaConfig.h>
-#include <MycilaDS18.h>
+#include <MycilaDS18Scheduler.h>
 #include <MycilaDimmer.h>
 #include <MycilaDimmerDFRobot.h>
 #include <MycilaDimmerPWM.h>
@@ -27,12 +29,20 @@
 #include <MycilaExpiringValue.h>
 #include <MycilaGrid.h>
 #include <MycilaHADiscovery.h>
+#include <MycilaHeapMonitor.h>
+#include <MycilaHTTPMeter.h>
+#include <MycilaHTTPMeterMap.h>
 #include <MycilaJSY.h>
+#include <MycilaLogFilter.h>
 #include <MycilaLogger.h>
+#include <MycilaModbusMap.h>
+#include <MycilaModbusMeter.h>
 #include <MycilaMQTT.h>
 #include <MycilaNTP.h>
+#include <MycilaOneWireGPIO.h>
 #include <MycilaPID.h>
 #include <MycilaPZEM004Tv3.h>
+#include <MycilaPayload.h>
 #include <MycilaPulseAnalyzer.h>
 #include <MycilaRelay.h>
 #include <MycilaRouter.h>
@@ -40,12 +50,15 @@
 #include <MycilaRouterRelay.h>
 #include <MycilaString.h>
 #include <MycilaSystem.h>
+#include <MycilaTaskBudget.h>
 #include <MycilaTaskManager.h>
 #include <MycilaTaskMonitor.h>
 #include <MycilaTime.h>
+#include <MycilaTimeSeries.h>
+#include <MycilaTraceLog.h>
 #include <MycilaTrafficLight.h>
+#include <MycilaUARTBus.h>
 #include <MycilaUtilities.h>
-#include <MycilaVictron.h>
 
 #ifdef APP_MODEL_TRIAL
   #include <MycilaTrial.h>
@@ -59,7 +72,9 @@
   #include <MycilaWebSerial.h>
 #endif
 
+#include <yasolr_config.h>
 #include <yasolr_macros.h>
+#include <yasolr_settings.h>
 
 // web server
 extern AsyncWebServer webServer;
@@ -70,6 +85,7 @@ extern void yasolr_init_web_server();
 
 // Config
 extern Mycila::Config config;
+extern YaSolR::Settings settings;
 extern void yasolr_init_config();
 
 // Network
@@ -83,13 +99,18 @@ extern float yasolr_frequency();
 
 // logging
 extern Mycila::Logger logger;
+extern Mycila::CPUProfiler cpuProfiler;
+extern Mycila::LogFilter logFilter;
+extern Mycila::TraceLog traceLog;
 extern void yasolr_init_logging();
 extern void yasolr_configure_logging();
+extern bool yasolr_set_log_level(const char* tag, const char* level);
 
 // JSY
 extern Mycila::JSY* jsy;
 extern Mycila::TaskManager* jsyTaskManager;
 extern void yasolr_init_jsy();
+extern void yasolr_start_jsy();
 
 // JSY Remote
 extern AsyncUDP* udp;
@@ -98,10 +119,12 @@ extern Mycila::Task* jsyRemoteTask;
 extern void yasolr_init_jsy_remote();
 
 // DS18
-extern Mycila::DS18* ds18O1;
-extern Mycila::DS18* ds18O2;
-extern Mycila::DS18* ds18Sys;
+extern Mycila::DS18Bus* ds18O1;
+extern Mycila::DS18Bus* ds18O2;
+extern Mycila::DS18Bus* ds18Sys;
+extern Mycila::TaskManager* ds18TaskManager;
 extern void yasolr_init_ds18();
+extern void yasolr_start_ds18();
 
 // Display
 extern Mycila::EasyDisplay* display;
@@ -120,6 +143,7 @@ extern Mycila::PZEM* pzemO2;
 extern Mycila::Task* pzemO1PairingTask;
 extern Mycila::Task* pzemO2PairingTask;
 extern Mycila::TaskManager* pzemTaskManager;
+extern Mycila::UARTBus* pzemBus;
 extern void yasolr_init_pzem();
 
 // Lights
@@ -132,6 +156,8 @@ extern Mycila::Task restartTask;
 extern Mycila::Task safeBootTask;
 extern Mycila::TaskManager coreTaskManager;
 extern Mycila::TaskManager unsafeTaskManager;
+extern Mycila::TaskManager uiTaskManager;
+extern Mycila::HeapMonitor heapMonitor;
 extern void yasolr_init_system();
 extern void yasolr_init_tasks();
 
@@ -151,8 +177,42 @@ extern Mycila::RouterOutput* output1;
 extern Mycila::RouterOutput* output2;
 extern void yasolr_divert();
 extern void yasolr_init_router();
+extern void yasolr_configure_outputs();
+extern void yasolr_configure_pid();
+extern void yasolr_router_safe_state(float dutyCycle);
+
+// boot
+extern void yasolr_boot_step(const char* name, void (*init)());
+extern void yasolr_boot_async(const char* name, std::function<void()> fn);
+extern void yasolr_boot_join();
+extern void yasolr_boot_end();
+extern void yasolr_boot_toJson(const JsonObject& root);
+
+// checkpoint
+// the next boot starts cold: the checkpoint is not saved anymore until then
+extern void yasolr_checkpoint_clear();
+extern void yasolr_checkpoint_save();
+extern void yasolr_init_checkpoint();
+
+// heap guard
+#ifdef YASOLR_HEAP_GUARD
+extern void yasolr_heap_guard_arm();
+extern void yasolr_heap_guard_toJson(const JsonObject& root);
+#endif
 
-// victron
-extern Mycila::Victron* victron;
-extern Mycila::Task* victronConnectTask;
-extern void yasolr_init_victron();
+// supervisor
+extern bool yasolr_supervisor_is_safe_state();
+extern void yasolr_init_supervisor();
+extern void yasolr_supervisor_control_cycle();
+extern void yasolr_supervisor_toJson(const JsonObject& root);
+
+// http meter
+extern Mycila::HTTPMeter* httpMeter;
+extern Mycila::Task* httpMeterConnectTask;
+extern Mycila::TaskManager* httpMeterTaskManager;
+extern void yasolr_init_http_meter();
+
+// modbus meter
+extern Mycila::ModbusMeter* modbusMeter;
+extern Mycila::Task* modbusMeterConnectTask;
+extern void yasolr_init_modbus_meter();
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#pragma once
+
+#include <yasolr_macros.h>
+
+#include <map>
+#include <string>
+
+namespace YaSolR {
+  class ConfigReader;
+
+  // Applies a set of configuration changes at once:
+  // - all the keys and values are validated before anything is written
+  // - the values are written in one config.set() call
+  // - the side effects (PID reconfiguration, dashboard and MQTT config refresh) run once for the whole set
+  // - whether a restart is needed is known before committing
+  class ConfigTransaction {
+    public:
+      // adds a change to the transaction. returns false and records the error if the key is unknown or the value invalid.
+      bool set(const char* key, const std::string& value);
+
+      bool isValid() const { return _error.empty(); }
+      const std::string& getError() const { return _error; }
+
+      // number of keys whose value changes
+      size_t size() const { return _values.size(); }
+
+      // true if at least one changed key is only read at startup
+      bool isRestartRequired() const { return _restartRequired; }
+
+      // writes the changes and runs their side effects. returns false if the transaction is invalid.
+      bool commit();
+
+    private:
+      friend class ConfigReader;
+      std::map<const char*, std::string> _values;
+      std::string _error;
+      bool _restartRequired = false;
+  };
+
+  // Serializes the configuration as key=value lines, one buffer at a time.
+  // Only the line being written is held in memory.
+  class ConfigWriter {
+    public:
+      // fills the buffer with the next bytes. returns 0 when all the keys have been written.
+      size_t read(uint8_t* buffer, size_t maxLen);
+
+    private:
+      size_t _index = 0;
+      size_t _offset = 0;
+      std::string _line;
+  };
+
+  // Parses key=value lines as they arrive and validates them in a transaction.
+  // Lines can be split across chunks: only the current line is buffered.
+  // Keys unknown to this firmware version are skipped.
+  class ConfigReader {
+    public:
+      // returns false as soon as a line is malformed, too long or has an invalid value
+      bool write(const uint8_t* data, size_t len);
+
+      // parses the last line if it has no line ending
+      bool end();
+
+      size_t getSkipped() const { return _skipped; }
+      ConfigTransaction& transaction() { return _transaction; }
+
+    private:
+      ConfigTransaction _transaction;
+      std::string _line;
+      size_t _skipped = 0;
+
+      bool _parse();
+  };
+} // namespace YaSolR
@@ -6,22 +6,98 @@
 
 #include <yasolr.h>
 
+#include <atomic>
+#include <cmath>
+#include <initializer_list>
+#include <optional>
 #include <string>
 #include <unordered_map>
 
 namespace YaSolR {
   class Website {
     public:
+      // groups of cards initialized together by initCards()
+      enum class Section : uint8_t {
+        STATISTICS,
+        HOME,
+        TABS,
+        OUTPUT1,
+        OUTPUT2,
+        RELAYS,
+        SYSTEM,
+        DEBUG,
+        NETWORK,
+        NTP,
+        MQTT,
+        PID,
+        GPIO,
+        HARDWARE,
+        OUTPUT1_CONFIG,
+        OUTPUT2_CONFIG,
+        COUNT
+      };
+
       void begin();
+      // initialize the cards of the sections invalidated since the last call
       void initCards();
+      void invalidate(std::initializer_list<Section> sections);
+      // invalidate the sections showing a configuration key
+      void invalidate(const char* key);
+      void invalidateAll();
       void updateCards();
+      // samples the grid power, routed power and THDi into the charts history
+      void updateHistory();
       void updateCharts();
+      // samples the PID input, output, error and terms into the PID charts history
+      void updatePIDHistory();
       void updatePIDCharts();
       void resetPIDCharts();
       bool realTimePIDEnabled() const;
       void setSafeBootUpdateStatus(const char* msg, dash::Status status);
 
     private:
+      // incremented when a section has to be initialized again: initCards() compares them with the generations it initialized
+      std::atomic<uint32_t> _generations[static_cast<size_t>(Section::COUNT)] = {};
+      uint32_t _initialized[static_cast<size_t>(Section::COUNT)] = {};
+
+      void _initSection(Section section);
+      void _initStatistics();
+      void _initHome();
+#ifdef APP_MODEL_PRO
+      void _initTabs();
+      void _initOutput1();
+      void _initOutput2();
+      void _initRelays();
+      void _initSystem();
+      void _initDebug();
+      void _initNetwork();
+      void _initNTP();
+      void _initMQTT();
+      void _initPID();
+      void _initGPIO();
+      void _initHardware();
+      void _initOutput1Config();
+      void _initOutput2Config();
+#endif
+
+      // sets a card value rounded to the step: changes smaller than the step are not sent to the dashboard
+      template <typename C>
+      static void _setQuantized(C& card, float value, float step) {
+        if (!std::isnan(value))
+          value = std::round(value / step) * step;
+        const std::optional<float> current = card.optional();
+        if (current.has_value() && (current.value() == value || (std::isnan(current.value()) && std::isnan(value))))
+          return;
+        card.setValue(value);
+      }
+
+      // sets a card value only when it changed
+      template <typename C, typename T>
+      static void _setChanged(C& card, T value) {
+        if (card.optional() != value)
+          card.setValue(value);
+      }
+
       void _boolConfig(dash::SwitchCard& card, const char* key) {
         card.onChange([key, &card, this](bool value) {
           config.setBool(key, value);
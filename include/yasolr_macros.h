@@ -43,6 +43,23 @@
 // default settings
 
 #define YASOLR_ADMIN_USERNAME              "admin"
+#define YASOLR_BOOT_MAX_PROBES             8
+#define YASOLR_BOOT_PROBE_STACK_SIZE       4096
+#define YASOLR_BUDGET_DASHBOARD            100000 // us
+#define YASOLR_BUDGET_RELAY                5000   // us
+#define YASOLR_BUDGET_ROUTER               5000   // us
+#define YASOLR_CHECKPOINT_INTERVAL         1000 // ms: control state saved in RTC memory
+#define YASOLR_CONFIG_LINE_MAX_SIZE        4096 // bytes: longest key=value line accepted by a config restore (NVS strings are up to 4000 bytes)
+#define YASOLR_CPU_PROFILER_INTERVAL       5000
+#define YASOLR_DASH_STEP_CURRENT           0.01f // A: smaller changes are not sent to the dashboard
+#define YASOLR_DASH_STEP_FREQUENCY         0.1f  // Hz
+#define YASOLR_DASH_STEP_PERCENT           0.1f  // %: duty cycle, THDi, heap usage
+#define YASOLR_DASH_STEP_POWER             1.0f  // W, VA
+#define YASOLR_DASH_STEP_RATIO             0.01f // power factor
+#define YASOLR_DASH_STEP_RESISTANCE        0.1f  // Ω
+#define YASOLR_DASH_STEP_TEMPERATURE       0.1f  // °C
+#define YASOLR_DASH_STEP_VOLTAGE           1.0f  // V
+#define YASOLR_DEADLINE_ROUTER             750    // ms: router task runs every 500 ms
 #define YASOLR_DIMMER_LSA_GP8211S          "LSA + DAC GP8211S (DFR1071)"
 #define YASOLR_DIMMER_LSA_GP8403           "LSA + DAC GP8403 (DFR0971)"
 #define YASOLR_DIMMER_LSA_GP8413           "LSA + DAC GP8413 (DFR1073)"
@@ -52,10 +69,39 @@
 #define YASOLR_DIMMER_ROBODYN              "Robodyn 24A / 40A"
 #define YASOLR_DIMMER_TRIAC                "Triac + ZCD"
 #define YASOLR_DIMMER_ZC_SSR               "Zero-crossing Solid State Relay"
+#define YASOLR_DIMMER_TYPES                YASOLR_DIMMER_LSA_GP8211S "," YASOLR_DIMMER_LSA_GP8403 "," YASOLR_DIMMER_LSA_GP8413 "," YASOLR_DIMMER_LSA_PWM "," YASOLR_DIMMER_LSA_PWM_ZCD "," YASOLR_DIMMER_RANDOM_SSR "," YASOLR_DIMMER_ROBODYN "," YASOLR_DIMMER_TRIAC "," YASOLR_DIMMER_ZC_SSR
+#define YASOLR_DISPLAY_TYPES               "SH1106,SH1107,SSD1306"
+#define YASOLR_DS18_OUTPUT_READ_INTERVAL   2000
+#define YASOLR_DS18_RESOLUTION_CHOICES     "9,10,11,12"
 #define YASOLR_DS18_SEARCH_MAX_RETRY       30
+#define YASOLR_DS18_SEARCH_RETRY_DELAY     10
+#define YASOLR_DS18_SYSTEM_READ_INTERVAL   10000
 #define YASOLR_GRAPH_POINTS                60
+#define YASOLR_GRID_POLL_ACTIVITY_HIGH     200  // W: poll at the minimum interval above this power deviation
+#define YASOLR_GRID_POLL_ACTIVITY_LOW      20   // W: poll at the maximum interval below this power deviation
+#define YASOLR_GRID_POLL_INTERVAL_MAX      3000 // must stay below grid metrics expiration
+#define YASOLR_GRID_POLL_INTERVAL_MIN      250
+#define YASOLR_GRID_POLL_VARIANCE_ALPHA    0.2f
+#define YASOLR_HEAP_CRITICAL_BLOCK         8192  // bytes: restart when the largest internal free block stays below
+#define YASOLR_HEAP_CRITICAL_SAMPLES       30    // for this number of consecutive samples
+#define YASOLR_HEAP_MONITOR_INTERVAL       10000
 #define YASOLR_HIDDEN_PWD                  "********"
+#define YASOLR_HISTORY_10S_POINTS          360  // 1 h at 10 s
+#define YASOLR_HISTORY_15M_POINTS          672  // 7 days at 15 min
+#define YASOLR_HISTORY_1M_POINTS           240  // 4 h at 1 min
+#define YASOLR_HISTORY_1S_POINTS           60   // 1 min at 1 s
+#define YASOLR_HISTORY_INTERVAL            1000 // ms: one sample of the charts history
+#define YASOLR_HTTP_METER_CONNECT_RETRY    10000 // ms: delay between two attempts to resolve the meter address
+#define YASOLR_HTTP_METER_MODELS           "Enphase Envoy,Shelly Pro 3EM,Shelly Pro EM,Tasmota"
+#define YASOLR_LOG_BUFFER_SIZE             2048 // bytes: RAM ring buffer, kept in RTC memory to survive a crash
 #define YASOLR_LOG_FILE                    "/logs.txt"
+#define YASOLR_LOG_FILE_ROTATED            "/logs.%u.txt"
+#define YASOLR_LOG_FILE_SIZE               8192 // bytes per file
+#define YASOLR_LOG_FILES                   4    // current file + rotated files
+#define YASOLR_LOG_FLUSH_DELAY             5000 // ms: buffered logs are written at least this often
+#define YASOLR_LOG_FLUSH_INTERVAL          250  // ms
+#define YASOLR_LOG_FLUSH_SIZE              1024 // bytes: buffered logs are written as soon as they reach this size
+#define YASOLR_MODBUS_METER_MODELS         "Fronius,SMA,SolarEdge,Victron"
 #define YASOLR_MQTT_KEEPALIVE              60
 #define YASOLR_MQTT_MEASUREMENT_EXPIRATION 60000
 #define YASOLR_MQTT_SERVER_CERT_FILE       "/mqtt-server.pem"
@@ -69,16 +115,29 @@
 #define YASOLR_PID_P_MODE_1                "1: On Error"
 #define YASOLR_PID_P_MODE_2                "2: On Input"
 #define YASOLR_PID_P_MODE_3                "3: Both"
+#define YASOLR_PSRAM_MALLOC_THRESHOLD      1024 // bytes: smaller allocations stay in internal RAM
 #define YASOLR_PZEM_ADDRESS_OUTPUT1        0x01
 #define YASOLR_PZEM_ADDRESS_OUTPUT2        0x02
+#define YASOLR_PZEM_IDLE_INTERVAL          1000
 #define YASOLR_RELAY_TYPE_NC               "NC"
 #define YASOLR_RELAY_TYPE_NO               "NO"
+#define YASOLR_RELAY_TYPES                 YASOLR_RELAY_TYPE_NO "," YASOLR_RELAY_TYPE_NC
 #define YASOLR_SAFEBOOT_PARTITION_NAME     "safeboot" // See: https://github.com/mathieucarbou/MycilaSafeBoot
 #define YASOLR_SAFEBOOT_PARTITION_SIZE     655360     // See: https://github.com/mathieucarbou/MycilaSafeBoot
 #define YASOLR_SERIAL_BAUDRATE             115200
+#define YASOLR_SUPERVISOR_CONTROL_DEADLINE 2000  // ms: router task runs every 500 ms
+#define YASOLR_SUPERVISOR_GRID_DEADLINE    10000 // ms: no grid measurement while auto dimmers are on
+#define YASOLR_SUPERVISOR_INTERVAL         250
+#define YASOLR_SUPERVISOR_RESTART_DELAY    10000 // ms: in safe state before restarting after a control loop stall
+#define YASOLR_SUPERVISOR_SAFE_DUTY        0.0f  // duty cycle applied to the dimmers in safe state
+#define YASOLR_SUPERVISOR_ZC_DEADLINE      1000  // ms: no zero-cross pulse while a dimmer is on
+#define YASOLR_TRACE_LOG_INTERVAL          200   // ms: deferred debug logs are formatted this often
 #define YASOLR_UART_1_NAME                 "Serial1"
 #define YASOLR_UART_2_NAME                 "Serial2"
 #define YASOLR_UART_NONE                   "N/A"
+#define YASOLR_WEBSERIAL_BUFFER_SIZE       4096 // bytes: pending console lines, oldest dropped first
+#define YASOLR_WEBSERIAL_FRAME_SIZE        1024 // bytes: largest websocket message sent to the console
+#define YASOLR_WEBSERIAL_INTERVAL          250
 #define YASOLR_WEEK_DAYS                   "sun,mon,tue,wed,thu,fri,sat"
 #define YASOLR_WEEK_DAYS_EMPTY             "none"
 
@@ -97,8 +156,6 @@
 // UDP communication
 
 #define YASOLR_UDP_PORT 53964
-// #define YASOLR_UDP_MSG_TYPE_JSY_DATA 0x01 // old json
-#define YASOLR_UDP_MSG_TYPE_JSY_DATA 0x02 // new json
 
 // password configuration keys
 
@@ -111,9 +168,11 @@
 #define KEY_ENABLE_DISPLAY             "disp_enable"
 #define KEY_ENABLE_DS18_SYSTEM         "ds18_sys_enable"
 #define KEY_ENABLE_HA_DISCOVERY        "ha_disco_enable"
+#define KEY_ENABLE_HTTP_METER          "http_mt_enable"
 #define KEY_ENABLE_JSY                 "jsy_enable"
 #define KEY_ENABLE_JSY_REMOTE          "jsyr_enable"
 #define KEY_ENABLE_LIGHTS              "lights_enable"
+#define KEY_ENABLE_MODBUS_METER        "vic_mb_enable"
 #define KEY_ENABLE_MQTT                "mqtt_enable"
 #define KEY_ENABLE_OUTPUT1_AUTO_BYPASS "o1_ab_enable"
 #define KEY_ENABLE_OUTPUT1_AUTO_DIMMER "o1_ad_enable"
@@ -129,7 +188,6 @@
 #define KEY_ENABLE_OUTPUT2_RELAY       "o2_relay_enable"
 #define KEY_ENABLE_RELAY1              "relay1_enable"
 #define KEY_ENABLE_RELAY2              "relay2_enable"
-#define KEY_ENABLE_VICTRON_MODBUS      "vic_mb_enable"
 #define KEY_ENABLE_ZCD                 "zcd_enable"
 
 // configuration keys
@@ -137,11 +195,18 @@
 #define KEY_DISPLAY_ROTATION               "disp_angle"
 #define KEY_DISPLAY_SPEED                  "disp_speed"
 #define KEY_DISPLAY_TYPE                   "disp_type"
+#define KEY_DS18_SYSTEM_RESOLUTION         "ds18_sys_res"
 #define KEY_GRID_FREQUENCY                 "grid_freq"
 #define KEY_GRID_POWER_MQTT_TOPIC          "grid_pow_mqtt"
 #define KEY_GRID_VOLTAGE_MQTT_TOPIC        "grid_volt_mqtt"
 #define KEY_HA_DISCOVERY_TOPIC             "ha_disco_topic"
+#define KEY_HTTP_METER_MODEL               "http_mt_model"
+#define KEY_HTTP_METER_PORT                "http_mt_port"
+#define KEY_HTTP_METER_SERVER              "http_mt_server"
 #define KEY_JSY_UART                       "jsy_uart"
+#define KEY_MODBUS_METER_MODEL             "vic_mb_model"
+#define KEY_MODBUS_METER_PORT              "vic_mb_port"
+#define KEY_MODBUS_METER_SERVER            "vic_mb_server"
 #define KEY_MQTT_PASSWORD                  "mqtt_pwd"
 #define KEY_MQTT_PORT                      "mqtt_port"
 #define KEY_MQTT_PUBLISH_INTERVAL          "mqtt_pub_itvl"
@@ -161,6 +226,7 @@
 #define KEY_OUTPUT1_DIMMER_MIN             "o1_dim_min"
 #define KEY_OUTPUT1_DIMMER_TEMP_LIMITER    "o1_dim_max_t"
 #define KEY_OUTPUT1_DIMMER_TYPE            "o1_dim_type"
+#define KEY_OUTPUT1_DS18_RESOLUTION        "o1_ds18_res"
 #define KEY_OUTPUT1_EXCESS_LIMITER         "o1_excess_limit"
 #define KEY_OUTPUT1_RELAY_TYPE             "o1_relay_type"
 #define KEY_OUTPUT1_RESISTANCE             "o1_resistance"
@@ -175,6 +241,7 @@
 #define KEY_OUTPUT2_DIMMER_MIN             "o2_dim_min"
 #define KEY_OUTPUT2_DIMMER_TEMP_LIMITER    "o2_dim_max_t"
 #define KEY_OUTPUT2_DIMMER_TYPE            "o2_dim_type"
+#define KEY_OUTPUT2_DS18_RESOLUTION        "o2_ds18_res"
 #define KEY_OUTPUT2_EXCESS_LIMITER         "o2_excess_limit"
 #define KEY_OUTPUT2_RELAY_TYPE             "o2_relay_type"
 #define KEY_OUTPUT2_RESISTANCE             "o2_resistance"
@@ -199,8 +266,6 @@
 #define KEY_RELAY2_LOAD                    "relay2_load"
 #define KEY_RELAY2_TYPE                    "relay2_type"
 #define KEY_UDP_PORT                       "udp_port"
-#define KEY_VICTRON_MODBUS_PORT            "vic_mb_port"
-#define KEY_VICTRON_MODBUS_SERVER          "vic_mb_server"
 #define KEY_WIFI_PASSWORD                  "wifi_pwd"
 #define KEY_WIFI_SSID                      "wifi_ssid"
 
@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#pragma once
+
+#include <yasolr_macros.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Settings read from tasks and callbacks.
+// They are parsed once when the configuration is loaded and each time their key changes,
+// so that hot paths read a plain field instead of looking up and parsing a string key.
+// Caching a key does not apply it live: keys only read at startup still need a restart (see hotKeys in yasolr_config.cpp).
+//
+// X(id, field, type, key)
+#define YASOLR_SETTINGS(X)                                                                            \
+  X(AP_MODE, apMode, bool, KEY_ENABLE_AP_MODE)                                                        \
+  X(DISPLAY_SPEED, displaySpeed, uint32_t, KEY_DISPLAY_SPEED)                                         \
+  X(GRID_FREQUENCY, gridFrequency, float, KEY_GRID_FREQUENCY)                                         \
+  X(HA_DISCOVERY, haDiscovery, bool, KEY_ENABLE_HA_DISCOVERY)                                         \
+  X(HA_DISCOVERY_TOPIC, haDiscoveryTopic, std::string, KEY_HA_DISCOVERY_TOPIC)                        \
+  X(HTTP_METER_MODEL, httpMeterModel, std::string, KEY_HTTP_METER_MODEL)                              \
+  X(HTTP_METER_PORT, httpMeterPort, uint32_t, KEY_HTTP_METER_PORT)                                    \
+  X(HTTP_METER_SERVER, httpMeterServer, std::string, KEY_HTTP_METER_SERVER)                           \
+  X(MODBUS_METER_MODEL, modbusMeterModel, std::string, KEY_MODBUS_METER_MODEL)                        \
+  X(MODBUS_METER_PORT, modbusMeterPort, uint32_t, KEY_MODBUS_METER_PORT)                              \
+  X(MODBUS_METER_SERVER, modbusMeterServer, std::string, KEY_MODBUS_METER_SERVER)                     \
+  X(MQTT_PASSWORD, mqttPassword, std::string, KEY_MQTT_PASSWORD)                                      \
+  X(MQTT_PORT, mqttPort, uint32_t, KEY_MQTT_PORT)                                                     \
+  X(MQTT_PUBLISH_INTERVAL, mqttPublishInterval, uint32_t, KEY_MQTT_PUBLISH_INTERVAL)                  \
+  X(MQTT_SECURED, mqttSecured, bool, KEY_MQTT_SECURED)                                                \
+  X(MQTT_SERVER, mqttServer, std::string, KEY_MQTT_SERVER)                                            \
+  X(MQTT_TOPIC, mqttTopic, std::string, KEY_MQTT_TOPIC)                                               \
+  X(MQTT_USERNAME, mqttUsername, std::string, KEY_MQTT_USERNAME)                                      \
+  X(NTP_SERVER, ntpServer, std::string, KEY_NTP_SERVER)                                               \
+  X(NTP_TIMEZONE, ntpTimezone, std::string, KEY_NTP_TIMEZONE)                                         \
+  X(OUTPUT1_AUTO_BYPASS, output1AutoBypass, bool, KEY_ENABLE_OUTPUT1_AUTO_BYPASS)                     \
+  X(OUTPUT1_AUTO_DIMMER, output1AutoDimmer, bool, KEY_ENABLE_OUTPUT1_AUTO_DIMMER)                     \
+  X(OUTPUT1_DAYS, output1Days, std::string, KEY_OUTPUT1_DAYS)                                         \
+  X(OUTPUT1_DIMMER_LIMIT, output1DimmerLimit, float, KEY_OUTPUT1_DIMMER_LIMIT)                        \
+  X(OUTPUT1_DIMMER_MAX, output1DimmerMax, float, KEY_OUTPUT1_DIMMER_MAX)                              \
+  X(OUTPUT1_DIMMER_MIN, output1DimmerMin, float, KEY_OUTPUT1_DIMMER_MIN)                              \
+  X(OUTPUT1_DIMMER_TEMP_LIMITER, output1DimmerTempLimiter, uint32_t, KEY_OUTPUT1_DIMMER_TEMP_LIMITER) \
+  X(OUTPUT1_EXCESS_LIMITER, output1ExcessLimiter, uint32_t, KEY_OUTPUT1_EXCESS_LIMITER)               \
+  X(OUTPUT1_PZEM, output1PZEM, bool, KEY_ENABLE_OUTPUT1_PZEM)                                         \
+  X(OUTPUT1_RESISTANCE, output1Resistance, float, KEY_OUTPUT1_RESISTANCE)                             \
+  X(OUTPUT1_TEMPERATURE_START, output1TemperatureStart, uint32_t, KEY_OUTPUT1_TEMPERATURE_START)      \
+  X(OUTPUT1_TEMPERATURE_STOP, output1TemperatureStop, uint32_t, KEY_OUTPUT1_TEMPERATURE_STOP)         \
+  X(OUTPUT1_TIME_START, output1TimeStart, std::string, KEY_OUTPUT1_TIME_START)                        \
+  X(OUTPUT1_TIME_STOP, output1TimeStop, std::string, KEY_OUTPUT1_TIME_STOP)                           \
+  X(OUTPUT2_AUTO_BYPASS, output2AutoBypass, bool, KEY_ENABLE_OUTPUT2_AUTO_BYPASS)                     \
+  X(OUTPUT2_AUTO_DIMMER, output2AutoDimmer, bool, KEY_ENABLE_OUTPUT2_AUTO_DIMMER)                     \
+  X(OUTPUT2_DAYS, output2Days, std::string, KEY_OUTPUT2_DAYS)                                         \
+  X(OUTPUT2_DIMMER_LIMIT, output2DimmerLimit, float, KEY_OUTPUT2_DIMMER_LIMIT)                        \
+  X(OUTPUT2_DIMMER_MAX, output2DimmerMax, float, KEY_OUTPUT2_DIMMER_MAX)                              \
+  X(OUTPUT2_DIMMER_MIN, output2DimmerMin, float, KEY_OUTPUT2_DIMMER_MIN)                              \
+  X(OUTPUT2_DIMMER_TEMP_LIMITER, output2DimmerTempLimiter, uint32_t, KEY_OUTPUT2_DIMMER_TEMP_LIMITER) \
+  X(OUTPUT2_EXCESS_LIMITER, output2ExcessLimiter, uint32_t, KEY_OUTPUT2_EXCESS_LIMITER)               \
+  X(OUTPUT2_PZEM, output2PZEM, bool, KEY_ENABLE_OUTPUT2_PZEM)                                         \
+  X(OUTPUT2_RESISTANCE, output2Resistance, float, KEY_OUTPUT2_RESISTANCE)                             \
+  X(OUTPUT2_TEMPERATURE_START, output2TemperatureStart, uint32_t, KEY_OUTPUT2_TEMPERATURE_START)      \
+  X(OUTPUT2_TEMPERATURE_STOP, output2TemperatureStop, uint32_t, KEY_OUTPUT2_TEMPERATURE_STOP)         \
+  X(OUTPUT2_TIME_START, output2TimeStart, std::string, KEY_OUTPUT2_TIME_START)                        \
+  X(OUTPUT2_TIME_STOP, output2TimeStop, std::string, KEY_OUTPUT2_TIME_STOP)                           \
+  X(PID_D_MODE, pidDMode, uint32_t, KEY_PID_D_MODE)                                                   \
+  X(PID_IC_MODE, pidICMode, uint32_t, KEY_PID_IC_MODE)                                                \
+  X(PID_KD, pidKd, float, KEY_PID_KD)                                                                 \
+  X(PID_KI, pidKi, float, KEY_PID_KI)                                                                 \
+  X(PID_KP, pidKp, float, KEY_PID_KP)                                                                 \
+  X(PID_OUT_MAX, pidOutMax, float, KEY_PID_OUT_MAX)                                                   \
+  X(PID_OUT_MIN, pidOutMin, float, KEY_PID_OUT_MIN)                                                   \
+  X(PID_P_MODE, pidPMode, uint32_t, KEY_PID_P_MODE)                                                   \
+  X(PID_SETPOINT, pidSetpoint, float, KEY_PID_SETPOINT)                                               \
+  X(PZEM_PIN_RX, pzemPinRx, int32_t, KEY_PIN_PZEM_RX)                                                 \
+  X(PZEM_PIN_TX, pzemPinTx, int32_t, KEY_PIN_PZEM_TX)                                                 \
+  X(PZEM_UART, pzemUart, std::string, KEY_PZEM_UART)                                                  \
+  X(RELAY1_LOAD, relay1Load, uint32_t, KEY_RELAY1_LOAD)                                               \
+  X(RELAY2_LOAD, relay2Load, uint32_t, KEY_RELAY2_LOAD)
+
+namespace YaSolR {
+  enum class Setting : uint8_t {
+#define YASOLR_SETTING_ID(id, field, type, key) id,
+    YASOLR_SETTINGS(YASOLR_SETTING_ID)
+#undef YASOLR_SETTING_ID
+    COUNT
+  };
+
+  class Settings {
+    public:
+      typedef std::function<void()> Listener;
+
+#define YASOLR_SETTING_FIELD(id, field, type, key) type field{};
+      YASOLR_SETTINGS(YASOLR_SETTING_FIELD)
+#undef YASOLR_SETTING_FIELD
+
+      // parse all the settings from the configuration
+      void load();
+
+      // parse the setting of a configuration key if it is cached and call its listeners.
+      // returns false if the key is not a cached setting.
+      bool update(const char* key);
+
+      // called after the setting was parsed again following a configuration change
+      void listen(Setting setting, Listener listener) { _listeners[static_cast<size_t>(setting)].push_back(std::move(listener)); }
+
+      static const char* key(Setting setting);
+
+    private:
+      std::vector<Listener> _listeners[static_cast<size_t>(Setting::COUNT)];
+  };
+} // namespace YaSolR
@@ -21,6 +21,7 @@
 
 #include <HardwareSerial.h>
 #include <MycilaCircularBuffer.h>
+#include <MycilaISRStats.h>
 
 #include <esp32-hal-gpio.h>
 
@@ -515,6 +516,7 @@ void ARDUINO_ISR_ATTR isr_selector() {
 #else
 void isr_selector() {
 #endif
+  MYCILA_ISR_PROFILE(Mycila::ISRProfiler::thyristor);
   if (nextISR == INT_TYPE::ACTIVATE_THYRISTORS) {
     activate_thyristors();
   } else if (nextISR == INT_TYPE::TURN_OFF_GATES) {
@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// This file does not depend on Arduino: it can be compiled and checked on host.
+
+namespace Mycila {
+  /**
+   * @brief Computes a polling interval for a grid source: fast when grid power moves or when the PID is far from its setpoint, and slow when everything is stable (e.g. at night).
+   */
+  class AdaptiveInterval {
+    public:
+      /**
+       * @param min: the interval in ms used when activity is above high
+       * @param max: the interval in ms used when activity is below low
+       * @param low: the power deviation in W under which the interval is max
+       * @param high: the power deviation in W above which the interval is min
+       * @param alpha: the weight of the last sample in the power mean and variance
+       */
+      AdaptiveInterval(uint32_t min, uint32_t max, float low, float high, float alpha) : _min(min), _max(max), _low(low), _high(high), _alpha(alpha), _interval(min) {}
+
+      /**
+       * @brief Update the interval with a new power sample and the current PID error.
+       *
+       * The interval shrinks immediately and grows back progressively (25% at most per sample).
+       *
+       * @param power: the grid power in W
+       * @param error: the PID error in W, or NAN to only use the power deviation (e.g. when the PID cannot act on its error)
+       *
+       * @return the new interval in ms
+       */
+      uint32_t update(float power, float error) {
+        if (std::isnan(power))
+          return _interval;
+
+        // exponentially weighted mean and variance of the grid power
+        if (std::isnan(_mean)) {
+          _mean = power;
+          _variance = 0;
+        } else {
+          const float diff = power - _mean;
+          _mean += _alpha * diff;
+          _variance = (1 - _alpha) * (_variance + _alpha * diff * diff);
+        }
+
+        const float activity = std::max(std::sqrt(_variance), std::isnan(error) ? 0 : std::abs(error));
+        const float ratio = std::min(1.0f, std::max(0.0f, (activity - _low) / (_high - _low)));
+        const uint32_t target = _max - ratio * (_max - _min);
+
+        _interval = target < _interval ? target : std::min(target, _interval + _interval / 4);
+        return _interval;
+      }
+
+      uint32_t getInterval() const { return _interval; }
+      float getDeviation() const { return std::sqrt(_variance); }
+
+    private:
+      const uint32_t _min;
+      const uint32_t _max;
+      const float _low;
+      const float _high;
+      const float _alpha;
+      uint32_t _interval;
+      float _mean = NAN;
+      float _variance = 0;
+  };
+} // namespace Mycila
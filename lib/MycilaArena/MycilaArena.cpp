@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#include <MycilaArena.h>
+
+#include <cstdlib>
+#include <cstring>
+
+// each block is prefixed by its size so that it can be copied when moved
+#define HEADER_SIZE alignof(std::max_align_t)
+
+static size_t _align(size_t size) {
+  return (size + HEADER_SIZE - 1) & ~(HEADER_SIZE - 1);
+}
+
+static size_t _blockSize(const void* ptr) {
+  size_t size;
+  memcpy(&size, static_cast<const uint8_t*>(ptr) - HEADER_SIZE, sizeof(size));
+  return size;
+}
+
+void* Mycila::Arena::allocate(size_t size) {
+  const size_t needed = HEADER_SIZE + _align(size);
+
+  if (needed > _size - _offset) {
+    _fallbacks++;
+    return malloc(size);
+  }
+
+  uint8_t* block = _buffer + _offset;
+  memcpy(block, &size, sizeof(size));
+
+  _last = _offset;
+  _offset += needed;
+  _live++;
+
+  if (_offset > _highWaterMark)
+    _highWaterMark = _offset;
+
+  return block + HEADER_SIZE;
+}
+
+void Mycila::Arena::deallocate(void* ptr) {
+  if (ptr == nullptr)
+    return;
+
+  if (!_owns(ptr)) {
+    free(ptr);
+    return;
+  }
+
+  // the whole arena is reusable once the document is destroyed or cleared
+  if (--_live == 0) {
+    _offset = 0;
+    _last = 0;
+  }
+}
+
+void* Mycila::Arena::reallocate(void* ptr, size_t newSize) {
+  if (ptr == nullptr)
+    return allocate(newSize);
+
+  if (!_owns(ptr))
+    return realloc(ptr, newSize);
+
+  uint8_t* block = static_cast<uint8_t*>(ptr) - HEADER_SIZE;
+
+  // the last block can grow or shrink in place
+  if (block == _buffer + _last && HEADER_SIZE + _align(newSize) <= _size - _last) {
+    memcpy(block, &newSize, sizeof(newSize));
+    _offset = _last + HEADER_SIZE + _align(newSize);
+    if (_offset > _highWaterMark)
+      _highWaterMark = _offset;
+    return ptr;
+  }
+
+  const size_t oldSize = _blockSize(ptr);
+
+  // shrinking elsewhere keeps the block
+  if (newSize <= oldSize) {
+    memcpy(block, &newSize, sizeof(newSize));
+    return ptr;
+  }
+
+  void* moved = allocate(newSize);
+  if (moved == nullptr)
+    return nullptr;
+
+  memcpy(moved, ptr, oldSize);
+  deallocate(ptr);
+  return moved;
+}
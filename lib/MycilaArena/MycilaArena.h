@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#pragma once
+
+#include <ArduinoJson.h>
+
+#include <cstddef>
+#include <cstdint>
+
+// This file only depends on ArduinoJson: it can be compiled and checked on host.
+
+namespace Mycila {
+  /**
+   * @brief ArduinoJson allocator serving the allocations of a document from a fixed buffer, to parse messages without touching the heap.
+   *
+   * Memory is handed out linearly and reclaimed all at once when every block has been released,
+   * which matches the lifetime of a JsonDocument used to parse one message.
+   * Allocations that do not fit fall back to the heap and are counted.
+   *
+   * Not thread-safe: use one arena per task.
+   */
+  class Arena : public ArduinoJson::Allocator {
+    public:
+      Arena(uint8_t* buffer, size_t size) : _buffer(buffer), _size(size) {}
+
+      void* allocate(size_t size) override;
+      void deallocate(void* ptr) override;
+      void* reallocate(void* ptr, size_t newSize) override;
+
+      size_t getSize() const { return _size; }
+      // maximum number of bytes used at once
+      size_t getHighWaterMark() const { return _highWaterMark; }
+      // number of allocations served by the heap because the arena was full
+      uint32_t getFallbacks() const { return _fallbacks; }
+
+#ifdef MYCILA_JSON_SUPPORT
+      void toJson(const JsonObject& root) const {
+        root["size"] = _size;
+        root["high_water_mark"] = _highWaterMark;
+        root["fallbacks"] = _fallbacks;
+      }
+#endif
+
+    private:
+      uint8_t* _buffer;
+      size_t _size;
+      // start of the free space
+      size_t _offset = 0;
+      // start of the last block, which can be resized in place
+      size_t _last = 0;
+      // number of blocks not released yet
+      size_t _live = 0;
+      size_t _highWaterMark = 0;
+      uint32_t _fallbacks = 0;
+
+      bool _owns(const void* ptr) const { return ptr >= _buffer && ptr < _buffer + _size; }
+  };
+
+  template <size_t N>
+  class StaticArena : public Arena {
+    public:
+      StaticArena() : Arena(_storage, N) {}
+
+    private:
+      alignas(std::max_align_t) uint8_t _storage[N];
+  };
+} // namespace Mycila
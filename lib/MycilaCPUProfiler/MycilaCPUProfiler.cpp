@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#include <MycilaCPUProfiler.h>
+
+#include <esp32-hal.h>
+
+#include <algorithm>
+#include <cstdio>
+
+Mycila::ISRStats Mycila::ISRProfiler::thyristor;
+Mycila::ISRStats Mycila::ISRProfiler::zeroCross;
+
+bool Mycila::CPUProfiler::isSupported() {
+#if configGENERATE_RUN_TIME_STATS == 1
+  return true;
+#else
+  return false;
+#endif
+}
+
+void Mycila::CPUProfiler::sample() {
+  const uint32_t now = millis();
+  const uint32_t elapsed = now - _lastSample;
+  const bool first = _lastSample == 0;
+  _lastSample = now;
+
+#if configGENERATE_RUN_TIME_STATS == 1
+  TaskStatus_t* status = new TaskStatus_t[MYCILA_CPU_PROFILER_MAX_TASKS];
+  configRUN_TIME_COUNTER_TYPE total;
+  const UBaseType_t count = uxTaskGetSystemState(status, MYCILA_CPU_PROFILER_MAX_TASKS, &total);
+
+  std::vector<Snapshot> snapshots;
+  snapshots.reserve(count);
+
+  std::vector<TaskLoad> tasks;
+  tasks.reserve(count);
+
+  // run time counters are in us
+  const uint64_t period = static_cast<uint64_t>(elapsed) * 1000;
+
+  for (UBaseType_t i = 0; i < count; i++) {
+    snapshots.push_back({status[i].xHandle, status[i].ulRunTimeCounter});
+
+    if (first || !period)
+      continue;
+
+    auto previous = std::find_if(_snapshots.begin(), _snapshots.end(), [&](const Snapshot& s) { return s.handle == status[i].xHandle; });
+    // task created during the period: its whole run time belongs to the period
+    // computed with the counter type so that a wrapping counter still gives the right difference
+    const configRUN_TIME_COUNTER_TYPE runTime = status[i].ulRunTimeCounter - (previous == _snapshots.end() ? 0 : previous->runTime);
+
+    TaskLoad load;
+    load.name = status[i].pcTaskName;
+  #if configTASKLIST_INCLUDE_COREID == 1
+    load.core = status[i].xCoreID == tskNO_AFFINITY ? -1 : static_cast<int8_t>(status[i].xCoreID);
+  #endif
+    load.load = std::min(100.0f, static_cast<float>(runTime) * 100.0f / period);
+
+    for (size_t core = 0; core < CORES; core++)
+      if (status[i].xHandle == xTaskGetIdleTaskHandleForCore(core))
+        _idle[core] = load.load;
+
+    tasks.push_back(std::move(load));
+  }
+
+  delete[] status;
+
+  std::sort(tasks.begin(), tasks.end(), [](const TaskLoad& a, const TaskLoad& b) { return a.load > b.load; });
+
+  _snapshots = std::move(snapshots);
+  if (!first)
+    _tasks = std::move(tasks);
+#endif
+
+  if (first)
+    return;
+
+  _period = elapsed;
+
+  _isrs.clear();
+  const uint64_t elapsedCycles = static_cast<uint64_t>(elapsed) * 1000 * getCpuFrequencyMhz();
+  _sampleISR("thyristor", ISRProfiler::thyristor, _lastThyristor, elapsedCycles);
+  _sampleISR("zero_cross", ISRProfiler::zeroCross, _lastZeroCross, elapsedCycles);
+}
+
+void Mycila::CPUProfiler::_sampleISR(const char* name, const ISRStats& stats, ISRSnapshot& last, uint64_t elapsedCycles) {
+#ifdef MYCILA_ISR_PROFILING
+  const uint32_t count = stats.count;
+  const uint32_t cycles = stats.cycles;
+  ISRLoad load;
+  load.name = name;
+  load.count = count - last.count;
+  load.load = elapsedCycles ? static_cast<float>(cycles - last.cycles) * 100.0f / elapsedCycles : 0;
+  load.maxTime = stats.maxCycles / getCpuFrequencyMhz();
+  last.count = count;
+  last.cycles = cycles;
+  if (load.count)
+    _isrs.push_back(load);
+#endif
+}
+
+std::string Mycila::CPUProfiler::toString() const {
+  std::string out;
+  char buffer[48];
+
+  for (size_t core = 0; core < CORES; core++) {
+    snprintf(buffer, sizeof(buffer), "%sc%d %.1f%%", core ? " " : "", core, getCoreLoad(core));
+    out += buffer;
+  }
+
+  out += " |";
+  for (const TaskLoad& task : _tasks) {
+    // idle tasks are already reported as the core load
+    if (task.load < 0.1f || task.name.rfind("IDLE", 0) == 0)
+      continue;
+    snprintf(buffer, sizeof(buffer), " %s %.1f%%", task.name.c_str(), task.load);
+    out += buffer;
+  }
+
+  if (!_isrs.empty()) {
+    out += " | isr";
+    for (const ISRLoad& isr : _isrs) {
+      snprintf(buffer, sizeof(buffer), " %s %.2f%%", isr.name, isr.load);
+      out += buffer;
+    }
+  }
+
+  return out;
+}
+
+#ifdef MYCILA_JSON_SUPPORT
+void Mycila::CPUProfiler::toJson(const JsonObject& root) const {
+  root["supported"] = isSupported();
+  root["period"] = _period;
+
+  JsonArray cores = root["cores"].to<JsonArray>();
+  for (size_t core = 0; core < CORES; core++) {
+    JsonObject c = cores.add<JsonObject>();
+    c["load"] = getCoreLoad(core);
+    c["idle"] = getIdle(core);
+  }
+
+  JsonObject tasks = root["tasks"].to<JsonObject>();
+  for (const TaskLoad& task : _tasks) {
+    JsonObject t = tasks[task.name].to<JsonObject>();
+    t["core"] = task.core;
+    t["load"] = task.load;
+  }
+
+  JsonObject isrs = root["isr"].to<JsonObject>();
+  for (const ISRLoad& isr : _isrs) {
+    JsonObject i = isrs[isr.name].to<JsonObject>();
+    i["count"] = isr.count;
+    i["load"] = isr.load;
+    i["max_time"] = isr.maxTime;
+  }
+}
+#endif
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#pragma once
+
+#include <MycilaISRStats.h>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <string>
+#include <vector>
+
+#ifdef MYCILA_JSON_SUPPORT
+  #include <ArduinoJson.h>
+#endif
+
+#ifndef MYCILA_CPU_PROFILER_MAX_TASKS
+  #define MYCILA_CPU_PROFILER_MAX_TASKS 40
+#endif
+
+namespace Mycila {
+  /**
+   * @brief Sampling CPU profiler based on the FreeRTOS run time counters.
+   *
+   * Each call to sample() takes a snapshot of the run time of all the tasks and computes the load of each task and core
+   * since the previous call. Nothing is done between two samples, so the profiler costs nothing when it is not sampled.
+   *
+   * Time spent in the profiled interrupt handlers (see MycilaISRStats.h) is reported when MYCILA_ISR_PROFILING is defined.
+   * Requires CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS: isSupported() returns false otherwise.
+   */
+  class CPUProfiler {
+    public:
+      struct TaskLoad {
+          std::string name;
+          // -1 if the task is not pinned to a core
+          int8_t core = -1;
+          // percentage of one core
+          float load = 0;
+      };
+
+      struct ISRLoad {
+          const char* name;
+          uint32_t count = 0;
+          // percentage of one core
+          float load = 0;
+          uint32_t maxTime = 0;
+      };
+
+      static constexpr size_t CORES = portNUM_PROCESSORS;
+
+      static bool isSupported();
+
+      // take a new snapshot and compute the loads since the previous one
+      void sample();
+
+      // duration of the last sampling period in ms (0 until 2 samples have been taken)
+      uint32_t getPeriod() const { return _period; }
+      float getCoreLoad(size_t core) const { return core < CORES ? 100 - _idle[core] : 0; }
+      float getIdle(size_t core) const { return core < CORES ? _idle[core] : 0; }
+      const std::vector<TaskLoad>& getTasks() const { return _tasks; }
+      const std::vector<ISRLoad>& getISRs() const { return _isrs; }
+
+      // compact one-line summary: "c0 12.5% c1 30.1% | y-core 3.2% async_tcp 1.0% ... | isr thyristor 0.40%"
+      std::string toString() const;
+
+#ifdef MYCILA_JSON_SUPPORT
+      void toJson(const JsonObject& root) const;
+#endif
+
+    private:
+      struct Snapshot {
+          TaskHandle_t handle;
+          configRUN_TIME_COUNTER_TYPE runTime;
+      };
+
+      struct ISRSnapshot {
+          uint32_t count = 0;
+          uint32_t cycles = 0;
+      };
+
+      uint32_t _lastSample = 0;
+      uint32_t _period = 0;
+      std::vector<Snapshot> _snapshots;
+      std::vector<TaskLoad> _tasks;
+      float _idle[CORES] = {};
+      std::vector<ISRLoad> _isrs;
+      ISRSnapshot _lastThyristor;
+      ISRSnapshot _lastZeroCross;
+
+      void _sampleISR(const char* name, const ISRStats& stats, ISRSnapshot& last, uint64_t elapsedCycles);
+  };
+} // namespace Mycila
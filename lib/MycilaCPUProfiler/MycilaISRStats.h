@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#pragma once
+
+#include <stdint.h>
+
+#ifdef MYCILA_ISR_PROFILING
+  #include <esp_attr.h>
+  #include <esp_cpu.h>
+#endif
+
+namespace Mycila {
+  /**
+   * @brief Time spent in an interrupt handler, in CPU cycles.
+   *
+   * Counters are 32 bits and wrap: readers must compute differences between two samples.
+   * Each instance must only be updated by one interrupt handler.
+   */
+  struct ISRStats {
+      volatile uint32_t count = 0;
+      volatile uint32_t cycles = 0;
+      volatile uint32_t maxCycles = 0;
+  };
+
+  namespace ISRProfiler {
+    // timer interrupt firing the thyristors
+    extern ISRStats thyristor;
+    // zero-cross pulse handler
+    extern ISRStats zeroCross;
+  } // namespace ISRProfiler
+
+#ifdef MYCILA_ISR_PROFILING
+  class ISRScope {
+    public:
+      explicit FORCE_INLINE_ATTR ISRScope(ISRStats& stats) : _stats(stats), _start(esp_cpu_get_cycle_count()) {}
+      FORCE_INLINE_ATTR ~ISRScope() {
+        const uint32_t cycles = esp_cpu_get_cycle_count() - _start;
+        _stats.count = _stats.count + 1;
+        _stats.cycles = _stats.cycles + cycles;
+        if (cycles > _stats.maxCycles)
+          _stats.maxCycles = cycles;
+      }
+
+    private:
+      ISRStats& _stats;
+      const uint32_t _start;
+  };
+#endif
+} // namespace Mycila
+
+// Accounts the time spent in the enclosing scope of an interrupt handler.
+// Compiled out unless MYCILA_ISR_PROFILING is defined.
+#ifdef MYCILA_ISR_PROFILING
+  #define MYCILA_ISR_PROFILE(stats) Mycila::ISRScope _mycilaISRScope(stats)
+#else
+  #define MYCILA_ISR_PROFILE(stats)
+#endif
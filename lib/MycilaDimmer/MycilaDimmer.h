@@ -117,6 +117,19 @@ namespace Mycila {
         setDutyCycle(_dutyCycle);
       }
 
+      /**
+       * @brief Set both ends of the duty remapping at once, so that the new range is applied in one step
+       * instead of being constrained by the previous min or max.
+       *
+       * @param min: the new "0" value for the power duty cycle in the range [0.0, 1.0]
+       * @param max: the new "1" value for the power duty cycle in the range [min, 1.0]
+       */
+      void setDutyCycleRange(float min, float max) {
+        _dutyCycleMin = constrain(min, 0, 1);
+        _dutyCycleMax = constrain(max, _dutyCycleMin, 1);
+        setDutyCycle(_dutyCycle);
+      }
+
       /**
        * @brief Get the power duty cycle configured for the dimmer by teh user
        */
@@ -7,19 +7,7 @@
 // logging
 #include <esp32-hal-log.h>
 
-#ifdef MYCILA_LOGGER_SUPPORT
-  #include <MycilaLogger.h>
-extern Mycila::Logger logger;
-  #define LOGD(tag, format, ...) logger.debug(tag, format, ##__VA_ARGS__)
-  #define LOGI(tag, format, ...) logger.info(tag, format, ##__VA_ARGS__)
-  #define LOGW(tag, format, ...) logger.warn(tag, format, ##__VA_ARGS__)
-  #define LOGE(tag, format, ...) logger.error(tag, format, ##__VA_ARGS__)
-#else
-  #define LOGD(tag, format, ...) ESP_LOGD(tag, format, ##__VA_ARGS__)
-  #define LOGI(tag, format, ...) ESP_LOGI(tag, format, ##__VA_ARGS__)
-  #define LOGW(tag, format, ...) ESP_LOGW(tag, format, ##__VA_ARGS__)
-  #define LOGE(tag, format, ...) ESP_LOGE(tag, format, ##__VA_ARGS__)
-#endif
+#include <MycilaLogFilter.h>
 
 #define TAG "DFR_DIMMER"
 
@@ -29,31 +17,31 @@ void Mycila::DFRobotDimmer::begin() {
 
   uint8_t resolution = getResolution();
   if (!resolution) {
-    LOGE(TAG, "Disable DFRobot Dimmer: SKU not set!");
+    MYCILA_LOGE(TAG, "Disable DFRobot Dimmer: SKU not set!");
     return;
   }
 
   // sanity checks
   if (_sku == SKU::DFR1071_GP8211S) {
     if (_channel > 0) {
-      LOGW(TAG, "DFRobot DFR1071 (GP8211S) has only one channel: switching to channel 0");
+      MYCILA_LOGW(TAG, "DFRobot DFR1071 (GP8211S) has only one channel: switching to channel 0");
       _channel = 0;
     }
   }
 
   if (_channel > 2) {
-    LOGE(TAG, "Disable DFRobot Dimmer: invalid channel %d", _channel);
+    MYCILA_LOGE(TAG, "Disable DFRobot Dimmer: invalid channel %d", _channel);
     return;
   }
 
   // discovery
   bool found = false;
   if (_deviceAddress) {
-    LOGI(TAG, "Searching for DFRobot Dimmer @ 0x%02x...", _deviceAddress);
+    MYCILA_LOGI(TAG, "Searching for DFRobot Dimmer @ 0x%02x...", _deviceAddress);
     for (int i = 0; i < 3; i++) {
       uint8_t err = _test(_deviceAddress);
       if (err) {
-        LOGW(TAG, "DFRobot Dimmer @ 0x%02x: TwoWire communication error: %d", _deviceAddress, err);
+        MYCILA_LOGW(TAG, "DFRobot Dimmer @ 0x%02x: TwoWire communication error: %d", _deviceAddress, err);
         delay(10);
       } else {
         found = true;
@@ -62,12 +50,12 @@ void Mycila::DFRobotDimmer::begin() {
     }
 
   } else {
-    LOGI(TAG, "Searching for DFRobot Dimmer @ 0x58-0x5F (discovery)...");
+    MYCILA_LOGI(TAG, "Searching for DFRobot Dimmer @ 0x58-0x5F (discovery)...");
     for (uint8_t addr = 0x58; !found && addr <= 0x5F; addr++) {
       for (int i = 0; i < 3; i++) {
         uint8_t err = _test(addr);
         if (err) {
-          LOGW(TAG, "DFRobot Dimmer @ 0x%02x: TwoWire communication error: %d", addr, err);
+          MYCILA_LOGW(TAG, "DFRobot Dimmer @ 0x%02x: TwoWire communication error: %d", addr, err);
           delay(10);
         } else {
           _deviceAddress = addr;
@@ -79,18 +67,18 @@ void Mycila::DFRobotDimmer::begin() {
   }
 
   if (found) {
-    LOGI(TAG, "Enable DFRobot Dimmer @ 0x%02x and channel %d", _deviceAddress, _channel);
+    MYCILA_LOGI(TAG, "Enable DFRobot Dimmer @ 0x%02x and channel %d", _deviceAddress, _channel);
   } else if (_deviceAddress) {
-    LOGW(TAG, "DFRobot Dimmer @ 0x%02x: Unable to communicate with device", _deviceAddress);
+    MYCILA_LOGW(TAG, "DFRobot Dimmer @ 0x%02x: Unable to communicate with device", _deviceAddress);
   } else {
     _deviceAddress = 0x58;
-    LOGW(TAG, "DFRobot Dimmer: Discovery failed! Using default address 0x58");
+    MYCILA_LOGW(TAG, "DFRobot Dimmer: Discovery failed! Using default address 0x58");
   }
 
   // set output
   uint8_t err = _sendOutput(_deviceAddress, _output);
   if (err) {
-    LOGE(TAG, "Disable DFRobot Dimmer: Unable to set output voltage: TwoWire communication error: %d", err);
+    MYCILA_LOGE(TAG, "Disable DFRobot Dimmer: Unable to set output voltage: TwoWire communication error: %d", err);
     return;
   }
 
@@ -104,7 +92,7 @@ void Mycila::DFRobotDimmer::end() {
   if (!_enabled)
     return;
   _enabled = false;
-  LOGI(TAG, "Disable DFRobot Dimmer");
+  MYCILA_LOGI(TAG, "Disable DFRobot Dimmer");
   // Note: do not set _dutyCycle to 0 in order to keep last set user value
   _delay = UINT16_MAX;
 }
@@ -138,12 +126,12 @@ uint8_t Mycila::DFRobotDimmer::_sendDutyCycle(uint8_t address, uint16_t duty) {
 uint8_t Mycila::DFRobotDimmer::_sendOutput(uint8_t address, Output output) {
   switch (output) {
     case Output::RANGE_0_5V: {
-      LOGI(TAG, "Set output range to 0-5V");
+      MYCILA_LOGI(TAG, "Set output range to 0-5V");
       uint8_t data = 0x00;
       return _send(address, 0x01, &data, 1);
     }
     case Output::RANGE_0_10V: {
-      LOGI(TAG, "Set output range to 0-10V");
+      MYCILA_LOGI(TAG, "Set output range to 0-10V");
       uint8_t data = 0x11;
       return _send(address, 0x01, &data, 1);
     }
@@ -14,24 +14,16 @@
 #include <soc/gpio_struct.h>
 
 // timers
+#include <esp_timer.h>
 #include <inlined_gptimer.h>
 
+// profiling
+#include <MycilaISRStats.h>
+
 // logging
 #include <esp32-hal-log.h>
 
-#ifdef MYCILA_LOGGER_SUPPORT
-  #include <MycilaLogger.h>
-extern Mycila::Logger logger;
-  #define LOGD(tag, format, ...) logger.debug(tag, format, ##__VA_ARGS__)
-  #define LOGI(tag, format, ...) logger.info(tag, format, ##__VA_ARGS__)
-  #define LOGW(tag, format, ...) logger.warn(tag, format, ##__VA_ARGS__)
-  #define LOGE(tag, format, ...) logger.error(tag, format, ##__VA_ARGS__)
-#else
-  #define LOGD(tag, format, ...) ESP_LOGD(tag, format, ##__VA_ARGS__)
-  #define LOGI(tag, format, ...) ESP_LOGI(tag, format, ##__VA_ARGS__)
-  #define LOGW(tag, format, ...) ESP_LOGW(tag, format, ##__VA_ARGS__)
-  #define LOGE(tag, format, ...) ESP_LOGE(tag, format, ##__VA_ARGS__)
-#endif
+#include <MycilaLogFilter.h>
 
 #ifndef GPIO_IS_VALID_OUTPUT_GPIO
   #define GPIO_IS_VALID_OUTPUT_GPIO(gpio_num) ((gpio_num >= 0) && \
@@ -50,16 +42,18 @@ extern Mycila::Logger logger;
 
 #define TAG "ZC_DIMMER"
 
+volatile uint32_t Mycila::ZeroCrossDimmer::_lastZeroCrossTime = 0;
+
 void Mycila::ZeroCrossDimmer::begin() {
   if (_enabled)
     return;
 
   if (!GPIO_IS_VALID_OUTPUT_GPIO(_pin)) {
-    LOGE(TAG, "Disable ZC Dimmer: Invalid pin: %" PRId8, _pin);
+    MYCILA_LOGE(TAG, "Disable ZC Dimmer: Invalid pin: %" PRId8, _pin);
     return;
   }
 
-  LOGI(TAG, "Enable Zero-Cross Dimmer on pin %" PRId8, _pin);
+  MYCILA_LOGI(TAG, "Enable Zero-Cross Dimmer on pin %" PRId8, _pin);
 
   pinMode(_pin, OUTPUT);
   digitalWrite(_pin, LOW);
@@ -74,7 +68,7 @@ void Mycila::ZeroCrossDimmer::end() {
   if (!_enabled)
     return;
   _enabled = false;
-  LOGI(TAG, "Disable ZC Dimmer on pin %" PRId8, _pin);
+  MYCILA_LOGI(TAG, "Disable ZC Dimmer on pin %" PRId8, _pin);
   // Note: do not set _dutyCycle to 0 in order to keep last set user value
   _delay = UINT16_MAX;
   _dimmer->setDelay(_delay);
@@ -84,6 +78,9 @@ void Mycila::ZeroCrossDimmer::end() {
 }
 
 void ARDUINO_ISR_ATTR Mycila::ZeroCrossDimmer::onZeroCross(int16_t delayUntilZero, void* arg) {
+  MYCILA_ISR_PROFILE(Mycila::ISRProfiler::zeroCross);
+  // 32 bits so that readers from other tasks cannot see a torn value
+  _lastZeroCrossTime = static_cast<uint32_t>(esp_timer_get_time());
   Thyristor::zero_cross_int(arg);
 }
 
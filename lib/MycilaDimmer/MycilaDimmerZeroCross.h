@@ -51,11 +51,19 @@ namespace Mycila {
        */
       static void onZeroCross(int16_t delayUntilZero, void* args);
 
+      /**
+       * @brief Time of the last zero-crossing event, in microseconds (low 32 bits of esp_timer_get_time(), wraps every 71 minutes)
+       *
+       * @return 0 if no zero-crossing event was received yet
+       */
+      static uint32_t getLastZeroCrossTime() { return _lastZeroCrossTime; }
+
     protected:
       virtual bool apply();
 
     private:
       gpio_num_t _pin = GPIO_NUM_NC;
       Thyristor* _dimmer = nullptr;
+      static volatile uint32_t _lastZeroCrossTime;
   };
 } // namespace Mycila
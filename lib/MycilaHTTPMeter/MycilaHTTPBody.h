@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// This file does not depend on Arduino: the body reader can be compiled and checked on host.
+
+namespace Mycila {
+  namespace HTTP {
+    /**
+     * @brief Reads the body of an HTTP/1.1 response from the stream of a kept-alive connection.
+     *
+     * The body is delimited by its Content-Length, by its chunks (Transfer-Encoding: chunked) or by the end of the connection.
+     * It can be passed to deserializeJson() as a custom reader: the chunk headers are removed and nothing is read past the body.
+     *
+     * Source must provide size_t readBytes(char* buffer, size_t length), returning less than length on timeout or end of the connection (like Arduino Stream).
+     */
+    template <typename Source>
+    class BodyReader {
+      public:
+        // length: value of Content-Length or -1 if not set
+        BodyReader(Source& source, int32_t length, bool chunked) : _source(source), _chunked(chunked) {
+          if (!chunked)
+            _remaining = length;
+        }
+
+        // next byte of the body, or -1 at the end of the body or on error
+        int read() {
+          char c;
+          return readBytes(&c, 1) ? static_cast<uint8_t>(c) : -1;
+        }
+
+        size_t readBytes(char* buffer, size_t length) {
+          size_t count = 0;
+          while (count < length && _fill()) {
+            size_t n = length - count;
+            if (_remaining >= 0 && static_cast<size_t>(_remaining) < n)
+              n = _remaining;
+            n = _source.readBytes(buffer + count, n);
+            if (!n) {
+              _error = _remaining >= 0;
+              _remaining = 0;
+              _ended = true;
+              break;
+            }
+            count += n;
+            if (_remaining >= 0)
+              _remaining -= n;
+          }
+          return count;
+        }
+
+        /**
+         * @brief Read and discard the rest of the body, so that the next response can be read on the same connection
+         *
+         * @return false if the body was malformed or truncated: the connection must then be closed
+         */
+        bool skip() {
+          char buffer[64];
+          while (readBytes(buffer, sizeof(buffer)))
+            ;
+          return !_error;
+        }
+
+        bool hasError() const { return _error; }
+
+      private:
+        Source& _source;
+        bool _chunked;
+        // bytes left in the body or in the current chunk, or -1 if unknown (body delimited by the end of the connection)
+        int32_t _remaining = 0;
+        bool _started = false;
+        bool _ended = false;
+        bool _error = false;
+
+        // returns true if some data of the body can be read
+        bool _fill() {
+          if (_ended)
+            return false;
+          if (_remaining)
+            return true;
+          if (!_chunked) {
+            _ended = true;
+            return false;
+          }
+          // end of the previous chunk data
+          if (_started && !_expectLine()) {
+            _fail();
+            return false;
+          }
+          _started = true;
+          int32_t size;
+          if (!_readChunkSize(size)) {
+            _fail();
+            return false;
+          }
+          if (!size) {
+            // last chunk: skip the trailer fields until the empty line
+            char line[64];
+            size_t len;
+            do {
+              if (!_readLine(line, sizeof(line), len)) {
+                _fail();
+                return false;
+              }
+            } while (len);
+            _ended = true;
+            return false;
+          }
+          _remaining = size;
+          return true;
+        }
+
+        // chunk size line: hex digits, optionally followed by extensions (";name=value")
+        bool _readChunkSize(int32_t& size) {
+          char line[64];
+          size_t len;
+          if (!_readLine(line, sizeof(line), len) || !len)
+            return false;
+          size = 0;
+          size_t i = 0;
+          for (; i < len; i++) {
+            const char c = line[i];
+            int digit;
+            if (c >= '0' && c <= '9')
+              digit = c - '0';
+            else if (c >= 'a' && c <= 'f')
+              digit = c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F')
+              digit = c - 'A' + 10;
+            else
+              break;
+            if (size > (INT32_MAX >> 4))
+              return false;
+            size = (size << 4) | digit;
+          }
+          return i && (i == len || line[i] == ';' || line[i] == ' ' || line[i] == '\t');
+        }
+
+        // empty line ending the data of a chunk
+        bool _expectLine() {
+          char line[2];
+          size_t len;
+          return _readLine(line, sizeof(line), len) && !len;
+        }
+
+        // reads a line ending with CRLF: characters that do not fit in the buffer are dropped
+        bool _readLine(char* line, size_t size, size_t& len) {
+          len = 0;
+          char c;
+          bool cr = false;
+          while (_source.readBytes(&c, 1)) {
+            if (cr && c == '\n') {
+              return true;
+            }
+            if (cr && len < size)
+              line[len++] = '\r';
+            cr = c == '\r';
+            if (!cr && len < size)
+              line[len++] = c;
+          }
+          return false;
+        }
+
+        void _fail() {
+          _error = true;
+          _ended = true;
+          _remaining = 0;
+        }
+    };
+  } // namespace HTTP
+} // namespace Mycila
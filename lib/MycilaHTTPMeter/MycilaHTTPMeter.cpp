@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#include <MycilaHTTPMeter.h>
+
+#include <WiFi.h>
+
+#include <string>
+
+#include <MycilaLogFilter.h>
+
+#define TAG "HTTP_METER"
+
+// local devices answer within a few tens of ms: do not block the polling task longer
+#define HTTP_TIMEOUT_MS 1000
+
+bool Mycila::HTTPMeter::begin(const char* host, uint16_t port, const HTTP::Map& map) {
+  if (_map) {
+    return true;
+  }
+
+  // resolve once: polls reuse the IP address
+  if (!WiFi.hostByName(host, _ip)) {
+    MYCILA_LOGE(TAG, "Unable to resolve %s", host);
+    return false;
+  }
+
+  MYCILA_LOGI(TAG, "Polling %s at http://%s:%" PRIu16 "%s", map.name, _ip.toString().c_str(), port, map.uri);
+
+  _map = &map;
+  _port = port;
+  HTTP::filter(map, _filter);
+
+  _http.setReuse(true);
+  _http.setTimeout(HTTP_TIMEOUT_MS);
+  _http.setConnectTimeout(HTTP_TIMEOUT_MS);
+  _http.useHTTP10(false);
+  // the body of a kept-alive connection can be chunked
+  static const char* headers[] = {"Transfer-Encoding"};
+  _http.collectHeaders(headers, 1);
+
+  return true;
+}
+
+void Mycila::HTTPMeter::end() {
+  if (_map) {
+    MYCILA_LOGI(TAG, "Stop polling %s", _map->name);
+    _http.setReuse(false);
+    _http.end();
+    _client.stop();
+    _map = nullptr;
+    _filter.clear();
+    _lastError = "";
+    _metrics = HTTP::Metrics();
+  }
+}
+
+bool Mycila::HTTPMeter::read() {
+  if (!_map)
+    return false;
+
+  const uint32_t start = millis();
+
+  // the connection is kept open by the previous request if the device allowed it
+  if (!_client.connected())
+    _connections++;
+
+  if (!_http.begin(_client, _ip.toString(), _port, _map->uri)) {
+    _setError("Invalid URL");
+    return false;
+  }
+
+  const int code = _http.GET();
+  if (code < 0) {
+    _setError(HTTPClient::errorToString(code).c_str());
+    _http.end();
+    return false;
+  }
+
+  // the rest of the body is always read so that the next response starts at the beginning of the stream,
+  // and a truncated body closes the connection
+  HTTP::BodyReader<Stream> body(_http.getStream(), _http.getSize(), _http.header("Transfer-Encoding").equalsIgnoreCase("chunked"));
+
+  if (code != HTTP_CODE_OK) {
+    _setError(("HTTP " + std::to_string(code)).c_str());
+    if (!body.skip())
+      _client.stop();
+    _http.end();
+    return false;
+  }
+
+  // the response is parsed while it is received: only the filtered fields are allocated in the arena
+  JsonDocument doc(&_arena);
+  const DeserializationError error = deserializeJson(doc, body, DeserializationOption::Filter(_filter));
+  if (!body.skip())
+    _client.stop();
+  // keeps the connection open if the device supports keep-alive
+  _http.end();
+
+  if (error) {
+    _setError(error.c_str());
+    return false;
+  }
+
+  HTTP::Metrics metrics;
+  if (!HTTP::extract(*_map, doc.as<JsonVariantConst>(), metrics)) {
+    _setError("Power not found in response");
+    return false;
+  }
+
+  _rtt = millis() - start;
+  _reads++;
+  _metrics = metrics;
+  _lastError = "";
+
+  if (_callback) {
+    _callback(EventType::EVT_READ);
+  }
+
+  return true;
+}
+
+void Mycila::HTTPMeter::_setError(const char* error) {
+  _errors++;
+  _lastError = error;
+  MYCILA_LOGD(TAG, "%s: %s", _map->name, error);
+
+  if (_callback) {
+    _callback(EventType::EVT_ERROR);
+  }
+}
@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#pragma once
+
+#include <MycilaArena.h>
+#include <MycilaHTTPBody.h>
+#include <MycilaHTTPMeterMap.h>
+
+#include <HTTPClient.h>
+#include <WiFiClient.h>
+
+#include <string>
+
+#ifndef MYCILA_HTTP_METER_ARENA_SIZE
+  #define MYCILA_HTTP_METER_ARENA_SIZE 2048
+#endif
+
+namespace Mycila {
+  /**
+   * @brief Polls a meter exposing a JSON status endpoint on the local network, driven by a field map (see MycilaHTTPMeterMap.h).
+   *
+   * The TCP connection is kept alive between polls and the host is only resolved once.
+   */
+  class HTTPMeter {
+    public:
+      enum class EventType {
+        EVT_READ,
+        EVT_ERROR,
+      };
+
+      typedef std::function<void(EventType eventType)> Callback;
+
+      void setCallback(Callback callback) { _callback = callback; }
+
+      /**
+       * @brief Resolve the host and prepare the connection
+       *
+       * @return false if the host cannot be resolved
+       */
+      bool begin(const char* host, uint16_t port, const HTTP::Map& map);
+      void end();
+
+      bool isEnabled() const { return _map != nullptr; }
+
+      /**
+       * @brief Poll the meter (blocking, with a timeout)
+       *
+       * @return true if the metrics were updated
+       */
+      bool read();
+
+      const char* getModel() const { return _map ? _map->name : ""; }
+      const HTTP::Metrics& getMetrics() const { return _metrics; }
+      std::string getLastError() const { return _lastError; }
+      bool hasError() const { return !_lastError.empty(); }
+
+#ifdef MYCILA_JSON_SUPPORT
+      void toJson(const JsonObject& root) const {
+        root["model"] = getModel();
+        root["reads"] = _reads;
+        root["errors"] = _errors;
+        root["connections"] = _connections;
+        root["rtt"] = _rtt;
+        if (!isnan(_metrics.apparentPower))
+          root["apparent_power"] = _metrics.apparentPower;
+        if (!isnan(_metrics.current))
+          root["current"] = _metrics.current;
+        if (!isnan(_metrics.energy))
+          root["energy"] = _metrics.energy;
+        if (!isnan(_metrics.energyReturned))
+          root["energy_returned"] = _metrics.energyReturned;
+        if (!isnan(_metrics.frequency))
+          root["frequency"] = _metrics.frequency;
+        if (!isnan(_metrics.power))
+          root["power"] = _metrics.power;
+        if (!isnan(_metrics.powerFactor))
+          root["power_factor"] = _metrics.powerFactor;
+        if (!isnan(_metrics.voltage))
+          root["voltage"] = _metrics.voltage;
+        if (_lastError.length())
+          root["error"] = _lastError;
+        _arena.toJson(root["arena"].to<JsonObject>());
+      }
+#endif
+
+    private:
+      WiFiClient _client;
+      HTTPClient _http;
+      const HTTP::Map* _map = nullptr;
+      JsonDocument _filter;
+      // responses are parsed in this arena
+      StaticArena<MYCILA_HTTP_METER_ARENA_SIZE> _arena;
+      IPAddress _ip;
+      uint16_t _port = 80;
+      Callback _callback = nullptr;
+      HTTP::Metrics _metrics;
+      std::string _lastError;
+      uint32_t _reads = 0;
+      uint32_t _errors = 0;
+      // number of TCP connections opened: stays low when keep-alive works
+      uint32_t _connections = 0;
+      // duration in ms of the last successful poll
+      uint32_t _rtt = 0;
+
+      void _setError(const char* error);
+  };
+} // namespace Mycila
@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#include <MycilaHTTPMeterMap.h>
+
+#include <cstdlib>
+#include <cstring>
+
+// maximum length of a key in a field path
+#define MAX_KEY_LENGTH 32
+
+#define NONE {nullptr, 1.0f}
+
+// Shelly Pro EM (Gen2), channel 0: https://shelly-api-docs.shelly.cloud/gen2/ComponentsAndServices/EM1
+const Mycila::HTTP::Map Mycila::HTTP::SHELLY_PRO_EM = {
+  .name = "Shelly Pro EM",
+  .uri = "/rpc/EM1.GetStatus?id=0",
+  .apparentPower = {"aprt_power", 1.0f},
+  .current = {"current", 1.0f},
+  .energy = NONE,
+  .energyReturned = NONE,
+  .frequency = {"freq", 1.0f},
+  .power = {"act_power", 1.0f},
+  .powerFactor = {"pf", 1.0f},
+  .voltage = {"voltage", 1.0f},
+};
+
+// Shelly Pro 3EM (Gen2): https://shelly-api-docs.shelly.cloud/gen2/ComponentsAndServices/EM
+const Mycila::HTTP::Map Mycila::HTTP::SHELLY_PRO_3EM = {
+  .name = "Shelly Pro 3EM",
+  .uri = "/rpc/EM.GetStatus?id=0",
+  .apparentPower = {"total_aprt_power", 1.0f},
+  .current = {"total_current", 1.0f},
+  .energy = NONE,
+  .energyReturned = NONE,
+  .frequency = {"a_freq", 1.0f},
+  .power = {"total_act_power", 1.0f},
+  .powerFactor = {"a_pf", 1.0f},
+  .voltage = {"a_voltage", 1.0f},
+};
+
+// Tasmota energy sensor: https://tasmota.github.io/docs/Commands/#status
+const Mycila::HTTP::Map Mycila::HTTP::TASMOTA = {
+  .name = "Tasmota",
+  .uri = "/cm?cmnd=Status%2010",
+  .apparentPower = {"StatusSNS/ENERGY/ApparentPower", 1.0f},
+  .current = {"StatusSNS/ENERGY/Current", 1.0f},
+  .energy = {"StatusSNS/ENERGY/Total", 1000.0f},
+  .energyReturned = NONE,
+  .frequency = {"StatusSNS/ENERGY/Frequency", 1.0f},
+  .power = {"StatusSNS/ENERGY/Power", 1.0f},
+  .powerFactor = {"StatusSNS/ENERGY/Factor", 1.0f},
+  .voltage = {"StatusSNS/ENERGY/Voltage", 1.0f},
+};
+
+// Enphase Envoy with consumption CTs (local API without authentication): the second consumption entry is the net consumption
+const Mycila::HTTP::Map Mycila::HTTP::ENVOY = {
+  .name = "Enphase Envoy",
+  .uri = "/production.json",
+  .apparentPower = {"consumption/1/apprntPwr", 1.0f},
+  .current = {"consumption/1/rmsCurrent", 1.0f},
+  .energy = NONE,
+  .energyReturned = NONE,
+  .frequency = NONE,
+  .power = {"consumption/1/wNow", 1.0f},
+  .powerFactor = {"consumption/1/pwrFactor", 1.0f},
+  .voltage = {"consumption/1/rmsVoltage", 1.0f},
+};
+
+const Mycila::HTTP::Map* Mycila::HTTP::findMap(const char* name) {
+  if (name == nullptr)
+    return nullptr;
+  for (const Map* map : {&ENVOY, &SHELLY_PRO_3EM, &SHELLY_PRO_EM, &TASMOTA})
+    if (strcmp(map->name, name) == 0)
+      return map;
+  return nullptr;
+}
+
+// copy the next key of a path into key and returns the rest of the path, or nullptr at the end of the path
+static const char* _nextKey(const char* path, char* key) {
+  const char* end = strchr(path, '/');
+  size_t len = end ? end - path : strlen(path);
+  if (len >= MAX_KEY_LENGTH)
+    len = MAX_KEY_LENGTH - 1;
+  memcpy(key, path, len);
+  key[len] = '\0';
+  return end ? end + 1 : nullptr;
+}
+
+static bool _isIndex(const char* key) {
+  if (!*key)
+    return false;
+  for (const char* c = key; *c; c++)
+    if (*c < '0' || *c > '9')
+      return false;
+  return true;
+}
+
+static void _filter(const Mycila::HTTP::Field& field, JsonObject root) {
+  if (field.path == nullptr)
+    return;
+
+  char key[MAX_KEY_LENGTH];
+  JsonObject node = root;
+  const char* path = _nextKey(field.path, key);
+
+  while (path) {
+    char next[MAX_KEY_LENGTH];
+    const char* rest = _nextKey(path, next);
+
+    if (_isIndex(next)) {
+      // ArduinoJson applies the first element of a filter array to all elements
+      JsonArray array = node[key].is<JsonArray>() ? node[key].as<JsonArray>() : node[key].to<JsonArray>();
+      node = array.size() ? array[0].as<JsonObject>() : array.add<JsonObject>();
+      if (!rest)
+        return;
+      path = _nextKey(rest, key);
+    } else {
+      node = node[key].is<JsonObject>() ? node[key].as<JsonObject>() : node[key].to<JsonObject>();
+      memcpy(key, next, MAX_KEY_LENGTH);
+      path = rest;
+    }
+  }
+
+  node[key] = true;
+}
+
+void Mycila::HTTP::filter(const Map& map, JsonDocument& filter) {
+  filter.clear();
+  JsonObject root = filter.to<JsonObject>();
+  _filter(map.apparentPower, root);
+  _filter(map.current, root);
+  _filter(map.energy, root);
+  _filter(map.energyReturned, root);
+  _filter(map.frequency, root);
+  _filter(map.power, root);
+  _filter(map.powerFactor, root);
+  _filter(map.voltage, root);
+}
+
+float Mycila::HTTP::extract(const Field& field, const JsonVariantConst& root) {
+  if (field.path == nullptr)
+    return NAN;
+
+  char key[MAX_KEY_LENGTH];
+  JsonVariantConst node = root;
+  const char* path = field.path;
+
+  while (path) {
+    path = _nextKey(path, key);
+    if (_isIndex(key) && node.is<JsonArrayConst>())
+      node = node[static_cast<size_t>(atoi(key))];
+    else
+      node = node[static_cast<const char*>(key)];
+  }
+
+  return node.is<float>() ? node.as<float>() * field.scale : NAN;
+}
+
+bool Mycila::HTTP::extract(const Map& map, const JsonVariantConst& root, Metrics& metrics) {
+  metrics.power = extract(map.power, root);
+  if (std::isnan(metrics.power))
+    return false;
+  metrics.apparentPower = extract(map.apparentPower, root);
+  metrics.current = extract(map.current, root);
+  metrics.energy = extract(map.energy, root);
+  metrics.energyReturned = extract(map.energyReturned, root);
+  metrics.frequency = extract(map.frequency, root);
+  metrics.powerFactor = extract(map.powerFactor, root);
+  metrics.voltage = extract(map.voltage, root);
+  return true;
+}
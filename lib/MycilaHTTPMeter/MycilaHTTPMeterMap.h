@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#pragma once
+
+#include <ArduinoJson.h>
+
+#include <cmath>
+
+// This file only depends on ArduinoJson: field maps and their extraction can be compiled and checked on host.
+
+namespace Mycila {
+  namespace HTTP {
+    /**
+     * @brief Location of a value in a JSON document
+     */
+    struct Field {
+        // keys separated by '/', numbers being array indexes (e.g. "consumption/1/wNow"), or nullptr if the device does not provide this value
+        const char* path;
+        // multiplier applied to the value (e.g. 1000 for kWh to Wh)
+        float scale;
+    };
+
+    /**
+     * @brief Describes the JSON endpoint of a meter.
+     *
+     * Power must be positive when importing from the grid and negative when exporting.
+     */
+    struct Map {
+        const char* name;
+        // path and query of the status endpoint
+        const char* uri;
+        Field apparentPower;
+        Field current;
+        Field energy;
+        Field energyReturned;
+        Field frequency;
+        Field power;
+        Field powerFactor;
+        Field voltage;
+    };
+
+    struct Metrics {
+        float apparentPower = NAN;
+        float current = NAN;
+        float energy = NAN;
+        float energyReturned = NAN;
+        float frequency = NAN;
+        float power = NAN;
+        float powerFactor = NAN;
+        float voltage = NAN;
+    };
+
+    extern const Map ENVOY;
+    extern const Map SHELLY_PRO_3EM;
+    extern const Map SHELLY_PRO_EM;
+    extern const Map TASMOTA;
+
+    /**
+     * @brief Find a built-in map by name (case sensitive): Enphase Envoy, Shelly Pro 3EM, Shelly Pro EM, Tasmota
+     *
+     * @return the map or nullptr if not found
+     */
+    const Map* findMap(const char* name);
+
+    /**
+     * @brief Build an ArduinoJson filter keeping only the fields of the map, to reduce the memory needed to parse a response
+     */
+    void filter(const Map& map, JsonDocument& filter);
+
+    /**
+     * @brief Get the scaled value of a field
+     *
+     * @return NAN if the field is not in the document or is not a number
+     */
+    float extract(const Field& field, const JsonVariantConst& root);
+
+    /**
+     * @brief Extract all the metrics of a map from a parsed response
+     *
+     * @return false if the power could not be found
+     */
+    bool extract(const Map& map, const JsonVariantConst& root, Metrics& metrics);
+  } // namespace HTTP
+} // namespace Mycila
@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#include <MycilaHeapMonitor.h>
+
+#include <esp32-hal.h>
+#include <esp_heap_caps.h>
+
+#include <algorithm>
+
+static constexpr uint32_t CAPS[Mycila::HeapMonitor::POOLS] = {MALLOC_CAP_INTERNAL, MALLOC_CAP_DMA, MALLOC_CAP_SPIRAM};
+
+void Mycila::HeapMonitor::sample() {
+  for (size_t i = 0; i < POOLS; i++) {
+    Stats& stats = _stats[i];
+    stats.total = heap_caps_get_total_size(CAPS[i]);
+    if (!stats.total)
+      continue;
+
+    multi_heap_info_t info;
+    heap_caps_get_info(&info, CAPS[i]);
+
+    stats.free = info.total_free_bytes;
+    stats.minFree = info.minimum_free_bytes;
+    stats.largestFreeBlock = info.largest_free_block;
+    stats.minLargestFreeBlock = std::min(stats.minLargestFreeBlock, stats.largestFreeBlock);
+    stats.freeBlocks = info.free_blocks;
+    stats.allocatedBlocks = info.allocated_blocks;
+    stats.fragmentation = info.total_free_bytes ? 100.0f - info.largest_free_block * 100.0f / info.total_free_bytes : 0;
+  }
+
+  const Stats& internal = get(Pool::INTERNAL);
+
+  const size_t index = _samples % MYCILA_HEAP_MONITOR_WINDOW;
+  _history[index] = internal.free;
+  _times[index] = millis() / 1000;
+  _samples++;
+
+  _computeTrend();
+
+  if (_criticalBlock && internal.largestFreeBlock < _criticalBlock) {
+    if (_criticalCount < UINT16_MAX)
+      _criticalCount++;
+  } else {
+    _criticalCount = 0;
+  }
+}
+
+void Mycila::HeapMonitor::_computeTrend() {
+  const size_t n = std::min<size_t>(_samples, MYCILA_HEAP_MONITOR_WINDOW);
+
+  // not enough history for a meaningful trend
+  if (n < MYCILA_HEAP_MONITOR_WINDOW / 2) {
+    _trend = 0;
+    return;
+  }
+
+  // least squares slope, relative to the first sample to keep the precision of floats
+  const size_t first = _samples > MYCILA_HEAP_MONITOR_WINDOW ? _samples % MYCILA_HEAP_MONITOR_WINDOW : 0;
+  const float t0 = _times[first];
+  const float y0 = _history[first];
+
+  float sumT = 0, sumY = 0, sumTT = 0, sumTY = 0;
+  for (size_t i = 0; i < n; i++) {
+    const float t = _times[i] - t0;
+    const float y = static_cast<float>(_history[i]) - y0;
+    sumT += t;
+    sumY += y;
+    sumTT += t * t;
+    sumTY += t * y;
+  }
+
+  const float denominator = n * sumTT - sumT * sumT;
+  _trend = denominator ? (n * sumTY - sumT * sumY) / denominator * 3600 : 0;
+}
+
+#ifdef MYCILA_JSON_SUPPORT
+void Mycila::HeapMonitor::toJson(const JsonObject& root) const {
+  root["samples"] = _samples;
+  root["trend"] = _trend;
+  root["critical"] = isCritical();
+  toJson(root["internal"].to<JsonObject>(), get(Pool::INTERNAL));
+  toJson(root["dma"].to<JsonObject>(), get(Pool::DMA));
+  if (get(Pool::PSRAM).total)
+    toJson(root["psram"].to<JsonObject>(), get(Pool::PSRAM));
+}
+
+void Mycila::HeapMonitor::toJson(const JsonObject& root, const Stats& stats) {
+  root["total"] = stats.total;
+  root["free"] = stats.free;
+  root["min_free"] = stats.minFree;
+  root["largest_free_block"] = stats.largestFreeBlock;
+  root["min_largest_free_block"] = stats.minLargestFreeBlock == SIZE_MAX ? 0 : stats.minLargestFreeBlock;
+  root["free_blocks"] = stats.freeBlocks;
+  root["allocated_blocks"] = stats.allocatedBlocks;
+  root["fragmentation"] = stats.fragmentation;
+}
+#endif
@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#ifdef MYCILA_JSON_SUPPORT
+  #include <ArduinoJson.h>
+#endif
+
+#ifndef MYCILA_HEAP_MONITOR_WINDOW
+  #define MYCILA_HEAP_MONITOR_WINDOW 60
+#endif
+
+namespace Mycila {
+  /**
+   * @brief Samples heap pools to track fragmentation and slow leaks.
+   *
+   * Free memory alone does not tell whether a TLS handshake or a large JSON response can still be allocated:
+   * the largest free block does. Each sample records, for each pool, the free memory, the largest free block and the block counts,
+   * plus the lowest largest free block ever seen.
+   *
+   * The trend of the internal free memory over the last MYCILA_HEAP_MONITOR_WINDOW samples is computed with a linear regression:
+   * a steady negative trend is a leak.
+   */
+  class HeapMonitor {
+    public:
+      enum class Pool : uint8_t {
+        INTERNAL,
+        DMA,
+        PSRAM,
+      };
+
+      static constexpr size_t POOLS = 3;
+
+      struct Stats {
+          size_t total = 0;
+          size_t free = 0;
+          // lowest free memory since boot
+          size_t minFree = 0;
+          size_t largestFreeBlock = 0;
+          // lowest largest free block since monitoring started
+          size_t minLargestFreeBlock = SIZE_MAX;
+          size_t freeBlocks = 0;
+          size_t allocatedBlocks = 0;
+          // percentage of free memory which is not in the largest free block
+          float fragmentation = 0;
+      };
+
+      /**
+       * @brief The heap is critical when the largest internal free block stays below minLargestFreeBlock for the given number of consecutive samples
+       */
+      void setCriticalThreshold(size_t minLargestFreeBlock, uint16_t samples) {
+        _criticalBlock = minLargestFreeBlock;
+        _criticalSamples = samples;
+      }
+
+      void sample();
+
+      const Stats& get(Pool pool) const { return _stats[static_cast<size_t>(pool)]; }
+
+      // number of samples taken
+      uint32_t getSamples() const { return _samples; }
+
+      // variation of the internal free memory in bytes per hour over the window (negative when memory is lost)
+      float getTrend() const { return _trend; }
+
+      bool isCritical() const { return _criticalSamples && _criticalCount >= _criticalSamples; }
+
+#ifdef MYCILA_JSON_SUPPORT
+      void toJson(const JsonObject& root) const;
+      static void toJson(const JsonObject& root, const Stats& stats);
+#endif
+
+    private:
+      std::array<Stats, POOLS> _stats;
+      uint32_t _samples = 0;
+      // internal free memory history with the time of each sample in seconds
+      std::array<uint32_t, MYCILA_HEAP_MONITOR_WINDOW> _history = {};
+      std::array<uint32_t, MYCILA_HEAP_MONITOR_WINDOW> _times = {};
+      float _trend = 0;
+      size_t _criticalBlock = 0;
+      uint16_t _criticalSamples = 0;
+      uint16_t _criticalCount = 0;
+
+      void _computeTrend();
+  };
+} // namespace Mycila
@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#include <MycilaLogFilter.h>
+
+#include <string.h>
+
+static const char* LevelNames[] = {
+  "none",
+  "error",
+  "warn",
+  "info",
+  "debug",
+  "verbose",
+};
+
+std::atomic<uint32_t> Mycila::LogRateLimit::_totalSuppressed{0};
+
+bool Mycila::LogFilter::setLevel(const char* tag, uint8_t level) {
+  const size_t count = _count.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < count; i++) {
+    if (strcmp(_entries[i].tag, tag) == 0) {
+      _entries[i].level = level;
+      return true;
+    }
+  }
+  if (count == MYCILA_LOG_FILTER_MAX_TAGS)
+    return false;
+  // the entry is complete before it becomes visible to the readers
+  Entry& entry = _entries[count];
+  strlcpy(entry.tag, tag, sizeof(entry.tag));
+  entry.level = level;
+  _count.store(count + 1, std::memory_order_release);
+  return true;
+}
+
+uint8_t Mycila::LogFilter::getLevel(const char* tag) const {
+  const size_t count = _count.load(std::memory_order_acquire);
+  for (size_t i = 0; i < count; i++)
+    if (strcmp(_entries[i].tag, tag) == 0)
+      return _entries[i].level;
+  return _defaultLevel;
+}
+
+uint8_t Mycila::LogFilter::getMaxLevel() const {
+  uint8_t level = _defaultLevel;
+  const size_t count = _count.load(std::memory_order_acquire);
+  for (size_t i = 0; i < count; i++)
+    if (_entries[i].level > level)
+      level = _entries[i].level;
+  return level;
+}
+
+const char* Mycila::LogFilter::levelName(uint8_t level) {
+  return level < sizeof(LevelNames) / sizeof(LevelNames[0]) ? LevelNames[level] : "unknown";
+}
+
+int8_t Mycila::LogFilter::parseLevel(const char* name) {
+  for (size_t i = 0; i < sizeof(LevelNames) / sizeof(LevelNames[0]); i++)
+    if (strcasecmp(LevelNames[i], name) == 0)
+      return i;
+  return -1;
+}
+
+#ifdef MYCILA_JSON_SUPPORT
+void Mycila::LogFilter::toJson(const JsonObject& root) const {
+  root["default"] = levelName(_defaultLevel);
+  JsonObject tags = root["tags"].to<JsonObject>();
+  const size_t count = _count.load(std::memory_order_acquire);
+  for (size_t i = 0; i < count; i++)
+    tags[_entries[i].tag] = levelName(_entries[i].level);
+  root["suppressed"] = LogRateLimit::getTotalSuppressed();
+}
+#endif
+
+bool Mycila::LogRateLimit::allow(uint32_t interval, uint32_t& suppressed) {
+  const uint32_t now = millis();
+  if (_logged && now - _last < interval) {
+    _suppressed.fetch_add(1, std::memory_order_relaxed);
+    _totalSuppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  _logged = true;
+  _last = now;
+  suppressed = _suppressed.exchange(0, std::memory_order_relaxed);
+  return true;
+}
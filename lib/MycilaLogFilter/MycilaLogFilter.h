@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include <atomic>
+#include <cstdint>
+
+#ifdef MYCILA_JSON_SUPPORT
+  #include <ArduinoJson.h>
+#endif
+
+#ifndef MYCILA_LOG_FILTER_MAX_TAGS
+  #define MYCILA_LOG_FILTER_MAX_TAGS 16
+#endif
+
+#ifndef MYCILA_LOG_RATE_LIMIT_INTERVAL
+  #define MYCILA_LOG_RATE_LIMIT_INTERVAL 10000 // ms
+#endif
+
+// logs at most one message per interval from this call site.
+// the next logged message reports how many were suppressed in between.
+// log must be a macro or function taking (tag, format, ...) and format must be a string literal.
+#define MYCILA_LOG_RATE_LIMITED(log, interval, tag, format, ...)                                         \
+  do {                                                                                                   \
+    static Mycila::LogRateLimit _limit;                                                                  \
+    uint32_t _suppressed = 0;                                                                            \
+    if (_limit.allow(interval, _suppressed)) {                                                           \
+      if (_suppressed)                                                                                   \
+        log(tag, format " (%" PRIu32 " similar messages suppressed)", ##__VA_ARGS__, _suppressed);       \
+      else                                                                                               \
+        log(tag, format, ##__VA_ARGS__);                                                                 \
+    }                                                                                                    \
+  } while (0)
+
+namespace Mycila {
+  /**
+   * @brief Log levels per tag, adjustable at runtime.
+   *
+   * Tags without a specific level use the default level.
+   * Levels are the ARDUHAL_LOG_LEVEL_* values: NONE (0), ERROR (1), WARN (2), INFO (3), DEBUG (4), VERBOSE (5).
+   */
+  class LogFilter {
+    public:
+      void setDefaultLevel(uint8_t level) { _defaultLevel = level; }
+      uint8_t getDefaultLevel() const { return _defaultLevel; }
+
+      // returns false if there is no room left for a new tag
+      bool setLevel(const char* tag, uint8_t level);
+      uint8_t getLevel(const char* tag) const;
+
+      // removes the specific levels: all the tags use the default level
+      void clear() { _count.store(0, std::memory_order_release); }
+
+      bool isEnabled(const char* tag, uint8_t level) const { return level <= getLevel(tag); }
+
+      // most verbose level across the tags: the logger must at least let this level through
+      uint8_t getMaxLevel() const;
+
+      static const char* levelName(uint8_t level);
+      // returns -1 if the name is unknown
+      static int8_t parseLevel(const char* name);
+
+#ifdef MYCILA_JSON_SUPPORT
+      void toJson(const JsonObject& root) const;
+#endif
+
+    private:
+      typedef struct {
+          char tag[16];
+          volatile uint8_t level;
+      } Entry;
+
+      // setLevel() and clear() are called by one task at a time, the readers can run on any task:
+      // an entry is written before the count that publishes it (release) and read after the count (acquire)
+      Entry _entries[MYCILA_LOG_FILTER_MAX_TAGS];
+      std::atomic<size_t> _count{0};
+      volatile uint8_t _defaultLevel = ARDUHAL_LOG_LEVEL_INFO;
+  };
+
+  /**
+   * @brief State of one rate limited log call site. See MYCILA_LOG_RATE_LIMITED.
+   */
+  class LogRateLimit {
+    public:
+      // returns true if the message can be logged, with the number of messages suppressed since the last one
+      bool allow(uint32_t interval, uint32_t& suppressed);
+
+      // number of messages suppressed by all the call sites since boot
+      static uint32_t getTotalSuppressed() { return _totalSuppressed.load(std::memory_order_relaxed); }
+
+    private:
+      uint32_t _last = 0;
+      bool _logged = false;
+      std::atomic<uint32_t> _suppressed{0};
+      static std::atomic<uint32_t> _totalSuppressed;
+  };
+} // namespace Mycila
+
+// Logging macros of the libraries.
+// With MYCILA_LOGGER_SUPPORT, messages go to the application logger and are filtered per tag by the application log filter:
+// the application defines Mycila::Logger logger and Mycila::LogFilter logFilter. Otherwise, messages go to the ESP-IDF log.
+#ifdef MYCILA_LOGGER_SUPPORT
+  #include <MycilaLogger.h>
+extern Mycila::Logger logger;
+extern Mycila::LogFilter logFilter;
+  #define MYCILA_LOGD(tag, format, ...) do { if (logFilter.isEnabled(tag, ARDUHAL_LOG_LEVEL_DEBUG)) logger.debug(tag, format, ##__VA_ARGS__); } while (0)
+  #define MYCILA_LOGI(tag, format, ...) do { if (logFilter.isEnabled(tag, ARDUHAL_LOG_LEVEL_INFO)) logger.info(tag, format, ##__VA_ARGS__); } while (0)
+  #define MYCILA_LOGW(tag, format, ...) do { if (logFilter.isEnabled(tag, ARDUHAL_LOG_LEVEL_WARN)) logger.warn(tag, format, ##__VA_ARGS__); } while (0)
+  #define MYCILA_LOGE(tag, format, ...) do { if (logFilter.isEnabled(tag, ARDUHAL_LOG_LEVEL_ERROR)) logger.error(tag, format, ##__VA_ARGS__); } while (0)
+#else
+  #define MYCILA_LOGD(tag, format, ...) ESP_LOGD(tag, format, ##__VA_ARGS__)
+  #define MYCILA_LOGI(tag, format, ...) ESP_LOGI(tag, format, ##__VA_ARGS__)
+  #define MYCILA_LOGW(tag, format, ...) ESP_LOGW(tag, format, ##__VA_ARGS__)
+  #define MYCILA_LOGE(tag, format, ...) ESP_LOGE(tag, format, ##__VA_ARGS__)
+#endif
@@ -0,0 +1,291 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#include <MycilaModbusMap.h>
+
+#include <algorithm>
+#include <cstring>
+
+// Maximum number of registers in one read request (Modbus limit)
+#define MODBUS_MAX_WORDS 125
+// Maximum number of unused registers read between 2 wanted registers to save a request
+#define MODBUS_MAX_GAP 32
+
+using Mycila::Modbus::Metric;
+using Mycila::Modbus::Register;
+using Mycila::Modbus::Type;
+using Mycila::Modbus::WordOrder;
+
+// ======================== AC Input based on CCGX-Modbus-TCP-register-list-3.40 ==========================
+// | Unit | Description           | Register | Type   | Scale | Unit    |
+// |------|-----------------------|----------|--------|-------|---------|
+// | 228  | Input voltage phase 1 | 3        | uint16 | 0.1   | V       |
+// | 228  | Input current phase N | 6 to 8   | int16  | 0.1   | A AC    |
+// | 228  | Input frequency 1     | 9        | int16  | 0.01  | Hz      |
+// | 228  | Input power phase N   | 12 to 14 | int16  | 10    | VA or W |
+// ==================================================================================================
+// assumption: all phases have the same frequency and nearly the same voltage - so pick the first one
+static const Register VICTRON_REGISTERS[] = {
+  {Metric::VOLTAGE, 228, 0x03, 3, Type::UINT16, WordOrder::HIGH_FIRST, 0.1f, 0, 1},
+  {Metric::CURRENT, 228, 0x03, 6, Type::INT16, WordOrder::HIGH_FIRST, 0.1f, 0, 1},
+  {Metric::CURRENT, 228, 0x03, 7, Type::INT16, WordOrder::HIGH_FIRST, 0.1f, 0, 2},
+  {Metric::CURRENT, 228, 0x03, 8, Type::INT16, WordOrder::HIGH_FIRST, 0.1f, 0, 3},
+  {Metric::FREQUENCY, 228, 0x03, 9, Type::INT16, WordOrder::HIGH_FIRST, 0.01f, 0, 1},
+  {Metric::POWER, 228, 0x03, 12, Type::INT16, WordOrder::HIGH_FIRST, 10.0f, 0, 1},
+  {Metric::POWER, 228, 0x03, 13, Type::INT16, WordOrder::HIGH_FIRST, 10.0f, 0, 2},
+  {Metric::POWER, 228, 0x03, 14, Type::INT16, WordOrder::HIGH_FIRST, 10.0f, 0, 3},
+};
+
+// ======================== SMA inverter with SMA Energy Meter / Sunny Home Manager ========================
+// | Unit | Description                    | Register | Type | Scale | Unit |
+// |------|--------------------------------|----------|------|-------|------|
+// | 3    | Metering.GridMs.TotWhIn        | 30581    | U32  | 1     | Wh   |
+// | 3    | Metering.GridMs.TotWhOut       | 30583    | U32  | 1     | Wh   |
+// | 3    | Metering.GridMs.TotWIn (grid)  | 30865    | U32  | 1     | W    |
+// | 3    | Metering.GridMs.TotWOut (feed) | 30867    | U32  | -1    | W    |
+// | 3    | Metering.GridMs.PhV.phsA       | 31253    | U32  | 0.01  | V    |
+// | 3    | Metering.GridMs.Hz             | 31447    | U32  | 0.01  | Hz   |
+// ========================================================================================================
+static const Register SMA_REGISTERS[] = {
+  {Metric::ENERGY, 3, 0x03, 30581, Type::UINT32, WordOrder::HIGH_FIRST, 1.0f, 0, 0},
+  {Metric::ENERGY_RETURNED, 3, 0x03, 30583, Type::UINT32, WordOrder::HIGH_FIRST, 1.0f, 0, 0},
+  {Metric::POWER, 3, 0x03, 30865, Type::UINT32, WordOrder::HIGH_FIRST, 1.0f, 0, 0},
+  {Metric::POWER, 3, 0x03, 30867, Type::UINT32, WordOrder::HIGH_FIRST, -1.0f, 0, 0},
+  {Metric::VOLTAGE, 3, 0x03, 31253, Type::UINT32, WordOrder::HIGH_FIRST, 0.01f, 0, 1},
+  {Metric::FREQUENCY, 3, 0x03, 31447, Type::UINT32, WordOrder::HIGH_FIRST, 0.01f, 0, 0},
+};
+
+// ======================== Fronius Smart Meter through Datamanager (SunSpec float model 213) ========================
+// Fronius documents registers starting at 1: protocol addresses below are the documented ones minus 1.
+// | Unit | Description    | Register | Type    | Unit |
+// |------|----------------|----------|---------|------|
+// | 240  | A (total)      | 40072    | float32 | A    |
+// | 240  | PhVphA         | 40082    | float32 | V    |
+// | 240  | Hz             | 40096    | float32 | Hz   |
+// | 240  | W (total)      | 40098    | float32 | W    |
+// | 240  | VA (total)     | 40106    | float32 | VA   |
+// | 240  | TotWhExp       | 40130    | float32 | Wh   |
+// | 240  | TotWhImp       | 40138    | float32 | Wh   |
+// ===================================================================================================================
+static const Register FRONIUS_REGISTERS[] = {
+  {Metric::CURRENT, 240, 0x03, 40071, Type::FLOAT32, WordOrder::HIGH_FIRST, 1.0f, 0, 0},
+  {Metric::VOLTAGE, 240, 0x03, 40081, Type::FLOAT32, WordOrder::HIGH_FIRST, 1.0f, 0, 1},
+  {Metric::FREQUENCY, 240, 0x03, 40095, Type::FLOAT32, WordOrder::HIGH_FIRST, 1.0f, 0, 0},
+  {Metric::POWER, 240, 0x03, 40097, Type::FLOAT32, WordOrder::HIGH_FIRST, 1.0f, 0, 0},
+  {Metric::APPARENT_POWER, 240, 0x03, 40105, Type::FLOAT32, WordOrder::HIGH_FIRST, 1.0f, 0, 0},
+  {Metric::ENERGY_RETURNED, 240, 0x03, 40129, Type::FLOAT32, WordOrder::HIGH_FIRST, 1.0f, 0, 0},
+  {Metric::ENERGY, 240, 0x03, 40137, Type::FLOAT32, WordOrder::HIGH_FIRST, 1.0f, 0, 0},
+};
+
+// ======================== SolarEdge inverter with meter 1 (SunSpec integer model 203) ========================
+// SolarEdge documents registers starting at 1: protocol addresses below are the documented ones minus 1.
+// Values are scaled by a SunSpec scale factor register (power of 10).
+// SolarEdge meters count exported power as positive: the sign is inverted.
+// | Unit | Description     | Register | SF register | Type   | Unit |
+// |------|-----------------|----------|-------------|--------|------|
+// | 1    | M_AC_Current    | 40190    | 40194       | int16  | A    |
+// | 1    | M_AC_Voltage_AN | 40196    | 40203       | int16  | V    |
+// | 1    | M_AC_Freq       | 40204    | 40205       | int16  | Hz   |
+// | 1    | M_AC_Power      | 40206    | 40210       | int16  | W    |
+// | 1    | M_AC_VA         | 40211    | 40215       | int16  | VA   |
+// | 1    | M_AC_PF         | 40221    | 40225       | int16  | %    |
+// | 1    | M_Exported      | 40226    | 40242       | uint32 | Wh   |
+// | 1    | M_Imported      | 40234    | 40242       | uint32 | Wh   |
+// ==============================================================================================================
+static const Register SOLAREDGE_REGISTERS[] = {
+  {Metric::CURRENT, 1, 0x03, 40189, Type::INT16, WordOrder::HIGH_FIRST, 1.0f, 40193, 0},
+  {Metric::VOLTAGE, 1, 0x03, 40195, Type::INT16, WordOrder::HIGH_FIRST, 1.0f, 40202, 1},
+  {Metric::FREQUENCY, 1, 0x03, 40203, Type::INT16, WordOrder::HIGH_FIRST, 1.0f, 40204, 0},
+  {Metric::POWER, 1, 0x03, 40205, Type::INT16, WordOrder::HIGH_FIRST, -1.0f, 40209, 0},
+  {Metric::APPARENT_POWER, 1, 0x03, 40210, Type::INT16, WordOrder::HIGH_FIRST, 1.0f, 40214, 0},
+  {Metric::POWER_FACTOR, 1, 0x03, 40220, Type::INT16, WordOrder::HIGH_FIRST, 0.01f, 40224, 0},
+  {Metric::ENERGY_RETURNED, 1, 0x03, 40225, Type::UINT32, WordOrder::HIGH_FIRST, 1.0f, 40241, 0},
+  {Metric::ENERGY, 1, 0x03, 40233, Type::UINT32, WordOrder::HIGH_FIRST, 1.0f, 40241, 0},
+};
+
+#define MAP_SIZE(registers) (sizeof(registers) / sizeof(registers[0]))
+
+const Mycila::Modbus::Map Mycila::Modbus::FRONIUS = {"Fronius", FRONIUS_REGISTERS, MAP_SIZE(FRONIUS_REGISTERS)};
+const Mycila::Modbus::Map Mycila::Modbus::SMA = {"SMA", SMA_REGISTERS, MAP_SIZE(SMA_REGISTERS)};
+const Mycila::Modbus::Map Mycila::Modbus::SOLAREDGE = {"SolarEdge", SOLAREDGE_REGISTERS, MAP_SIZE(SOLAREDGE_REGISTERS)};
+const Mycila::Modbus::Map Mycila::Modbus::VICTRON = {"Victron", VICTRON_REGISTERS, MAP_SIZE(VICTRON_REGISTERS)};
+
+const Mycila::Modbus::Map* Mycila::Modbus::findMap(const char* name) {
+  if (name == nullptr)
+    return nullptr;
+  for (const Map* map : {&FRONIUS, &SMA, &SOLAREDGE, &VICTRON})
+    if (strcmp(map->name, name) == 0)
+      return map;
+  return nullptr;
+}
+
+static uint16_t _width(Type type) {
+  return type == Type::INT16 || type == Type::UINT16 ? 1 : 2;
+}
+
+static bool _word(const std::vector<Mycila::Modbus::Block>& blocks, uint8_t unit, uint8_t function, uint16_t address, uint16_t& word) {
+  for (const Mycila::Modbus::Block& block : blocks) {
+    if (block.unit == unit && block.function == function && address >= block.address) {
+      const size_t index = address - block.address;
+      if (index < block.count && index < block.words.size()) {
+        word = block.words[index];
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+std::vector<Mycila::Modbus::Block> Mycila::Modbus::plan(const Map& map) {
+  // collect all the registers to read, including scale factors
+  std::vector<Block> spans;
+  spans.reserve(map.count * 2);
+  for (size_t i = 0; i < map.count; i++) {
+    const Register& reg = map.registers[i];
+    spans.push_back({reg.unit, reg.function, reg.address, _width(reg.type), {}});
+    if (reg.scaleFactor)
+      spans.push_back({reg.unit, reg.function, reg.scaleFactor, 1, {}});
+  }
+
+  std::sort(spans.begin(), spans.end(), [](const Block& a, const Block& b) {
+    if (a.unit != b.unit)
+      return a.unit < b.unit;
+    if (a.function != b.function)
+      return a.function < b.function;
+    return a.address < b.address;
+  });
+
+  // merge close registers
+  std::vector<Block> blocks;
+  for (const Block& span : spans) {
+    if (!blocks.empty()) {
+      Block& last = blocks.back();
+      const uint32_t lastEnd = static_cast<uint32_t>(last.address) + last.count;
+      const uint32_t spanEnd = static_cast<uint32_t>(span.address) + span.count;
+      if (last.unit == span.unit && last.function == span.function && span.address <= lastEnd + MODBUS_MAX_GAP && std::max(lastEnd, spanEnd) - last.address <= MODBUS_MAX_WORDS) {
+        last.count = std::max(lastEnd, spanEnd) - last.address;
+        continue;
+      }
+    }
+    blocks.push_back(span);
+  }
+
+  return blocks;
+}
+
+bool Mycila::Modbus::parse(const uint8_t* response, size_t len, Block& block) {
+  if (response == nullptr || len < 3)
+    return false;
+
+  // an exception response has the high bit of the function code set
+  if (response[1] != block.function || response[2] != 2u * block.count || len < 3u + response[2])
+    return false;
+
+  block.words.resize(block.count);
+  for (size_t i = 0; i < block.count; i++)
+    block.words[i] = (static_cast<uint16_t>(response[3 + 2 * i]) << 8) | response[4 + 2 * i];
+
+  return true;
+}
+
+bool Mycila::Modbus::decode(const Register& reg, const std::vector<Block>& blocks, float& value) {
+  uint16_t hi = 0;
+  uint16_t lo = 0;
+
+  if (!_word(blocks, reg.unit, reg.function, reg.address, hi))
+    return false;
+
+  if (_width(reg.type) == 2) {
+    if (!_word(blocks, reg.unit, reg.function, reg.address + 1, lo))
+      return false;
+    if (reg.order == WordOrder::LOW_FIRST)
+      std::swap(hi, lo);
+  }
+
+  const uint32_t raw = (static_cast<uint32_t>(hi) << 16) | lo;
+
+  switch (reg.type) {
+    case Type::INT16:
+      // 0x8000 is the SunSpec "not implemented" value
+      value = reg.scaleFactor && hi == 0x8000 ? NAN : static_cast<int16_t>(hi);
+      break;
+    case Type::UINT16:
+      value = hi;
+      break;
+    case Type::INT32:
+      value = static_cast<int32_t>(raw);
+      break;
+    case Type::UINT32:
+      value = raw;
+      break;
+    case Type::FLOAT32: {
+      float f;
+      memcpy(&f, &raw, sizeof(f));
+      value = f;
+      break;
+    }
+    default:
+      value = NAN;
+      break;
+  }
+
+  value *= reg.scale;
+
+  if (reg.scaleFactor) {
+    uint16_t sf = 0;
+    if (!_word(blocks, reg.unit, reg.function, reg.scaleFactor, sf))
+      return false;
+    value *= std::pow(10.0f, static_cast<float>(static_cast<int16_t>(sf)));
+  }
+
+  return true;
+}
+
+bool Mycila::Modbus::decode(const Map& map, const std::vector<Block>& blocks, Metrics& metrics) {
+  constexpr size_t METRICS = static_cast<size_t>(Metric::VOLTAGE) + 1;
+  float values[METRICS][4];
+  for (size_t m = 0; m < METRICS; m++)
+    for (size_t p = 0; p < 4; p++)
+      values[m][p] = NAN;
+
+  for (size_t i = 0; i < map.count; i++) {
+    const Register& reg = map.registers[i];
+    float value;
+    if (!decode(reg, blocks, value))
+      return false;
+    if (std::isnan(value) || reg.phase > 3)
+      continue;
+    float& slot = values[static_cast<size_t>(reg.metric)][reg.phase];
+    slot = std::isnan(slot) ? value : slot + value;
+  }
+
+  float results[METRICS];
+  for (size_t m = 0; m < METRICS; m++) {
+    results[m] = values[m][0];
+    if (!std::isnan(results[m]))
+      continue;
+    const Metric metric = static_cast<Metric>(m);
+    const bool perPhase = metric == Metric::VOLTAGE || metric == Metric::FREQUENCY || metric == Metric::POWER_FACTOR;
+    for (size_t p = 1; p < 4; p++) {
+      if (std::isnan(values[m][p]))
+        continue;
+      if (perPhase) {
+        results[m] = values[m][p];
+        break;
+      }
+      results[m] = std::isnan(results[m]) ? values[m][p] : results[m] + values[m][p];
+    }
+  }
+
+  metrics.apparentPower = results[static_cast<size_t>(Metric::APPARENT_POWER)];
+  metrics.current = results[static_cast<size_t>(Metric::CURRENT)];
+  metrics.energy = results[static_cast<size_t>(Metric::ENERGY)];
+  metrics.energyReturned = results[static_cast<size_t>(Metric::ENERGY_RETURNED)];
+  metrics.frequency = results[static_cast<size_t>(Metric::FREQUENCY)];
+  metrics.power = results[static_cast<size_t>(Metric::POWER)];
+  metrics.powerFactor = results[static_cast<size_t>(Metric::POWER_FACTOR)];
+  metrics.voltage = results[static_cast<size_t>(Metric::VOLTAGE)];
+
+  return true;
+}
@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// This file does not depend on Arduino: register maps and their decoding can be compiled and checked on host.
+
+namespace Mycila {
+  namespace Modbus {
+    enum class Metric : uint8_t {
+      APPARENT_POWER,
+      CURRENT,
+      ENERGY,
+      ENERGY_RETURNED,
+      FREQUENCY,
+      POWER,
+      POWER_FACTOR,
+      VOLTAGE,
+    };
+
+    enum class Type : uint8_t {
+      INT16,
+      UINT16,
+      INT32,
+      UINT32,
+      FLOAT32,
+    };
+
+    /**
+     * @brief Order of the 2 words of a 32-bit value. Bytes inside a word are always big-endian.
+     */
+    enum class WordOrder : uint8_t {
+      // ABCD: high word first (SunSpec, SMA, Fronius)
+      HIGH_FIRST,
+      // CDAB: low word first
+      LOW_FIRST,
+    };
+
+    /**
+     * @brief Describes where and how to read one value of a meter
+     */
+    struct Register {
+        Metric metric;
+        // Modbus unit (slave) ID
+        uint8_t unit;
+        // function code: 0x03 (holding registers) or 0x04 (input registers)
+        uint8_t function;
+        // protocol address (0-based)
+        uint16_t address;
+        Type type;
+        WordOrder order;
+        // multiplier applied to the raw value: also used to invert the sign when the meter counts export as positive
+        float scale;
+        // address of a SunSpec scale factor register (int16 power of 10) on the same unit and function, or 0 if none
+        uint16_t scaleFactor;
+        // 0 for a total, 1 to 3 for a phase
+        uint8_t phase;
+    };
+
+    /**
+     * @brief A meter register map.
+     *
+     * Values of the same metric and phase are summed.
+     * If a metric has no total (phase 0), voltage, frequency and power factor are taken from the first phase and others are the sum of all phases.
+     */
+    struct Map {
+        const char* name;
+        const Register* registers;
+        size_t count;
+    };
+
+    /**
+     * @brief A request of contiguous registers computed from a map and the words received for it
+     */
+    struct Block {
+        uint8_t unit;
+        uint8_t function;
+        uint16_t address;
+        uint16_t count;
+        std::vector<uint16_t> words;
+    };
+
+    struct Metrics {
+        float apparentPower = NAN;
+        float current = NAN;
+        float energy = NAN;
+        float energyReturned = NAN;
+        float frequency = NAN;
+        float power = NAN;
+        float powerFactor = NAN;
+        float voltage = NAN;
+    };
+
+    extern const Map FRONIUS;
+    extern const Map SMA;
+    extern const Map SOLAREDGE;
+    extern const Map VICTRON;
+
+    /**
+     * @brief Find a built-in map by name (case sensitive): Fronius, SMA, SolarEdge, Victron
+     *
+     * @return the map or nullptr if not found
+     */
+    const Map* findMap(const char* name);
+
+    /**
+     * @brief Group the registers of a map into as few requests as possible.
+     *
+     * Registers are merged when they share the same unit and function and are close enough so that the request does not exceed the Modbus limit.
+     */
+    std::vector<Block> plan(const Map& map);
+
+    /**
+     * @brief Store the words of a read response in its block.
+     *
+     * The response is: unit (1 byte), function (1 byte), byte count (1 byte), data (2 bytes per register, big-endian).
+     *
+     * @return false if the response is truncated or does not answer the block request
+     */
+    bool parse(const uint8_t* response, size_t len, Block& block);
+
+    /**
+     * @brief Decode the value of one register from the words received for the blocks.
+     *
+     * @param value: the scaled value, or NAN if the device reports the value as not implemented
+     * @return false if the register was not received
+     */
+    bool decode(const Register& reg, const std::vector<Block>& blocks, float& value);
+
+    /**
+     * @brief Decode all the metrics of a map from the words received for the blocks
+     *
+     * @return false if a register of the map was not received
+     */
+    bool decode(const Map& map, const std::vector<Block>& blocks, Metrics& metrics);
+  } // namespace Modbus
+} // namespace Mycila
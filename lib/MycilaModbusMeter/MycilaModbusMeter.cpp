@@ -0,0 +1,189 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#include <MycilaModbusMeter.h>
+
+#include <algorithm>
+#include <string>
+
+#include <MycilaLogFilter.h>
+
+#define TAG "MODBUS"
+
+// A token is made of the read sequence number (upper 24 bits) and the block index (lower 8 bits)
+#define TOKEN_BLOCK_BITS 8
+#define TOKEN_BLOCK_MASK 0xFF
+// _pending is a bit mask of the blocks
+#define MAX_BLOCKS 32
+// a read still in flight after this delay is abandoned
+#define READ_TIMEOUT_MS 5000
+// weight of the last value in the read interval moving average
+#define READ_INTERVAL_EMA_ALPHA 0.2f
+
+void Mycila::ModbusMeter::begin(const char* host, uint16_t port, const Modbus::Map& map) {
+  if (_client) {
+    return;
+  }
+
+  _blocks = Modbus::plan(map);
+  if (_blocks.size() > MAX_BLOCKS) {
+    MYCILA_LOGE(TAG, "Register map %s needs %zu requests: maximum is %d", map.name, _blocks.size(), MAX_BLOCKS);
+    _blocks.clear();
+    return;
+  }
+
+  MYCILA_LOGI(TAG, "Connecting to %s Modbus TCP Server %s:%" PRIu16 " (%zu requests per read)", map.name, host, port, _blocks.size());
+
+  _map = &map;
+  _client = new ModbusClientTCPasync(IPAddress(host), port);
+  // _client->setTimeout(DEFAULTTIMEOUT);
+  // _client->setIdleTimeout(DEFAULTIDLETIME);
+  // all requests of a read are sent at once
+  _client->setMaxInflightRequests(_blocks.size());
+
+  _client->onDataHandler([this](ModbusMessage response, uint32_t token) { _onData(response, token); });
+
+  _client->onErrorHandler([this](Error error, uint32_t token) {
+    // ModbusError wraps the error code and provides a readable error message for it
+    this->_setError(ModbusError(error), token);
+  });
+}
+
+void Mycila::ModbusMeter::end() {
+  if (_client) {
+    MYCILA_LOGI(TAG, "Disconnecting from %s Modbus TCP Server", _map->name);
+    _client->disconnect();
+    delete _client;
+    _client = nullptr;
+    _map = nullptr;
+    _blocks.clear();
+    _pending = 0;
+    _readEnd = 0;
+    _readInterval = 0;
+    _rttCount = 0;
+    _lastError = "";
+    _metrics = Modbus::Metrics();
+  }
+}
+
+bool Mycila::ModbusMeter::read() {
+  if (!_client)
+    return false;
+
+  if (_pending) {
+    if (millis() - _readStart < READ_TIMEOUT_MS) {
+      _skipped++;
+      return false;
+    }
+    MYCILA_LOGW(TAG, "Abandoning read %" PRIu32 " after %d ms", _sequence.load(), READ_TIMEOUT_MS);
+    _errors++;
+  }
+
+  // a new read supersedes any unfinished one: late responses will be discarded thanks to their token
+  _readStart = millis();
+  _pending = 0;
+  const uint32_t sequence = (_sequence + 1) & (UINT32_MAX >> TOKEN_BLOCK_BITS);
+  _sequence = sequence;
+
+  for (Modbus::Block& block : _blocks)
+    block.words.clear();
+
+  // all the blocks are marked pending before the first request is sent:
+  // a response can be received before addRequest() returns, and the read must not complete before all the requests are sent
+  _pending = _blocks.size() == MAX_BLOCKS ? UINT32_MAX : (1UL << _blocks.size()) - 1;
+
+  for (size_t i = 0; i < _blocks.size(); i++) {
+    const Modbus::Block& block = _blocks[i];
+
+    // If something is missing or wrong with the call parameters, we will immediately get an error code
+    // and the request will not be issued: the whole read is then cancelled and the responses of the requests already sent are discarded
+    const uint32_t token = (sequence << TOKEN_BLOCK_BITS) | i;
+    Error err = _client->addRequest(token, block.unit, block.function, block.address, block.count);
+    if (err != SUCCESS) {
+      _setError(ModbusError(err), token);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+uint32_t Mycila::ModbusMeter::getRTT(float percentile) const {
+  const size_t count = std::min(_rttCount, _rtt.size());
+  if (!count)
+    return 0;
+  std::array<uint16_t, 32> sorted = _rtt;
+  const size_t n = std::min(count - 1, static_cast<size_t>(percentile * count));
+  std::nth_element(sorted.begin(), sorted.begin() + n, sorted.begin() + count);
+  return sorted[n];
+}
+
+void Mycila::ModbusMeter::_onData(ModbusMessage& response, uint32_t token) {
+  const uint32_t sequence = token >> TOKEN_BLOCK_BITS;
+  const size_t index = token & TOKEN_BLOCK_MASK;
+
+  const uint32_t bit = 1UL << index;
+
+  if (sequence != _sequence || index >= _blocks.size() || !(_pending & bit)) {
+    MYCILA_LOGD(TAG, "Discarding late response, token: %" PRIu32, token);
+    return;
+  }
+
+  if (!Modbus::parse(response.data(), response.size(), _blocks[index])) {
+    _setError(ModbusError(PACKET_LENGTH_ERROR), token);
+    return;
+  }
+
+  if (_pending.fetch_and(~bit) & ~bit)
+    return;
+
+  Modbus::Metrics metrics;
+  if (!Modbus::decode(*_map, _blocks, metrics)) {
+    // all the responses were received but the registers of the map are not in them: the map is wrong
+    _errors++;
+    _lastError = "Unable to decode the registers of ";
+    _lastError += _map->name;
+    MYCILA_LOGW(TAG, "%s, token: %" PRIu32, _lastError.c_str(), token);
+    if (_callback) {
+      _callback(EventType::EVT_ERROR);
+    }
+    return;
+  }
+
+  const uint32_t now = millis();
+  _rtt[_rttCount++ % _rtt.size()] = std::min(now - _readStart, static_cast<uint32_t>(UINT16_MAX));
+  if (_readEnd)
+    _readInterval = _readInterval > 0 ? _readInterval + READ_INTERVAL_EMA_ALPHA * ((now - _readEnd) - _readInterval) : now - _readEnd;
+  _readEnd = now;
+  _reads++;
+
+  _metrics = metrics;
+  _lastError = "";
+
+  if (_callback) {
+    _callback(EventType::EVT_READ);
+  }
+}
+
+void Mycila::ModbusMeter::_setError(ModbusError&& error, uint32_t token) {
+  // the read in flight failed: allow the next one to be sent
+  if ((token >> TOKEN_BLOCK_BITS) == _sequence && _pending.exchange(0))
+    _errors++;
+
+  std::string msg;
+  msg.reserve(128);
+  msg.clear();
+  msg = "Error ";
+  msg += std::to_string((int)error); // NOLINT
+  msg += ": ";
+  msg += (const char*)error; // NOLINT
+  msg += ", token: ";
+  msg += std::to_string(token);
+
+  _lastError = msg;
+
+  if (_callback) {
+    _callback(EventType::EVT_ERROR);
+  }
+}
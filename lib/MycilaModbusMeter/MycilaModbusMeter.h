@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#pragma once
+
+#include <MycilaModbusMap.h>
+#include <ModbusClientTCPasync.h>
+
+#ifdef MYCILA_JSON_SUPPORT
+  #include <ArduinoJson.h>
+#endif
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace Mycila {
+  /**
+   * @brief Reads a grid meter through Modbus TCP, driven by a register map (see MycilaModbusMap.h)
+   */
+  class ModbusMeter {
+    public:
+      enum class EventType {
+        EVT_READ,
+        EVT_ERROR,
+      };
+
+      typedef std::function<void(EventType eventType)> Callback;
+
+      void setCallback(Callback callback) { _callback = callback; }
+
+      void begin(const char* host, uint16_t port, const Modbus::Map& map);
+      void end();
+
+      bool isEnabled() const { return _client != nullptr; }
+
+      /**
+       * @brief Request to read the meter metrics.
+       *
+       * All the requests needed by the map are sent at once and matched back with their token.
+       * The callback is called with EVT_READ once all the responses of the same read have been received.
+       *
+       * @return false if the previous read is still in flight: no request is queued so that a slow device does not pile them up
+       */
+      bool read();
+
+      /**
+       * @brief Returns true if a read was sent and not all responses were received yet
+       */
+      bool isReading() const { return _pending != 0; }
+
+      /**
+       * @brief Get the round-trip time percentile in ms of the last completed reads
+       *
+       * @param percentile: in the range [0.0, 1.0]
+       */
+      uint32_t getRTT(float percentile) const;
+
+      /**
+       * @brief Get the rate of completed reads per second
+       */
+      float getRate() const { return _readInterval > 0 ? 1000.0f / _readInterval : 0; }
+
+      const char* getModel() const { return _map ? _map->name : ""; }
+      const Modbus::Metrics& getMetrics() const { return _metrics; }
+      std::string getLastError() const { return _lastError; }
+      bool hasError() const { return !_lastError.empty(); }
+
+#ifdef MYCILA_JSON_SUPPORT
+      void toJson(const JsonObject& root) const {
+        root["model"] = getModel();
+        root["requests"] = _blocks.size();
+        root["reads"] = _reads;
+        root["errors"] = _errors;
+        root["skipped"] = _skipped;
+        root["rate"] = getRate();
+        root["rtt_p50"] = getRTT(0.5f);
+        root["rtt_p90"] = getRTT(0.9f);
+        root["rtt_p99"] = getRTT(0.99f);
+        if (!isnan(_metrics.apparentPower))
+          root["apparent_power"] = _metrics.apparentPower;
+        if (!isnan(_metrics.current))
+          root["current"] = _metrics.current;
+        if (!isnan(_metrics.energy))
+          root["energy"] = _metrics.energy;
+        if (!isnan(_metrics.energyReturned))
+          root["energy_returned"] = _metrics.energyReturned;
+        if (!isnan(_metrics.frequency))
+          root["frequency"] = _metrics.frequency;
+        if (!isnan(_metrics.power))
+          root["power"] = _metrics.power;
+        if (!isnan(_metrics.powerFactor))
+          root["power_factor"] = _metrics.powerFactor;
+        if (!isnan(_metrics.voltage))
+          root["voltage"] = _metrics.voltage;
+        if (_lastError.length())
+          root["error"] = _lastError;
+      }
+#endif
+
+    private:
+      ModbusClientTCPasync* _client = nullptr;
+      const Modbus::Map* _map = nullptr;
+      std::vector<Modbus::Block> _blocks;
+      Callback _callback = nullptr;
+      Modbus::Metrics _metrics;
+      std::string _lastError;
+      // read sequence number, stored in the upper bits of the request tokens
+      std::atomic<uint32_t> _sequence = 0;
+      // one bit per block still waiting for a response: responses are received from the async TCP task
+      std::atomic<uint32_t> _pending = 0;
+      // time when the read in flight was sent
+      uint32_t _readStart = 0;
+      // time when the last read completed
+      uint32_t _readEnd = 0;
+      // moving average of the time between 2 completed reads in ms
+      float _readInterval = 0;
+      uint32_t _reads = 0;
+      uint32_t _errors = 0;
+      uint32_t _skipped = 0;
+      // round-trip times in ms of the last completed reads
+      std::array<uint16_t, 32> _rtt = {};
+      size_t _rttCount = 0;
+
+      void _onData(ModbusMessage& response, uint32_t token);
+      void _setError(ModbusError&& error, uint32_t token);
+  };
+} // namespace Mycila
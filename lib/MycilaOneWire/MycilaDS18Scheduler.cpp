@@ -0,0 +1,225 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#include <MycilaDS18Scheduler.h>
+
+#include <algorithm>
+
+#define DS18_CMD_CONVERT_T        0x44
+#define DS18_CMD_READ_SCRATCHPAD  0xBE
+#define DS18_CMD_WRITE_SCRATCHPAD 0x4E
+
+#define DS18S20_FAMILY 0x10
+#define DS18B20_FAMILY 0x28
+#define DS1822_FAMILY  0x22
+
+// temperature register at power-on, before the first conversion
+#define DS18_POWER_ON_VALUE 0x0550
+// a probe keeps its last temperature for a few failed reads before it is considered gone
+#define DS18_MAX_FAILURES 3
+
+static bool _supported(uint64_t address) {
+  const uint8_t family = address & 0xFF;
+  return family == DS18B20_FAMILY || family == DS1822_FAMILY || family == DS18S20_FAMILY;
+}
+
+static bool _configurable(uint64_t address) {
+  return (address & 0xFF) != DS18S20_FAMILY;
+}
+
+// maximum conversion time of the datasheet: 93.75 ms at 9 bits, doubled for each additional bit.
+// it is rounded up so that the probe is never read before the end of its conversion.
+// DS18S20 probes always take 750 ms.
+static uint32_t _conversionTime(uint64_t address, uint8_t resolution) {
+  const uint8_t shift = 12 - resolution;
+  return _configurable(address) ? (750 + (1 << shift) - 1) >> shift : 750;
+}
+
+bool Mycila::DS18Bus::begin(uint8_t resolution, uint8_t maxRetries) {
+  if (isEnabled())
+    return true;
+
+  resolution = std::clamp<uint8_t>(resolution, 9, 12);
+
+  uint64_t addresses[MYCILA_DS18_MAX_PROBES_PER_BUS];
+  size_t count = 0;
+  for (uint8_t attempt = 0; attempt <= maxRetries && !count; attempt++)
+    count = _bus.search(addresses, MYCILA_DS18_MAX_PROBES_PER_BUS);
+
+  for (size_t i = 0; i < count; i++) {
+    if (!_supported(addresses[i]))
+      continue;
+    // until the resolution is set, a probe is assumed to be at the slowest one
+    _probes.push_back({addresses[i], static_cast<uint8_t>(_configurable(addresses[i]) ? 12 : 9)});
+    setResolution(_probes.size() - 1, resolution);
+  }
+
+  return isEnabled();
+}
+
+void Mycila::DS18Bus::end() {
+  _probes.clear();
+  _lastTime = 0;
+  _lastTemperature = NAN;
+  _converting = false;
+}
+
+bool Mycila::DS18Bus::setResolution(size_t probe, uint8_t resolution) {
+  if (probe >= _probes.size() || resolution < 9 || resolution > 12 || !_configurable(_probes[probe].address))
+    return false;
+
+  // TH and TL alarm registers are not used
+  const uint8_t scratchpad[] = {DS18_CMD_WRITE_SCRATCHPAD, 0x4B, 0x46, static_cast<uint8_t>(((resolution - 9) << 5) | 0x1F)};
+  if (!_bus.select(_probes[probe].address))
+    return false;
+  _bus.write(scratchpad, sizeof(scratchpad));
+
+  _probes[probe].resolution = resolution;
+  return true;
+}
+
+std::optional<float> Mycila::DS18Bus::getTemperature() const {
+  float max = NAN;
+  for (const Probe& probe : _probes)
+    if (!std::isnan(probe.temperature) && (std::isnan(max) || probe.temperature > max))
+      max = probe.temperature;
+  return std::isnan(max) ? std::nullopt : std::optional<float>(max);
+}
+
+std::optional<float> Mycila::DS18Bus::getTemperature(size_t probe) const {
+  if (probe >= _probes.size() || std::isnan(_probes[probe].temperature))
+    return std::nullopt;
+  return _probes[probe].temperature;
+}
+
+uint32_t Mycila::DS18Bus::getConversionTime() const {
+  uint32_t time = 0;
+  for (const Probe& probe : _probes)
+    time = std::max(time, _conversionTime(probe.address, probe.resolution));
+  return time;
+}
+
+bool Mycila::DS18Bus::convert() {
+  _converting = isEnabled() && _bus.skip();
+  if (_converting)
+    _bus.write(DS18_CMD_CONVERT_T);
+  return _converting;
+}
+
+bool Mycila::DS18Bus::read(uint32_t now) {
+  if (!_converting)
+    return false;
+  _converting = false;
+
+  bool success = false;
+  for (Probe& probe : _probes) {
+    if (_read(probe)) {
+      probe.failures = 0;
+      success = true;
+    } else {
+      probe.errors++;
+      if (++probe.failures >= DS18_MAX_FAILURES)
+        probe.temperature = NAN;
+    }
+  }
+
+  std::optional<float> temperature = getTemperature();
+  if (!success || !temperature.has_value())
+    return false;
+
+  // 0 is reserved for "never read"
+  _lastTime = now ? now : 1;
+  const bool changed = temperature.value() != _lastTemperature;
+  _lastTemperature = temperature.value();
+
+  if (_callback)
+    _callback(temperature.value(), changed);
+
+  return true;
+}
+
+bool Mycila::DS18Bus::_read(Probe& probe) {
+  uint8_t scratchpad[9];
+  if (!_bus.select(probe.address))
+    return false;
+  _bus.write(DS18_CMD_READ_SCRATCHPAD);
+  _bus.read(scratchpad, sizeof(scratchpad));
+
+  // a missing probe reads as all ones, and a shorted bus as all zeros which has a valid CRC
+  if (OneWire::crc8(scratchpad, 8) != scratchpad[8] || (_configurable(probe.address) && (scratchpad[4] & 0x1F) != 0x1F))
+    return false;
+
+  int16_t raw = static_cast<int16_t>((scratchpad[1] << 8) | scratchpad[0]);
+  float temperature;
+
+  if (_configurable(probe.address)) {
+    if (raw == DS18_POWER_ON_VALUE)
+      return false;
+    // the lowest bits are undefined below 12 bits
+    raw &= ~((1 << (12 - probe.resolution)) - 1);
+    temperature = raw / 16.0f;
+  } else {
+    // DS18S20: 0.5 °C register extended with the count remaining
+    if (raw == DS18_POWER_ON_VALUE >> 3)
+      return false;
+    temperature = (raw >> 1) - 0.25f + (scratchpad[7] - scratchpad[6]) / static_cast<float>(scratchpad[7] ? scratchpad[7] : 16);
+  }
+
+  probe.temperature = temperature;
+  return true;
+}
+
+void Mycila::DS18Scheduler::clear() {
+  _buses.clear();
+  _lastConversions.clear();
+  _converting = false;
+}
+
+uint32_t Mycila::DS18Scheduler::loop(uint32_t now) {
+  _lastConversions.resize(_buses.size());
+
+  if (_converting) {
+    if (now - _conversionStart < _conversionTime)
+      return _conversionTime - (now - _conversionStart);
+
+    for (DS18Bus* bus : _buses)
+      bus->read(now);
+    _converting = false;
+  }
+
+  // start the conversions of all the buses due at once
+  _conversionTime = 0;
+  for (size_t i = 0; i < _buses.size(); i++) {
+    DS18Bus* bus = _buses[i];
+    if (!bus->isEnabled() || (_lastConversions[i].has_value() && now - _lastConversions[i].value() < bus->getInterval()))
+      continue;
+    if (bus->convert()) {
+      _conversionTime = std::max(_conversionTime, bus->getConversionTime());
+      _converting = true;
+    }
+    // a bus that cannot be reset is retried at its next interval
+    _lastConversions[i] = now;
+  }
+
+  if (_converting) {
+    _conversionStart = now;
+    return std::max<uint32_t>(_conversionTime, 1);
+  }
+
+  return _next(now);
+}
+
+uint32_t Mycila::DS18Scheduler::_next(uint32_t now) const {
+  uint32_t delay = UINT32_MAX;
+  for (size_t i = 0; i < _buses.size(); i++) {
+    if (!_buses[i]->isEnabled())
+      continue;
+    if (!_lastConversions[i].has_value())
+      return 1;
+    const uint32_t elapsed = now - _lastConversions[i].value();
+    delay = std::min(delay, elapsed < _buses[i]->getInterval() ? _buses[i]->getInterval() - elapsed : 0);
+  }
+  // nothing to read: check again later in case a bus is enabled
+  return delay == UINT32_MAX ? 1000 : std::max<uint32_t>(delay, 1);
+}
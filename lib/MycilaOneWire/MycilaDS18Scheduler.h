@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#pragma once
+
+#include <MycilaOneWire.h>
+
+#ifdef MYCILA_JSON_SUPPORT
+  #include <ArduinoJson.h>
+#endif
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <optional>
+#include <vector>
+
+// This file does not depend on Arduino: the scheduler is driven with the current time and can be checked on host against a simulated bus.
+
+#ifndef MYCILA_DS18_MAX_PROBES_PER_BUS
+  #define MYCILA_DS18_MAX_PROBES_PER_BUS 4
+#endif
+
+namespace Mycila {
+  /**
+   * @brief The DS18B20 / DS1822 / DS18S20 temperature probes of one 1-Wire bus.
+   *
+   * Several probes can share a bus (for example at the top and bottom of a water tank):
+   * the temperature of the bus is the highest temperature of its probes, so that temperature limits are never exceeded.
+   * Each probe has its own resolution: the conversion time of the bus is the one of its slowest probe.
+   */
+  class DS18Bus {
+    public:
+      typedef std::function<void(float temperature, bool changed)> Callback;
+
+      explicit DS18Bus(OneWire::Bus& bus) : _bus(bus) {}
+
+      /**
+       * @brief Search the probes of the bus and set their resolution
+       *
+       * @param resolution: 9 to 12 bits (94 ms to 750 ms conversion), ignored by DS18S20 probes
+       * @param maxRetries: number of additional searches when no probe answers
+       * @return true if at least one probe was found
+       */
+      bool begin(uint8_t resolution = 12, uint8_t maxRetries = 0);
+      void end();
+
+      bool isEnabled() const { return !_probes.empty(); }
+
+      size_t getProbeCount() const { return _probes.size(); }
+      uint64_t getAddress(size_t probe) const { return _probes[probe].address; }
+      uint8_t getResolution(size_t probe) const { return _probes[probe].resolution; }
+
+      /**
+       * @brief Change the resolution of a probe (9 to 12 bits)
+       *
+       * @return false if the probe does not answer or does not support it (DS18S20)
+       */
+      bool setResolution(size_t probe, uint8_t resolution);
+
+      // highest temperature of the probes having a valid reading
+      std::optional<float> getTemperature() const;
+      std::optional<float> getTemperature(size_t probe) const;
+
+      // time in ms of the last successful read, 0 if none
+      uint32_t getLastTime() const { return _lastTime; }
+
+      // minimum time in ms between 2 conversions
+      void setInterval(uint32_t interval) { _interval = interval; }
+      uint32_t getInterval() const { return _interval; }
+
+      // time in ms needed by the slowest probe of the bus to convert a temperature
+      uint32_t getConversionTime() const;
+
+      /**
+       * @brief Called after each read where at least one probe has a valid temperature
+       */
+      void listen(Callback callback) { _callback = callback; }
+
+      /**
+       * @brief Start a temperature conversion on all the probes of the bus at once (skip ROM)
+       */
+      bool convert();
+
+      /**
+       * @brief Read the probes once the conversion time has elapsed
+       *
+       * @param now: current time in ms, recorded as the last read time
+       * @return false if no probe could be read
+       */
+      bool read(uint32_t now);
+
+#ifdef MYCILA_JSON_SUPPORT
+      void toJson(const JsonObject& root) const {
+        root["enabled"] = isEnabled();
+        std::optional<float> temperature = getTemperature();
+        if (temperature.has_value())
+          root["temperature"] = temperature.value();
+        root["time"] = _lastTime;
+        root["interval"] = _interval;
+        root["conversion_time"] = getConversionTime();
+        JsonArray probes = root["probes"].to<JsonArray>();
+        for (size_t i = 0; i < _probes.size(); i++) {
+          JsonObject probe = probes.add<JsonObject>();
+          char address[17];
+          snprintf(address, sizeof(address), "%016llx", static_cast<unsigned long long>(__builtin_bswap64(_probes[i].address)));
+          probe["address"] = address;
+          probe["resolution"] = _probes[i].resolution;
+          if (!std::isnan(_probes[i].temperature))
+            probe["temperature"] = _probes[i].temperature;
+          probe["errors"] = _probes[i].errors;
+        }
+      }
+#endif
+
+    private:
+      struct Probe {
+          uint64_t address;
+          uint8_t resolution;
+          float temperature = NAN;
+          // consecutive read errors
+          uint8_t failures = 0;
+          uint32_t errors = 0;
+      };
+
+      OneWire::Bus& _bus;
+      std::vector<Probe> _probes;
+      Callback _callback = nullptr;
+      uint32_t _interval = 0;
+      uint32_t _lastTime = 0;
+      float _lastTemperature = NAN;
+      bool _converting = false;
+
+      bool _read(Probe& probe);
+
+      friend class DS18Scheduler;
+  };
+
+  /**
+   * @brief Reads the DS18 probes of several buses without blocking.
+   *
+   * Conversions are started on all the buses that are due at the same time, then the probes are read once the slowest conversion is done:
+   * a 12-bit cycle takes 750 ms whatever the number of buses, instead of 750 ms per probe.
+   * loop() never waits: it returns the delay before it must be called again.
+   */
+  class DS18Scheduler {
+    public:
+      void add(DS18Bus& bus) { _buses.push_back(&bus); }
+      void clear();
+
+      /**
+       * @brief Run the next step of the cycle: start the conversions of the buses that are due, or read the buses once their conversion is done
+       *
+       * @param now: current time in ms
+       * @return the delay in ms before the next step (at least 1 ms)
+       */
+      uint32_t loop(uint32_t now);
+
+      bool isConverting() const { return _converting; }
+
+    private:
+      std::vector<DS18Bus*> _buses;
+      bool _converting = false;
+      uint32_t _conversionStart = 0;
+      uint32_t _conversionTime = 0;
+      // time of the last conversion of each bus
+      std::vector<std::optional<uint32_t>> _lastConversions;
+
+      uint32_t _next(uint32_t now) const;
+  };
+} // namespace Mycila
@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#include <MycilaOneWire.h>
+
+uint8_t Mycila::OneWire::crc8(const uint8_t* data, size_t len) {
+  uint8_t crc = 0;
+  for (size_t i = 0; i < len; i++) {
+    uint8_t byte = data[i];
+    for (int bit = 0; bit < 8; bit++) {
+      const bool mix = (crc ^ byte) & 0x01;
+      crc >>= 1;
+      if (mix)
+        crc ^= 0x8C;
+      byte >>= 1;
+    }
+  }
+  return crc;
+}
+
+void Mycila::OneWire::Bus::write(uint8_t byte) {
+  for (int bit = 0; bit < 8; bit++)
+    writeBit((byte >> bit) & 0x01);
+}
+
+void Mycila::OneWire::Bus::write(const uint8_t* data, size_t len) {
+  for (size_t i = 0; i < len; i++)
+    write(data[i]);
+}
+
+uint8_t Mycila::OneWire::Bus::read() {
+  uint8_t byte = 0;
+  for (int bit = 0; bit < 8; bit++)
+    if (readBit())
+      byte |= 1 << bit;
+  return byte;
+}
+
+void Mycila::OneWire::Bus::read(uint8_t* data, size_t len) {
+  for (size_t i = 0; i < len; i++)
+    data[i] = read();
+}
+
+bool Mycila::OneWire::Bus::skip() {
+  if (!reset())
+    return false;
+  write(CMD_SKIP_ROM);
+  return true;
+}
+
+bool Mycila::OneWire::Bus::select(uint64_t rom) {
+  if (!reset())
+    return false;
+  write(CMD_MATCH_ROM);
+  for (int i = 0; i < 8; i++)
+    write(static_cast<uint8_t>(rom >> (8 * i)));
+  return true;
+}
+
+size_t Mycila::OneWire::Bus::search(uint64_t* roms, size_t max) {
+  size_t count = 0;
+  uint64_t rom = 0;
+  // bit position of the last branch where the 0 path was taken, -1 when all branches are explored
+  int lastDiscrepancy = 64;
+
+  while (count < max && lastDiscrepancy >= 0) {
+    if (!reset())
+      break;
+    write(CMD_SEARCH_ROM);
+
+    int discrepancy = -1;
+    for (int i = 0; i < 64; i++) {
+      const bool bit = readBit();
+      const bool complement = readBit();
+
+      // no device is taking part in the search anymore
+      if (bit && complement)
+        return count;
+
+      bool direction;
+      if (bit != complement) {
+        // all the remaining devices have the same bit
+        direction = bit;
+      } else {
+        // conflict: replay the previous path before the last discrepancy, then take the 1 path at it and the 0 path after it
+        direction = i < lastDiscrepancy && lastDiscrepancy != 64 ? (rom >> i) & 0x01 : i == lastDiscrepancy;
+        if (!direction)
+          discrepancy = i;
+      }
+
+      if (direction)
+        rom |= 1ULL << i;
+      else
+        rom &= ~(1ULL << i);
+      writeBit(direction);
+    }
+
+    uint8_t bytes[8];
+    for (int i = 0; i < 8; i++)
+      bytes[i] = static_cast<uint8_t>(rom >> (8 * i));
+    if (crc8(bytes, 7) != bytes[7])
+      break;
+
+    roms[count++] = rom;
+    lastDiscrepancy = discrepancy;
+  }
+
+  return count;
+}
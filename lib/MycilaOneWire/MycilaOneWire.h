@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// This file does not depend on Arduino: the 1-Wire protocol can be compiled and checked on host against a simulated bus.
+
+namespace Mycila {
+  namespace OneWire {
+    constexpr uint8_t CMD_SEARCH_ROM = 0xF0;
+    constexpr uint8_t CMD_MATCH_ROM = 0x55;
+    constexpr uint8_t CMD_SKIP_ROM = 0xCC;
+
+    /**
+     * @brief Dallas/Maxim CRC-8 (polynomial x^8 + x^5 + x^4 + 1) used by ROM codes and scratchpads
+     */
+    uint8_t crc8(const uint8_t* data, size_t len);
+
+    /**
+     * @brief A 1-Wire bus: the time slots are implemented by the hardware driver, the protocol is implemented on top of them.
+     *
+     * A ROM code is stored with its first byte (family code) in the lowest byte.
+     */
+    class Bus {
+      public:
+        virtual ~Bus() = default;
+
+        /**
+         * @brief Send a reset pulse
+         *
+         * @return true if at least one device answered with a presence pulse
+         */
+        virtual bool reset() = 0;
+        virtual void writeBit(bool bit) = 0;
+        virtual bool readBit() = 0;
+
+        // bytes are sent and received least significant bit first
+        void write(uint8_t byte);
+        void write(const uint8_t* data, size_t len);
+        uint8_t read();
+        void read(uint8_t* data, size_t len);
+
+        /**
+         * @brief Reset the bus and address all the devices (skip ROM)
+         */
+        bool skip();
+
+        /**
+         * @brief Reset the bus and address one device (match ROM)
+         */
+        bool select(uint64_t rom);
+
+        /**
+         * @brief Find the ROM codes of the devices on the bus (Maxim application note 187)
+         *
+         * @return the number of devices found, at most max
+         */
+        size_t search(uint64_t* roms, size_t max);
+    };
+  } // namespace OneWire
+} // namespace Mycila
@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#include <MycilaOneWireGPIO.h>
+
+#include <esp_rom_sys.h>
+
+bool Mycila::OneWire::GPIOBus::begin(int8_t pin) {
+  if (isEnabled())
+    return true;
+
+  if (!GPIO_IS_VALID_OUTPUT_GPIO(pin))
+    return false;
+
+  _pin = static_cast<gpio_num_t>(pin);
+  gpio_reset_pin(_pin);
+  gpio_set_direction(_pin, GPIO_MODE_INPUT_OUTPUT_OD);
+  gpio_set_pull_mode(_pin, GPIO_PULLUP_ONLY);
+  gpio_set_level(_pin, 1);
+  return true;
+}
+
+void Mycila::OneWire::GPIOBus::end() {
+  if (isEnabled()) {
+    gpio_reset_pin(_pin);
+    _pin = GPIO_NUM_NC;
+  }
+}
+
+bool Mycila::OneWire::GPIOBus::reset() {
+  if (!isEnabled())
+    return false;
+
+  // the bus must be released by the devices
+  if (!gpio_get_level(_pin))
+    return false;
+
+  // reset pulse: a longer pulse is harmless, so interrupts are allowed
+  gpio_set_level(_pin, 0);
+  esp_rom_delay_us(480);
+
+  portENTER_CRITICAL(&_mux);
+  gpio_set_level(_pin, 1);
+  esp_rom_delay_us(70);
+  const bool presence = !gpio_get_level(_pin);
+  portEXIT_CRITICAL(&_mux);
+
+  esp_rom_delay_us(410);
+  return presence;
+}
+
+void Mycila::OneWire::GPIOBus::writeBit(bool bit) {
+  portENTER_CRITICAL(&_mux);
+  gpio_set_level(_pin, 0);
+  esp_rom_delay_us(bit ? 6 : 60);
+  gpio_set_level(_pin, 1);
+  portEXIT_CRITICAL(&_mux);
+  esp_rom_delay_us(bit ? 64 : 10);
+}
+
+bool Mycila::OneWire::GPIOBus::readBit() {
+  portENTER_CRITICAL(&_mux);
+  gpio_set_level(_pin, 0);
+  esp_rom_delay_us(6);
+  gpio_set_level(_pin, 1);
+  esp_rom_delay_us(9);
+  const bool bit = gpio_get_level(_pin);
+  portEXIT_CRITICAL(&_mux);
+  esp_rom_delay_us(55);
+  return bit;
+}
@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#pragma once
+
+#include <MycilaOneWire.h>
+
+#include <driver/gpio.h>
+#include <freertos/FreeRTOS.h>
+
+namespace Mycila {
+  namespace OneWire {
+    /**
+     * @brief 1-Wire bus driven by an open-drain GPIO at standard speed (Maxim application note 126).
+     *
+     * Interrupts are only disabled during a time slot (70 µs at most), never for a whole byte or command.
+     */
+    class GPIOBus : public Bus {
+      public:
+        bool begin(int8_t pin);
+        void end();
+
+        bool isEnabled() const { return _pin != GPIO_NUM_NC; }
+        gpio_num_t getPin() const { return _pin; }
+
+        bool reset() override;
+        void writeBit(bool bit) override;
+        bool readBit() override;
+
+      private:
+        gpio_num_t _pin = GPIO_NUM_NC;
+        portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+    };
+  } // namespace OneWire
+} // namespace Mycila
@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#include <MycilaPayload.h>
+
+#include <FastCRC32.h>
+
+#include <charconv>
+#include <cstring>
+#include <initializer_list>
+
+// deepest JSON structure accepted from MQTT: Shelly status objects are flat
+#define MAX_JSON_NESTING 4
+
+static Mycila::StaticArena<MYCILA_PAYLOAD_JSY_ARENA_SIZE> _jsyArena;
+static Mycila::StaticArena<MYCILA_PAYLOAD_MQTT_ARENA_SIZE> _mqttArena;
+
+const Mycila::Arena& Mycila::Payload::jsyArena() { return _jsyArena; }
+const Mycila::Arena& Mycila::Payload::mqttArena() { return _mqttArena; }
+
+static void _readGrid(const JsonObjectConst& src, Mycila::Payload::GridMeasurements& dst) {
+  dst.apparentPower = src["apparent_power"] | NAN;
+  dst.current = src["current"] | NAN;
+  dst.energy = src["active_energy_imported"] | static_cast<uint32_t>(0);
+  dst.energyReturned = src["active_energy_returned"] | static_cast<uint32_t>(0);
+  dst.frequency = src["frequency"] | NAN;
+  dst.power = src["active_power"] | NAN;
+  dst.powerFactor = src["power_factor"] | NAN;
+  dst.voltage = src["voltage"] | NAN;
+}
+
+static void _readOutput(const JsonObjectConst& src, Mycila::Payload::OutputMeasurements& dst) {
+  dst.apparentPower = src["apparent_power"] | NAN;
+  dst.current = src["current"] | NAN;
+  dst.energy = src["active_energy"] | static_cast<uint32_t>(0);
+  dst.power = src["active_power"] | NAN;
+  dst.powerFactor = src["power_factor"] | NAN;
+  dst.resistance = src["resistance"] | NAN;
+  dst.thdi = src["thdi_0"] | NAN;
+  dst.voltage = src["voltage"] | NAN;
+}
+
+bool Mycila::Payload::decodeJsyFrame(const uint8_t* buffer, size_t len, JsyData& data) {
+  if (buffer == nullptr || len < JSY_FRAME_OVERHEAD || buffer[0] != JSY_MSG_TYPE)
+    return false;
+
+  uint32_t size;
+  memcpy(&size, buffer + 1, 4);
+
+  // compared this way so that a forged size cannot overflow
+  if (size != len - JSY_FRAME_OVERHEAD)
+    return false;
+
+  FastCRC32 crc32;
+  crc32.add(buffer, size + 5);
+  uint32_t crc = crc32.calc();
+
+  if (memcmp(&crc, buffer + size + 5, 4) != 0)
+    return false;
+
+  JsonDocument doc(&_jsyArena);
+  if (deserializeMsgPack(doc, buffer + 5, size) != DeserializationError::Ok)
+    return false;
+
+  data = JsyData();
+  data.model = doc["model"] | static_cast<uint16_t>(0);
+
+  // the layout depends on the model: 3-phase models send an aggregate, dual channel models send both channels
+  if (doc["aggregate"].is<JsonObjectConst>()) {
+    _readGrid(doc["aggregate"].as<JsonObjectConst>(), data.grid);
+    data.hasGrid = true;
+
+  } else if (doc["channel2"].is<JsonObjectConst>()) {
+    _readGrid(doc["channel2"].as<JsonObjectConst>(), data.grid);
+    data.hasGrid = true;
+    if (doc["channel1"].is<JsonObjectConst>()) {
+      _readOutput(doc["channel1"].as<JsonObjectConst>(), data.output);
+      data.hasOutput = true;
+    }
+
+  } else if (doc["active_power"].is<float>()) {
+    _readGrid(doc.as<JsonObjectConst>(), data.grid);
+    // single channel models do not send the frequency
+    data.grid.frequency = NAN;
+    data.hasGrid = true;
+  }
+
+  return data.hasGrid;
+}
+
+float Mycila::Payload::parseNumber(std::string_view payload) {
+  float value;
+  if (std::from_chars(payload.data(), payload.data() + payload.size(), value).ec != std::errc{})
+    return NAN;
+  return std::isfinite(value) ? value : NAN;
+}
+
+// parse a plain number or the first key found in a JSON object
+static float _parse(std::string_view payload, std::initializer_list<const char*> keys) {
+  if (payload.empty())
+    return NAN;
+
+  if (payload[0] != '{')
+    return Mycila::Payload::parseNumber(payload);
+
+  // only keep the wanted keys to limit allocations
+  JsonDocument filter(&_mqttArena);
+  for (const char* key : keys)
+    filter[key] = true;
+
+  JsonDocument doc(&_mqttArena);
+  if (deserializeJson(doc, payload.data(), payload.size(), DeserializationOption::Filter(filter), DeserializationOption::NestingLimit(MAX_JSON_NESTING)) != DeserializationError::Ok)
+    return NAN;
+
+  for (const char* key : keys) {
+    if (doc[key].is<float>()) {
+      const float value = doc[key].as<float>();
+      if (std::isfinite(value))
+        return value;
+    }
+  }
+
+  return NAN;
+}
+
+// Shelly EM example: shellyproem50/status/em1:0
+// {"id":1,"current":2.681,"voltage":236.7,"act_power":-607.3,"aprt_power":636.0,"pf":0.95,"freq":50.0,"calibration":"factory"}
+// Shelly 3EM example: shellypowermeter/status/em:0
+// {"id":0,"a_current":0.132,"a_voltage":236.0,"a_act_power":3.9,"a_aprt_power":31.0,"a_pf":-0.53,"b_current":0.594,"b_voltage":236.4,"b_act_power":45.4,"b_aprt_power":140.3,"b_pf":-0.61,"c_current":0.368,"c_voltage":237.8,"c_act_power":54.3,"c_aprt_power":87.5,"c_pf":-0.72,"n_current":null,"total_current":1.094,"total_act_power":103.610,"total_aprt_power":258.799, "user_calibrated_phase":[]}
+
+float Mycila::Payload::parseGridPower(std::string_view payload) {
+  return _parse(payload, {"act_power", "total_act_power"});
+}
+
+float Mycila::Payload::parseGridVoltage(std::string_view payload) {
+  return _parse(payload, {"voltage", "a_voltage", "b_voltage", "c_voltage"});
+}
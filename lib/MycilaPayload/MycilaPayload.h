@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#pragma once
+
+#include <ArduinoJson.h>
+#include <MycilaArena.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// This file only depends on ArduinoJson and the CRC library: the parsers of the measurements received from the network can be compiled and fuzzed on host.
+
+// documents are parsed in fixed arenas (heap is only used if they are too small)
+#ifndef MYCILA_PAYLOAD_JSY_ARENA_SIZE
+  #define MYCILA_PAYLOAD_JSY_ARENA_SIZE 3072
+#endif
+#ifndef MYCILA_PAYLOAD_MQTT_ARENA_SIZE
+  #define MYCILA_PAYLOAD_MQTT_ARENA_SIZE 1024
+#endif
+
+namespace Mycila {
+  namespace Payload {
+    // UDP message type sent by the JSY Remote app
+    constexpr uint8_t JSY_MSG_TYPE = 0x02;
+
+    // message type (1) + MsgPack size (4) + CRC32 (4)
+    constexpr size_t JSY_FRAME_OVERHEAD = 9;
+
+    struct GridMeasurements {
+        float apparentPower = NAN;
+        float current = NAN;
+        uint32_t energy = 0;
+        uint32_t energyReturned = 0;
+        float frequency = NAN;
+        float power = NAN;
+        float powerFactor = NAN;
+        float voltage = NAN;
+    };
+
+    struct OutputMeasurements {
+        float apparentPower = NAN;
+        float current = NAN;
+        uint32_t energy = 0;
+        float power = NAN;
+        float powerFactor = NAN;
+        float resistance = NAN;
+        float thdi = NAN;
+        float voltage = NAN;
+    };
+
+    /**
+     * @brief Measurements sent by a remote JSY
+     */
+    struct JsyData {
+        // JSY model as reported by the device
+        uint16_t model = 0;
+        bool hasGrid = false;
+        GridMeasurements grid;
+        // only set by dual channel models: channel 1 measures the router output
+        bool hasOutput = false;
+        OutputMeasurements output;
+    };
+
+    /**
+     * @brief Decode a UDP frame sent by the JSY Remote app
+     *
+     * The frame is: message type (1 byte), MsgPack size (4 bytes), MsgPack data, CRC32 of all the previous bytes (4 bytes).
+     *
+     * @return false if the frame is truncated, corrupted or does not contain any measurement
+     */
+    bool decodeJsyFrame(const uint8_t* buffer, size_t len, JsyData& data);
+
+    // arena used by decodeJsyFrame(): it must only be called from one task
+    const Arena& jsyArena();
+
+    /**
+     * @brief Parse a number sent as plain text
+     *
+     * @return NAN if the payload does not start with a number or if the number is not finite
+     */
+    float parseNumber(std::string_view payload);
+
+    /**
+     * @brief Parse a grid power sent as plain text or as a Shelly EM / 3EM JSON status
+     *
+     * @return NAN if no power can be found
+     */
+    float parseGridPower(std::string_view payload);
+
+    /**
+     * @brief Parse a grid voltage sent as plain text or as a Shelly EM / 3EM JSON status (first phase having a voltage)
+     *
+     * @return NAN if no voltage can be found
+     */
+    float parseGridVoltage(std::string_view payload);
+
+    // arena used by parseGridPower() and parseGridVoltage(): they must be called from the same task
+    const Arena& mqttArena();
+  } // namespace Payload
+} // namespace Mycila
@@ -4,22 +4,37 @@
  */
 #include <MycilaRouter.h>
 
-#ifdef MYCILA_LOGGER_SUPPORT
-  #include <MycilaLogger.h>
-extern Mycila::Logger logger;
-  #define LOGD(tag, format, ...) logger.debug(tag, format, ##__VA_ARGS__)
-  #define LOGI(tag, format, ...) logger.info(tag, format, ##__VA_ARGS__)
-  #define LOGW(tag, format, ...) logger.warn(tag, format, ##__VA_ARGS__)
-  #define LOGE(tag, format, ...) logger.error(tag, format, ##__VA_ARGS__)
-#else
-  #define LOGD(tag, format, ...) ESP_LOGD(tag, format, ##__VA_ARGS__)
-  #define LOGI(tag, format, ...) ESP_LOGI(tag, format, ##__VA_ARGS__)
-  #define LOGW(tag, format, ...) ESP_LOGW(tag, format, ##__VA_ARGS__)
-  #define LOGE(tag, format, ...) ESP_LOGE(tag, format, ##__VA_ARGS__)
-#endif
+#include <MycilaLogFilter.h>
 
 #define TAG "ROUTER"
 
+void Mycila::Router::setPIDConfig(const PIDConfig& config) {
+  std::lock_guard<std::mutex> lock(_pidConfigMutex);
+  _pidConfig = config;
+  _pidConfigPending = true;
+}
+
+void Mycila::Router::_applyConfig() {
+  {
+    // never wait in the control loop: a configuration being staged is applied at next cycle
+    std::unique_lock<std::mutex> lock(_pidConfigMutex, std::try_to_lock);
+    if (lock.owns_lock() && _pidConfigPending) {
+      _pidController->setProportionalMode(_pidConfig.proportionalMode);
+      _pidController->setDerivativeMode(_pidConfig.derivativeMode);
+      _pidController->setIntegralCorrectionMode(_pidConfig.integralCorrectionMode);
+      _pidController->setSetPoint(_pidConfig.setPoint);
+      _pidController->setTunings(_pidConfig.kp, _pidConfig.ki, _pidConfig.kd);
+      _pidController->setOutputLimits(_pidConfig.outputMin, _pidConfig.outputMax);
+      _pidConfigPending = false;
+      _bumpless = true;
+      MYCILA_LOGI(TAG, "PID Controller reconfigured");
+    }
+  }
+
+  for (const auto& output : _outputs)
+    output->applyConfig();
+}
+
 #ifdef MYCILA_JSON_SUPPORT
 void Mycila::Router::toJson(const JsonObject& root, float voltage) const {
   Metrics* routerMeasurements = new Metrics();
@@ -149,16 +164,16 @@ void Mycila::Router::getRouterMeasurements(Metrics& metrics) const {
 
 void Mycila::Router::beginCalibration(CalibrationCallback cb) {
   if (_calibrationRunning) {
-    LOGW(TAG, "Calibration already running");
+    MYCILA_LOGW(TAG, "Calibration already running");
     return;
   }
 
   if (_outputs.empty()) {
-    LOGW(TAG, "No output to calibrate");
+    MYCILA_LOGW(TAG, "No output to calibrate");
     return;
   }
 
-  LOGI(TAG, "Starting calibration");
+  MYCILA_LOGI(TAG, "Starting calibration");
   _calibrationStep = 1;
   _calibrationOutputIndex = 0;
   _calibrationCallback = cb;
@@ -174,9 +189,9 @@ void Mycila::Router::continueCalibration() {
       for (const auto& output : _outputs) {
         output->config.autoBypass = false;
         output->config.autoDimmer = false;
-        LOGI(TAG, "Disabling %s Auto Bypass", output->getName());
+        MYCILA_LOGI(TAG, "Disabling %s Auto Bypass", output->getName());
         output->applyAutoBypass();
-        LOGI(TAG, "Turing off %s", output->getName());
+        MYCILA_LOGI(TAG, "Turing off %s", output->getName());
         output->setDimmerOff();
         output->setBypassOff();
       }
@@ -185,7 +200,7 @@ void Mycila::Router::continueCalibration() {
       break;
 
     case 2:
-      LOGI(TAG, "Activating %s dimmer at 50%", _outputs[_calibrationOutputIndex]->getName());
+      MYCILA_LOGI(TAG, "Activating %s dimmer at 50%", _outputs[_calibrationOutputIndex]->getName());
       _outputs[_calibrationOutputIndex]->setDimmerDutyCycle(.5);
       _calibrationStartTime = millis();
       _calibrationStep++;
@@ -193,7 +208,7 @@ void Mycila::Router::continueCalibration() {
 
     case 3:
       if (millis() - _calibrationStartTime > 5000) {
-        LOGI(TAG, "Measuring %s resistance", _outputs[_calibrationOutputIndex]->getName());
+        MYCILA_LOGI(TAG, "Measuring %s resistance", _outputs[_calibrationOutputIndex]->getName());
         RouterOutput::Metrics outputMetrics;
         _outputs[_calibrationOutputIndex]->getOutputMeasurements(outputMetrics);
         float resistance = outputMetrics.resistance > 0 ? outputMetrics.resistance : 0; // handles nan
@@ -205,7 +220,7 @@ void Mycila::Router::continueCalibration() {
 
         _outputs[_calibrationOutputIndex]->config.calibratedResistance = resistance;
 
-        LOGI(TAG, "Activating %s dimmer at 100%", _outputs[_calibrationOutputIndex]->getName());
+        MYCILA_LOGI(TAG, "Activating %s dimmer at 100%", _outputs[_calibrationOutputIndex]->getName());
         _outputs[_calibrationOutputIndex]->setDimmerDutyCycle(1);
         _calibrationStartTime = millis();
         _calibrationStep++;
@@ -214,7 +229,7 @@ void Mycila::Router::continueCalibration() {
 
     case 4:
       if (millis() - _calibrationStartTime > 5000) {
-        LOGI(TAG, "Measuring %s resistance", _outputs[_calibrationOutputIndex]->getName());
+        MYCILA_LOGI(TAG, "Measuring %s resistance", _outputs[_calibrationOutputIndex]->getName());
         RouterOutput::Metrics outputMetrics;
         _outputs[_calibrationOutputIndex]->getOutputMeasurements(outputMetrics);
         float resistance = outputMetrics.resistance > 0 ? outputMetrics.resistance : 0; // handles nan
@@ -226,7 +241,7 @@ void Mycila::Router::continueCalibration() {
 
         _outputs[_calibrationOutputIndex]->config.calibratedResistance = (_outputs[_calibrationOutputIndex]->config.calibratedResistance + resistance) / 2;
 
-        LOGI(TAG, "Turning off %s dimmer", _outputs[_calibrationOutputIndex]->getName());
+        MYCILA_LOGI(TAG, "Turning off %s dimmer", _outputs[_calibrationOutputIndex]->getName());
         _outputs[_calibrationOutputIndex]->setDimmerOff();
 
         _calibrationOutputIndex++;
@@ -234,7 +249,7 @@ void Mycila::Router::continueCalibration() {
           _calibrationStep = 2;
         } else {
           _calibrationRunning = false;
-          LOGI(TAG, "Calibration done");
+          MYCILA_LOGI(TAG, "Calibration done");
           if (_calibrationCallback)
             _calibrationCallback();
         }
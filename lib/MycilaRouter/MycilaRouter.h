@@ -8,12 +8,19 @@
 #include <MycilaRouterOutput.h>
 
 #include <algorithm>
+#include <cmath>
+#include <mutex>
 #include <vector>
 
 #ifdef MYCILA_JSON_SUPPORT
   #include <ArduinoJson.h>
 #endif
 
+#ifndef MYCILA_ROUTER_WARM_START_DECAY
+  // fraction of the warm start power kept at each divert() call
+  #define MYCILA_ROUTER_WARM_START_DECAY 0.95f
+#endif
+
 namespace Mycila {
   class Router {
     public:
@@ -28,9 +35,29 @@ namespace Mycila {
           float voltage = NAN;
       } Metrics;
 
+      typedef struct {
+          PID::ProportionalMode proportionalMode;
+          PID::DerivativeMode derivativeMode;
+          PID::IntegralCorrectionMode integralCorrectionMode;
+          float setPoint;
+          float kp;
+          float ki;
+          float kd;
+          float outputMin;
+          float outputMax;
+      } PIDConfig;
+
       explicit Router(PID& pidController) : _pidController(&pidController) {}
 
-      void addOutput(RouterOutput& output) { _outputs.push_back(&output); }
+      // stage a new PID configuration: it is applied at the start of the next control cycle (divert() or noDivert()) with a bumpless transfer
+      void setPIDConfig(const PIDConfig& config);
+
+      // the configuration staged in the output before it is added is applied at once
+      void addOutput(RouterOutput& output) {
+        std::lock_guard<std::mutex> lock(_controlMutex);
+        output.applyConfig();
+        _outputs.push_back(&output);
+      }
       const std::vector<RouterOutput*>& getOutputs() const { return _outputs; }
 
       ExpiringValue<Metrics>& localMetrics() { return _localMetrics; }
@@ -57,15 +84,56 @@ namespace Mycila {
         return false;
       }
 
+      // true if an auto dimmer can still correct the PID error in both directions.
+      // an output off (e.g. at night, nothing to divert) or at its limit cannot: its PID error stays high and is not worth reacting to.
+      bool isRegulating() const {
+        for (const auto& output : _outputs) {
+          if (output->isAutoDimmerEnabled() && output->isDimmerOnline()) {
+            const float dutyCycle = output->getDimmerDutyCycle();
+            if (dutyCycle > 0 && dutyCycle < output->getDimmerDutyCycleLimit())
+              return true;
+          }
+        }
+        return false;
+      }
+
+      // control cycles can be started from several tasks (one per measurement source): they are serialized,
+      // and the staged configurations are only applied at the start of a cycle, never while another one computes
       void divert(float gridVoltage, float gridPower) {
+        std::lock_guard<std::mutex> lock(_controlMutex);
+        _applyConfig();
+        if (!isAutoDimmerEnabled())
+          return;
         float powerToDivert = _pidController->compute(gridPower);
+        if (_bumpless) {
+          // the PID was reconfigured: keep the output continuous and let the offset fade out like the warm start power
+          _bumpless = false;
+          if (!std::isnan(_lastPowerToDivert))
+            _warmStartPower = _lastPowerToDivert - powerToDivert;
+        }
+        if (_warmStartPower != 0) {
+          powerToDivert += _warmStartPower;
+          _warmStartPower *= MYCILA_ROUTER_WARM_START_DECAY;
+          if (std::abs(_warmStartPower) < 1)
+            _warmStartPower = 0;
+        }
+        _lastPowerToDivert = powerToDivert;
         for (const auto& output : _outputs) {
           const float usedPower = output->autoDivert(gridVoltage, powerToDivert);
           powerToDivert = std::max(0.0f, powerToDivert - usedPower);
         }
       }
 
+      // seed the power to divert after a warm restart: it is added to the PID output and fades out while the PID integral catches up,
+      // so that the outputs resume at their previous level instead of ramping from zero.
+      // the same mechanism provides the bumpless transfer when the PID is reconfigured.
+      void setWarmStartPower(float power) { _warmStartPower = power; }
+      float getWarmStartPower() const { return _warmStartPower; }
+
       void noDivert() {
+        std::lock_guard<std::mutex> lock(_controlMutex);
+        _applyConfig();
+        _lastPowerToDivert = NAN;
         for (const auto& output : _outputs) {
           output->autoDivert(0, 0);
         }
@@ -89,10 +157,21 @@ namespace Mycila {
 
     private:
       PID* _pidController;
+      float _warmStartPower = 0;
+      float _lastPowerToDivert = NAN;
+      // serializes the control cycles and the application of the staged configurations
+      std::mutex _controlMutex;
+      std::mutex _pidConfigMutex;
+      bool _pidConfigPending = false;
+      bool _bumpless = false;
+      PIDConfig _pidConfig;
       std::vector<RouterOutput*> _outputs;
       ExpiringValue<Metrics> _localMetrics;
       ExpiringValue<Metrics> _remoteMetrics;
 
+      // apply the staged PID and output configurations, if any. called with _controlMutex held.
+      void _applyConfig();
+
       // calibration
       // 0: idle
       // 1: prepare
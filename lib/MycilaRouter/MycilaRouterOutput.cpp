@@ -4,23 +4,13 @@
  */
 #include <MycilaRouterOutput.h>
 
+#include <MycilaLogFilter.h>
 #include <MycilaTime.h>
 
 #include <string>
 
-#ifdef MYCILA_LOGGER_SUPPORT
-  #include <MycilaLogger.h>
-extern Mycila::Logger logger;
-  #define LOGD(tag, format, ...) logger.debug(tag, format, ##__VA_ARGS__)
-  #define LOGI(tag, format, ...) logger.info(tag, format, ##__VA_ARGS__)
-  #define LOGW(tag, format, ...) logger.warn(tag, format, ##__VA_ARGS__)
-  #define LOGE(tag, format, ...) logger.error(tag, format, ##__VA_ARGS__)
-#else
-  #define LOGD(tag, format, ...) ESP_LOGD(tag, format, ##__VA_ARGS__)
-  #define LOGI(tag, format, ...) ESP_LOGI(tag, format, ##__VA_ARGS__)
-  #define LOGW(tag, format, ...) ESP_LOGW(tag, format, ##__VA_ARGS__)
-  #define LOGE(tag, format, ...) ESP_LOGE(tag, format, ##__VA_ARGS__)
-#endif
+// warnings triggered by repeated user or automation requests
+#define LOGW_LIMITED(tag, format, ...) MYCILA_LOG_RATE_LIMITED(MYCILA_LOGW, MYCILA_LOG_RATE_LIMIT_INTERVAL, tag, format, ##__VA_ARGS__)
 
 #define TAG "OUTPUT"
 
@@ -36,6 +26,38 @@ static const char* DaysOfWeek[] = {"sun", "mon", "tue", "wed", "thu", "fri", "sa
 
 const char* Mycila::RouterOutput::getStateName() const { return StateNames[static_cast<int>(getState())]; }
 
+// configuration
+
+void Mycila::RouterOutput::setConfig(const Config& config, float dutyCycleMin, float dutyCycleMax, float dutyCycleLimit) {
+  std::lock_guard<std::mutex> lock(_configMutex);
+  _pendingConfig = config;
+  _pendingDutyCycleMin = dutyCycleMin;
+  _pendingDutyCycleMax = dutyCycleMax;
+  _pendingDutyCycleLimit = dutyCycleLimit;
+  _configPending = true;
+}
+
+bool Mycila::RouterOutput::applyConfig() {
+  // never wait in the control loop: a configuration being staged is applied at next cycle
+  std::unique_lock<std::mutex> lock(_configMutex, std::try_to_lock);
+  if (!lock.owns_lock() || !_configPending)
+    return false;
+
+  const bool autoDimmerChanged = config.autoDimmer != _pendingConfig.autoDimmer;
+
+  config = _pendingConfig;
+  _dimmer->setDutyCycleRange(_pendingDutyCycleMin, _pendingDutyCycleMax);
+  _dimmer->setDutyCycleLimit(_pendingDutyCycleLimit);
+  _configPending = false;
+
+  // switching between manual and auto mode restarts from 0
+  if (autoDimmerChanged)
+    _dimmer->off();
+
+  MYCILA_LOGD(TAG, "Output '%s' reconfigured", _name);
+  return true;
+}
+
 // output
 
 Mycila::RouterOutput::State Mycila::RouterOutput::getState() const {
@@ -111,24 +133,27 @@ void Mycila::RouterOutput::toJson(const JsonObject& dest, const Metrics& metrics
 
 bool Mycila::RouterOutput::setDimmerDutyCycle(float dutyCycle) {
   if (_autoBypassEnabled) {
-    LOGW(TAG, "Auto Bypass '%s' is activated: unable to change dimmer level", _name);
+    LOGW_LIMITED(TAG, "Auto Bypass '%s' is activated: unable to change dimmer level", _name);
     return false;
   }
 
   if (config.autoDimmer) {
-    LOGW(TAG, "Auto Dimmer '%s' is activated: unable to change dimmer level", _name);
+    LOGW_LIMITED(TAG, "Auto Dimmer '%s' is activated: unable to change dimmer level", _name);
     return false;
   }
 
   if (dutyCycle > 0 && isDimmerTemperatureLimitReached()) {
-    LOGW(TAG, "Dimmer '%s' reached its temperature limit of %.02f °C", _name, config.dimmerTempLimit);
+    LOGW_LIMITED(TAG, "Dimmer '%s' reached its temperature limit of %.02f °C", _name, config.dimmerTempLimit);
     return false;
   }
 
   _setBypass(false);
   _dimmer->setDutyCycle(dutyCycle);
 
-  LOGD(TAG, "Set Dimmer '%s' duty to %f", _name, _dimmer->getDutyCycle());
+  if (_traceLog)
+    _traceLog->debug(TAG, "Set Dimmer '%s' duty to %f", _name, _dimmer->getDutyCycle());
+  else
+    MYCILA_LOGD(TAG, "Set Dimmer '%s' duty to %f", _name, _dimmer->getDutyCycle());
 
   return true;
 }
@@ -144,7 +169,7 @@ void Mycila::RouterOutput::applyTemperatureLimit() {
     return;
 
   if (isDimmerTemperatureLimitReached()) {
-    LOGW(TAG, "Dimmer '%s' reached its temperature limit of %.02f °C", _name, config.dimmerTempLimit);
+    LOGW_LIMITED(TAG, "Dimmer '%s' reached its temperature limit of %.02f °C", _name, config.dimmerTempLimit);
     _dimmer->off();
     return;
   }
@@ -197,7 +222,7 @@ float Mycila::RouterOutput::autoDivert(float gridVoltage, float availablePowerTo
 
 bool Mycila::RouterOutput::setBypass(bool switchOn) {
   if (_autoBypassEnabled && !switchOn) {
-    LOGW(TAG, "Auto Bypass '%s' is activated: unable to turn of bypass relay", _name);
+    LOGW_LIMITED(TAG, "Auto Bypass '%s' is activated: unable to turn of bypass relay", _name);
     return false;
   }
   _setBypass(switchOn);
@@ -206,13 +231,13 @@ bool Mycila::RouterOutput::setBypass(bool switchOn) {
 
 void Mycila::RouterOutput::applyAutoBypass() {
   if (isAutoBypassEnabled() && !_autoBypassEnabled && isBypassOn()) {
-    LOGI(TAG, "Auto Bypass enabled: turning off manual bypass on output '%s'", _name);
+    MYCILA_LOGI(TAG, "Auto Bypass enabled: turning off manual bypass on output '%s'", _name);
     _setBypass(false);
   }
 
   if (!isAutoBypassEnabled()) {
     if (_autoBypassEnabled) {
-      LOGW(TAG, "Auto Bypass disabled: stopping Auto Bypass '%s'", _name);
+      MYCILA_LOGW(TAG, "Auto Bypass disabled: stopping Auto Bypass '%s'", _name);
       _autoBypassEnabled = false;
       _setBypass(false);
     }
@@ -224,7 +249,7 @@ void Mycila::RouterOutput::applyAutoBypass() {
   struct tm timeInfo;
   if (!getLocalTime(&timeInfo, 5)) {
     if (_autoBypassEnabled) {
-      LOGW(TAG, "Unable to get time: stopping Auto Bypass '%s'", _name);
+      MYCILA_LOGW(TAG, "Unable to get time: stopping Auto Bypass '%s'", _name);
       _autoBypassEnabled = false;
       _setBypass(false);
     }
@@ -236,7 +261,7 @@ void Mycila::RouterOutput::applyAutoBypass() {
   if (!_temperature.neverUpdated()) {
     if (!_temperature.isPresent()) {
       if (_autoBypassEnabled) {
-        LOGW(TAG, "Invalid temperature sensor value: stopping Auto Bypass '%s'", _name);
+        MYCILA_LOGW(TAG, "Invalid temperature sensor value: stopping Auto Bypass '%s'", _name);
         _autoBypassEnabled = false;
         _setBypass(false);
       }
@@ -247,7 +272,7 @@ void Mycila::RouterOutput::applyAutoBypass() {
 
     if (temp >= config.autoStopTemperature) {
       if (_autoBypassEnabled) {
-        LOGI(TAG, "Temperature reached %.02f °C: stopping Auto Bypass '%s'", temp, _name);
+        MYCILA_LOGI(TAG, "Temperature reached %.02f °C: stopping Auto Bypass '%s'", temp, _name);
         _autoBypassEnabled = false;
         _setBypass(false);
       }
@@ -263,7 +288,7 @@ void Mycila::RouterOutput::applyAutoBypass() {
   const int inRange = Time::timeInRange(timeInfo, config.autoStartTime.c_str(), config.autoStopTime.c_str());
   if (inRange == -1) {
     if (_autoBypassEnabled) {
-      LOGW(TAG, "Time range %s to %s is invalid: stopping Auto Bypass '%s'", config.autoStartTime.c_str(), config.autoStopTime.c_str(), _name);
+      MYCILA_LOGW(TAG, "Time range %s to %s is invalid: stopping Auto Bypass '%s'", config.autoStartTime.c_str(), config.autoStopTime.c_str(), _name);
       _autoBypassEnabled = false;
       _setBypass(false);
     }
@@ -272,7 +297,7 @@ void Mycila::RouterOutput::applyAutoBypass() {
 
   if (!inRange) {
     if (_autoBypassEnabled) {
-      LOGI(TAG, "Time reached %s: stopping Auto Bypass '%s'", config.autoStopTime.c_str(), _name);
+      MYCILA_LOGI(TAG, "Time reached %s: stopping Auto Bypass '%s'", config.autoStopTime.c_str(), _name);
       _autoBypassEnabled = false;
       _setBypass(false);
     }
@@ -284,7 +309,7 @@ void Mycila::RouterOutput::applyAutoBypass() {
     // auto bypass is not enabled, let's start it
     const char* wday = DaysOfWeek[timeInfo.tm_wday];
     if (config.weekDays.find(wday) != std::string::npos) {
-      LOGI(TAG, "Time within %s-%s on %s: starting Auto Bypass '%s' at %.02f °C", config.autoStartTime.c_str(), config.autoStopTime.c_str(), wday, _name, _temperature.orElse(0));
+      MYCILA_LOGI(TAG, "Time within %s-%s on %s: starting Auto Bypass '%s' at %.02f °C", config.autoStartTime.c_str(), config.autoStopTime.c_str(), wday, _name, _temperature.orElse(0));
       _setBypass(true);
       _autoBypassEnabled = _bypassEnabled;
     }
@@ -302,7 +327,7 @@ void Mycila::RouterOutput::applyAutoBypass() {
     return;
 
   // start bypass
-  LOGI(TAG, "Auto Bypass '%s' is activated: restarting Relay", _name);
+  MYCILA_LOGI(TAG, "Auto Bypass '%s' is activated: restarting Relay", _name);
   _setBypass(true);
 }
 
@@ -350,7 +375,7 @@ void Mycila::RouterOutput::_setBypass(bool state, bool log) {
       _dimmer->off();
       if (!isBypassRelayOn()) {
         if (log)
-          LOGD(TAG, "Turning Bypass Relay '%s' ON", _name);
+          MYCILA_LOGD(TAG, "Turning Bypass Relay '%s' ON", _name);
         _relay->setState(true);
       }
       _bypassEnabled = true;
@@ -358,7 +383,7 @@ void Mycila::RouterOutput::_setBypass(bool state, bool log) {
     } else {
       // we don't have a relay: use the dimmer
       if (log)
-        LOGD(TAG, "Turning Dimmer '%s' ON", _name);
+        MYCILA_LOGD(TAG, "Turning Dimmer '%s' ON", _name);
       _dimmer->on();
       _bypassEnabled = true;
     }
@@ -367,12 +392,12 @@ void Mycila::RouterOutput::_setBypass(bool state, bool log) {
     if (isBypassRelayEnabled()) {
       if (isBypassRelayOn()) {
         if (log)
-          LOGD(TAG, "Turning Bypass Relay '%s' OFF", _name);
+          MYCILA_LOGD(TAG, "Turning Bypass Relay '%s' OFF", _name);
         _relay->setState(false);
       }
     } else {
       if (log)
-        LOGD(TAG, "Turning Dimmer '%s' OFF", _name);
+        MYCILA_LOGD(TAG, "Turning Dimmer '%s' OFF", _name);
       _dimmer->off();
     }
     _bypassEnabled = false;
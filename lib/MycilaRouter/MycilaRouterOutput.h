@@ -7,11 +7,13 @@
 #include <MycilaDimmer.h>
 #include <MycilaExpiringValue.h>
 #include <MycilaRelay.h>
+#include <MycilaTraceLog.h>
 
 #ifdef MYCILA_JSON_SUPPORT
   #include <ArduinoJson.h>
 #endif
 
+#include <mutex>
 #include <string>
 
 namespace Mycila {
@@ -57,6 +59,18 @@ namespace Mycila {
 
       RouterOutput(const char* name, Dimmer& dimmer, Relay* relay) : _name(name), _dimmer(&dimmer), _relay(relay) {}
 
+      // configuration
+
+      // stage a new configuration and dimmer remapping: they are applied together by applyConfig()
+      void setConfig(const Config& config, float dutyCycleMin, float dutyCycleMax, float dutyCycleLimit);
+
+      // apply the staged configuration, if any. called by the router at the start of a control cycle, never during one.
+      // returns true if a configuration was applied.
+      bool applyConfig();
+
+      // hot path debug logs (dimmer level changes) go to this trace log when set, to the logger otherwise
+      void setTraceLog(TraceLog* traceLog) { _traceLog = traceLog; }
+
       // output
 
       State getState() const;
@@ -131,11 +145,19 @@ namespace Mycila {
       const char* _name;
       Dimmer* _dimmer;
       Relay* _relay = nullptr; // optional
+      TraceLog* _traceLog = nullptr;
       bool _autoBypassEnabled = false;
       bool _bypassEnabled = false;
       ExpiringValue<float> _temperature;
       ExpiringValue<Metrics> _localMetrics;
 
+      std::mutex _configMutex;
+      bool _configPending = false;
+      Config _pendingConfig;
+      float _pendingDutyCycleMin = 0;
+      float _pendingDutyCycleMax = 1;
+      float _pendingDutyCycleLimit = 1;
+
     private:
       void _setBypass(bool state, bool log = true);
   };
@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#include <MycilaTaskBudget.h>
+
+#include <algorithm>
+
+Mycila::TaskBudget::TaskBudget(const char* name, uint32_t budget, uint32_t deadline) : _name(name), _budget(budget), _deadline(deadline) {
+  _all().push_back(this);
+}
+
+Mycila::TaskBudget::~TaskBudget() {
+  std::vector<TaskBudget*>& budgets = _all();
+  budgets.erase(std::remove(budgets.begin(), budgets.end(), this), budgets.end());
+}
+
+void Mycila::TaskBudget::record(uint32_t elapsed) {
+  _runs++;
+  _last = elapsed;
+  if (elapsed > _wcet)
+    _wcet = elapsed;
+  if (elapsed > _budget)
+    _overruns++;
+
+  // bucket index is the number of bits of the duration in ms
+  uint32_t ms = elapsed / 1000;
+  size_t bucket = 0;
+  while (ms && bucket < BUCKETS - 1) {
+    ms >>= 1;
+    bucket++;
+  }
+  _histogram[bucket]++;
+}
+
+void Mycila::TaskBudget::reset() {
+  _lastStart = 0;
+  _runs = 0;
+  _overruns = 0;
+  _deadlineMisses = 0;
+  _wcet = 0;
+  _last = 0;
+  _histogram.fill(0);
+}
+
+void Mycila::TaskBudget::_checkDeadline(uint32_t now) {
+  if (_deadline && _lastStart && now - _lastStart > _deadline)
+    _deadlineMisses++;
+  _lastStart = now;
+}
+
+std::vector<Mycila::TaskBudget*>& Mycila::TaskBudget::_all() {
+  // function static to not depend on the initialization order of the static budgets
+  static std::vector<TaskBudget*> budgets;
+  return budgets;
+}
+
+#ifdef MYCILA_JSON_SUPPORT
+void Mycila::TaskBudget::toJson(const JsonObject& root) const {
+  root["budget"] = _budget;
+  if (_deadline)
+    root["deadline"] = _deadline;
+  root["runs"] = _runs;
+  root["overruns"] = _overruns;
+  if (_deadline)
+    root["deadline_misses"] = _deadlineMisses;
+  root["last"] = _last;
+  root["wcet"] = _wcet;
+  JsonArray histogram = root["histogram"].to<JsonArray>();
+  for (uint32_t count : _histogram)
+    histogram.add(count);
+}
+#endif
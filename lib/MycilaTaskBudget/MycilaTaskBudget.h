@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#ifdef MYCILA_JSON_SUPPORT
+  #include <ArduinoJson.h>
+#endif
+
+namespace Mycila {
+  /**
+   * @brief Execution time accounting of a periodic task against a CPU budget and a deadline.
+   *
+   * - budget: maximum expected execution time of one run, in microseconds
+   * - deadline: maximum expected time between the start of two consecutive runs, in milliseconds (0 to disable)
+   *
+   * Execution times are kept in a histogram with power of 2 millisecond buckets: <1 ms, <2 ms, <4 ms, ... and >= 512 ms.
+   * All the created budgets are registered so that they can be reported together.
+   */
+  class TaskBudget {
+    public:
+      static constexpr size_t BUCKETS = 11;
+
+      TaskBudget(const char* name, uint32_t budget, uint32_t deadline = 0);
+      ~TaskBudget();
+
+      const char* name() const { return _name; }
+
+      // run the function and account its execution time
+      template <typename F>
+      void run(F&& fn) {
+        const uint32_t start = micros();
+        _checkDeadline(millis());
+        fn();
+        record(micros() - start);
+      }
+
+      // account an execution time measured elsewhere, in microseconds
+      void record(uint32_t elapsed);
+
+      uint32_t getRuns() const { return _runs; }
+      uint32_t getOverruns() const { return _overruns; }
+      uint32_t getDeadlineMisses() const { return _deadlineMisses; }
+      // worst case execution time in microseconds
+      uint32_t getWCET() const { return _wcet; }
+
+      void reset();
+
+      static const std::vector<TaskBudget*>& all() { return _all(); }
+
+#ifdef MYCILA_JSON_SUPPORT
+      void toJson(const JsonObject& root) const;
+      static void allToJson(const JsonObject& root) {
+        for (const TaskBudget* budget : all())
+          budget->toJson(root[budget->name()].to<JsonObject>());
+      }
+#endif
+
+    private:
+      const char* _name;
+      uint32_t _budget;
+      uint32_t _deadline;
+      uint32_t _lastStart = 0;
+      uint32_t _runs = 0;
+      uint32_t _overruns = 0;
+      uint32_t _deadlineMisses = 0;
+      uint32_t _wcet = 0;
+      uint32_t _last = 0;
+      std::array<uint32_t, BUCKETS> _histogram = {};
+
+      void _checkDeadline(uint32_t now);
+      static std::vector<TaskBudget*>& _all();
+  };
+} // namespace Mycila
@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace Mycila {
+  /**
+   * @brief Multi-resolution time series in fixed memory.
+   *
+   * Level 0 keeps the last samples as they are added.
+   * Each next level keeps the average of a fixed number of samples of the previous level.
+   * For example, with levels of 60, 360, 240 and 672 points and factors of 10, 6 and 15, a sample added each second
+   * is kept 1 min at 1 s, 1 h at 10 s, 4 h at 1 min and 7 days at 15 min.
+   *
+   * - each level is a ring buffer: adding a sample costs one write per completed level and nothing is ever shifted
+   * - downsample() reduces the last points of a level with the Largest-Triangle-Three-Buckets algorithm,
+   *   which keeps the peaks and the shape of the curve
+   */
+  template <typename T, size_t... Capacities>
+  class TimeSeries {
+    public:
+      static constexpr size_t LEVELS = sizeof...(Capacities);
+      static_assert(LEVELS >= 2, "a time series needs at least 2 levels");
+
+      // factors[i] is the number of samples of level i averaged into one sample of level i + 1
+      explicit TimeSeries(const uint16_t (&factors)[LEVELS - 1]) {
+        size_t offset = 0;
+        for (size_t level = 0; level < LEVELS; level++) {
+          _offsets[level] = offset;
+          offset += _capacities[level];
+          _factors[level] = level ? std::max<uint16_t>(factors[level - 1], 1) : 1;
+          _periods[level] = level ? _periods[level - 1] * _factors[level] : 1;
+        }
+      }
+
+      void add(T value) {
+        float average = value;
+        for (size_t level = 0; level < LEVELS; level++) {
+          if (level) {
+            _sums[level] += average;
+            if (++_counts[level] < _factors[level])
+              return;
+            average = _sums[level] / _counts[level];
+            _sums[level] = 0;
+            _counts[level] = 0;
+          }
+          _values[_offsets[level] + _heads[level]] = _round(average);
+          _heads[level] = (_heads[level] + 1) % _capacities[level];
+          if (_sizes[level] < _capacities[level])
+            _sizes[level]++;
+        }
+      }
+
+      void clear() {
+        for (size_t level = 0; level < LEVELS; level++) {
+          _heads[level] = 0;
+          _sizes[level] = 0;
+          _sums[level] = 0;
+          _counts[level] = 0;
+        }
+      }
+
+      size_t capacity(size_t level) const { return _capacities[level]; }
+      size_t size(size_t level) const { return _sizes[level]; }
+      // number of samples added for one point of this level
+      uint32_t period(size_t level) const { return _periods[level]; }
+
+      // point of a level, oldest first
+      T get(size_t level, size_t index) const {
+        const size_t capacity = _capacities[level];
+        return _values[_offsets[level] + (_heads[level] + capacity - _sizes[level] + index) % capacity];
+      }
+
+      // reduces the last count points of a level to at most threshold points, oldest first.
+      // x receives the age of each point in samples (negative: -period for the last point).
+      // returns the number of points written.
+      template <typename X>
+      size_t downsample(size_t level, size_t count, size_t threshold, X* x, T* y) const {
+        const size_t n = std::min(count, _sizes[level]);
+        const size_t first = _sizes[level] - n;
+        const int32_t period = _periods[level];
+
+        if (n <= threshold || threshold < 3) {
+          const size_t m = std::min(n, threshold);
+          for (size_t i = n - m; i < n; i++) {
+            x[i - n + m] = static_cast<X>(-static_cast<int32_t>(n - i) * period);
+            y[i - n + m] = get(level, first + i);
+          }
+          return m;
+        }
+
+        // Largest-Triangle-Three-Buckets: the first and last points are kept and the points in between are split in threshold - 2 buckets.
+        // In each bucket, the selected point is the one forming the largest triangle with the previously selected point and the average of the next bucket.
+        const float every = static_cast<float>(n - 2) / (threshold - 2);
+        size_t selected = 0;
+        size_t written = 0;
+
+        x[written] = static_cast<X>(-static_cast<int32_t>(n) * period);
+        y[written++] = get(level, first);
+
+        for (size_t bucket = 0; bucket < threshold - 2; bucket++) {
+          const size_t nextStart = static_cast<size_t>((bucket + 1) * every) + 1;
+          const size_t nextEnd = std::min(static_cast<size_t>((bucket + 2) * every) + 1, n);
+          float averageX = 0;
+          float averageY = 0;
+          for (size_t i = nextStart; i < nextEnd; i++) {
+            averageX += i;
+            averageY += get(level, first + i);
+          }
+          averageX /= nextEnd - nextStart;
+          averageY /= nextEnd - nextStart;
+
+          const size_t start = static_cast<size_t>(bucket * every) + 1;
+          const size_t end = std::min(static_cast<size_t>((bucket + 1) * every) + 1, n - 1);
+          const float selectedX = selected;
+          const float selectedY = get(level, first + selected);
+          float maxArea = -1;
+          for (size_t i = start; i < end; i++) {
+            const float area = std::fabs((selectedX - averageX) * (get(level, first + i) - selectedY) - (selectedX - i) * (averageY - selectedY));
+            if (area > maxArea) {
+              maxArea = area;
+              selected = i;
+            }
+          }
+
+          x[written] = static_cast<X>(-static_cast<int32_t>(n - selected) * period);
+          y[written++] = get(level, first + selected);
+        }
+
+        x[written] = static_cast<X>(-period);
+        y[written++] = get(level, first + n - 1);
+        return written;
+      }
+
+    private:
+      static constexpr size_t _capacities[LEVELS] = {Capacities...};
+
+      T _values[(Capacities + ...)] = {};
+      size_t _offsets[LEVELS] = {};
+      uint16_t _factors[LEVELS] = {};
+      uint32_t _periods[LEVELS] = {};
+      size_t _heads[LEVELS] = {};
+      size_t _sizes[LEVELS] = {};
+      float _sums[LEVELS] = {};
+      uint16_t _counts[LEVELS] = {};
+
+      static T _round(float value) {
+        if constexpr (std::is_integral_v<T>)
+          return static_cast<T>(std::round(value));
+        else
+          return static_cast<T>(value);
+      }
+  };
+} // namespace Mycila
@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#include <MycilaTraceLog.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+static_assert((MYCILA_TRACE_LOG_SIZE & (MYCILA_TRACE_LOG_SIZE - 1)) == 0, "MYCILA_TRACE_LOG_SIZE must be a power of 2");
+
+Mycila::TraceLog::TraceLog() {
+  for (size_t i = 0; i < MYCILA_TRACE_LOG_SIZE; i++)
+    _records[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+// bounded multi-producer queue: each slot sequence tells whether it is free for the writer at a given position
+Mycila::TraceLog::Record* Mycila::TraceLog::_reserve() {
+  uint32_t pos = _enqueue.load(std::memory_order_relaxed);
+  for (;;) {
+    Record* record = &_records[pos & (MYCILA_TRACE_LOG_SIZE - 1)];
+    const int32_t diff = static_cast<int32_t>(record->sequence.load(std::memory_order_acquire) - pos);
+    if (diff == 0) {
+      if (_enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        return record;
+    } else if (diff < 0) {
+      // the slot still holds a record from the previous lap: buffer is full
+      _dropped.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    } else {
+      pos = _enqueue.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+void Mycila::TraceLog::_publish(Record* record) {
+  const uint32_t pos = record->sequence.load(std::memory_order_relaxed);
+  record->sequence.store(pos + 1, std::memory_order_release);
+}
+
+Mycila::TraceLog::Record* Mycila::TraceLog::_peek() {
+  Record* record = &_records[_dequeue & (MYCILA_TRACE_LOG_SIZE - 1)];
+  return record->sequence.load(std::memory_order_acquire) == _dequeue + 1 ? record : nullptr;
+}
+
+void Mycila::TraceLog::_release() {
+  Record* record = &_records[_dequeue & (MYCILA_TRACE_LOG_SIZE - 1)];
+  record->sequence.store(_dequeue + MYCILA_TRACE_LOG_SIZE, std::memory_order_release);
+  _dequeue++;
+}
+
+// Formats one conversion at a time with snprintf: the stored arguments are converted to the type expected by the conversion.
+// Length modifiers are dropped since all the integers are stored on 32 bits. '*' widths are not supported.
+void Mycila::TraceLog::_format(const Record* record, char* buffer, size_t size) {
+  size_t len = 0;
+  size_t next = 0;
+  const char* p = record->format;
+
+  while (*p && len < size - 1) {
+    if (*p != '%') {
+      buffer[len++] = *p++;
+      continue;
+    }
+
+    if (p[1] == '%') {
+      buffer[len++] = '%';
+      p += 2;
+      continue;
+    }
+
+    // copy flags, width and precision, skip length modifiers
+    char spec[16];
+    size_t s = 0;
+    spec[s++] = *p++;
+    while (*p && strchr("-+ #0123456789.", *p) && s < sizeof(spec) - 2)
+      spec[s++] = *p++;
+    while (*p && strchr("hljztL", *p))
+      p++;
+    if (!*p)
+      break;
+    const char conversion = *p++;
+    spec[s++] = conversion;
+    spec[s] = '\0';
+
+    int n;
+    if (next >= record->count) {
+      n = snprintf(buffer + len, size - len, "?");
+    } else {
+      const Kind kind = static_cast<Kind>((record->kinds >> (2 * next)) & 0x03);
+      const Arg arg = record->args[next++];
+      if (strchr("fFeEgGaA", conversion)) {
+        const double value = kind == Kind::FLOAT ? arg.f : kind == Kind::INT ? arg.i
+                                                         : kind == Kind::UINT ? arg.u
+                                                                              : NAN;
+        n = snprintf(buffer + len, size - len, spec, value);
+      } else if (conversion == 's') {
+        n = snprintf(buffer + len, size - len, spec, kind == Kind::STRING && arg.s ? arg.s : "?");
+      } else if (conversion == 'p') {
+        n = snprintf(buffer + len, size - len, spec, reinterpret_cast<const void*>(arg.u));
+      } else if (strchr("di", conversion)) {
+        n = snprintf(buffer + len, size - len, spec, kind == Kind::FLOAT ? static_cast<int>(arg.f) : static_cast<int>(arg.i));
+      } else {
+        n = snprintf(buffer + len, size - len, spec, kind == Kind::FLOAT ? static_cast<unsigned>(arg.f) : static_cast<unsigned>(arg.u));
+      }
+    }
+
+    if (n < 0)
+      break;
+    len += static_cast<size_t>(n);
+    if (len >= size)
+      len = size - 1;
+  }
+
+  buffer[len] = '\0';
+}
@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+#ifndef MYCILA_TRACE_LOG_SIZE
+  #define MYCILA_TRACE_LOG_SIZE 64 // records, must be a power of 2
+#endif
+
+#ifndef MYCILA_TRACE_LOG_MESSAGE_SIZE
+  #define MYCILA_TRACE_LOG_MESSAGE_SIZE 128
+#endif
+
+namespace Mycila {
+  /**
+   * @brief Deferred-format log for hot paths.
+   *
+   * The call site only stores the format string pointer and the raw arguments in a lock-free ring buffer:
+   * vsnprintf and the log sinks run later, when a background task drains the records.
+   *
+   * - up to 4 arguments: integers (stored on 32 bits), floating points (stored as float), booleans and strings
+   * - the format string, the tag and the string arguments are stored as pointers: they must outlive the record (literals, static names)
+   * - the buffer can be filled by several tasks and drained by one task
+   * - records are dropped (and counted) when the buffer is full
+   */
+  class TraceLog {
+    public:
+      static constexpr size_t MAX_ARGS = 4;
+
+      TraceLog();
+
+      void setEnabled(bool enabled) { _enabled = enabled; }
+      bool isEnabled() const { return _enabled; }
+
+      template <typename... Args>
+      void debug(const char* tag, const char* format, Args... args) {
+        static_assert(sizeof...(Args) <= MAX_ARGS, "too many trace log arguments");
+        if (!_enabled)
+          return;
+        Record* record = _reserve();
+        if (!record)
+          return;
+        record->time = millis();
+        record->tag = tag;
+        record->format = format;
+        record->count = 0;
+        record->kinds = 0;
+        (_encode(record, args), ...);
+        _publish(record);
+      }
+
+      // formats the pending records and passes them to the function, oldest first. returns the number of records drained.
+      // only one task must drain.
+      template <typename F>
+      size_t drain(F&& fn, size_t max = MYCILA_TRACE_LOG_SIZE) {
+        char message[MYCILA_TRACE_LOG_MESSAGE_SIZE];
+        size_t count = 0;
+        while (count < max) {
+          Record* record = _peek();
+          if (!record)
+            break;
+          const uint32_t time = record->time;
+          const char* tag = record->tag;
+          _format(record, message, sizeof(message));
+          _release();
+          fn(time, tag, static_cast<const char*>(message));
+          count++;
+        }
+        return count;
+      }
+
+      // number of records dropped because the buffer was full
+      uint32_t getDropped() const { return _dropped.load(std::memory_order_relaxed); }
+
+    private:
+      enum class Kind : uint8_t {
+        INT = 0,
+        UINT = 1,
+        FLOAT = 2,
+        STRING = 3,
+      };
+
+      typedef union {
+          int32_t i;
+          uint32_t u;
+          float f;
+          const char* s;
+      } Arg;
+
+      typedef struct {
+          std::atomic<uint32_t> sequence;
+          uint32_t time;
+          const char* tag;
+          const char* format;
+          uint8_t count;
+          uint8_t kinds; // 2 bits per argument
+          Arg args[MAX_ARGS];
+      } Record;
+
+      Record _records[MYCILA_TRACE_LOG_SIZE];
+      std::atomic<uint32_t> _enqueue{0};
+      uint32_t _dequeue = 0;
+      std::atomic<uint32_t> _dropped{0};
+      volatile bool _enabled = false;
+
+      Record* _reserve();
+      void _publish(Record* record);
+      Record* _peek();
+      void _release();
+      static void _format(const Record* record, char* buffer, size_t size);
+
+      static void _set(Record* record, Kind kind, Arg arg) {
+        record->kinds |= static_cast<uint8_t>(kind) << (2 * record->count);
+        record->args[record->count++] = arg;
+      }
+
+      template <typename T>
+      static void _encode(Record* record, T value) {
+        Arg arg;
+        if constexpr (std::is_floating_point_v<T>) {
+          arg.f = static_cast<float>(value);
+          _set(record, Kind::FLOAT, arg);
+        } else if constexpr (std::is_convertible_v<T, const char*>) {
+          arg.s = value;
+          _set(record, Kind::STRING, arg);
+        } else if constexpr (std::is_signed_v<T>) {
+          arg.i = static_cast<int32_t>(value);
+          _set(record, Kind::INT, arg);
+        } else {
+          arg.u = static_cast<uint32_t>(value);
+          _set(record, Kind::UINT, arg);
+        }
+      }
+  };
+} // namespace Mycila
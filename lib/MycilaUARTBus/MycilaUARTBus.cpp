@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#include <MycilaUARTBus.h>
+
+#include <Arduino.h>
+
+#include <MycilaLogFilter.h>
+
+#define TAG "UART_BUS"
+
+// weight of the last RTT in the RTT moving average
+#define RTT_EMA_ALPHA 0.1f
+
+size_t Mycila::UARTBus::addDevice(const char* name, ReadCallback read, uint32_t interval) {
+  MYCILA_LOGI(TAG, "Add device %s to bus %s with interval %" PRIu32 " ms", name, _name, interval);
+  _devices.push_back({
+    .name = name,
+    .read = read,
+    .interval = interval,
+    .lastPoll = 0,
+    .reads = 0,
+    .timeouts = 0,
+    .lastRTT = 0,
+    .maxRTT = 0,
+    .avgRTT = 0,
+  });
+  return _devices.size() - 1;
+}
+
+void Mycila::UARTBus::setInterval(size_t device, uint32_t interval) {
+  if (device < _devices.size())
+    _devices[device].interval = interval;
+}
+
+bool Mycila::UARTBus::poll() {
+  const uint32_t now = millis();
+
+  // find the most overdue device: devices registered first win ties
+  Device* next = nullptr;
+  int32_t maxOverdue = -1;
+  for (Device& device : _devices) {
+    const int32_t overdue = device.lastPoll ? static_cast<int32_t>(now - device.lastPoll - device.interval) : INT32_MAX;
+    if (overdue > maxOverdue) {
+      maxOverdue = overdue;
+      next = &device;
+    }
+  }
+
+  if (next == nullptr)
+    return false;
+
+  const uint32_t start = micros();
+  const bool success = next->read();
+  const uint32_t rtt = micros() - start;
+
+  next->lastPoll = millis();
+  _polls++;
+
+  if (success) {
+    next->reads++;
+    next->lastRTT = rtt;
+    if (rtt > next->maxRTT)
+      next->maxRTT = rtt;
+    next->avgRTT = next->reads == 1 ? rtt : next->avgRTT + RTT_EMA_ALPHA * (rtt - next->avgRTT);
+  } else {
+    next->timeouts++;
+    MYCILA_LOGD(TAG, "%s: %s read failed after %" PRIu32 " us", _name, next->name, rtt);
+  }
+
+  return true;
+}
+
+float Mycila::UARTBus::getTimeoutRate(size_t device) const {
+  const uint32_t total = _devices[device].reads + _devices[device].timeouts;
+  return total ? static_cast<float>(_devices[device].timeouts) / total : 0;
+}
@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#pragma once
+
+#ifdef MYCILA_JSON_SUPPORT
+  #include <ArduinoJson.h>
+#endif
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Mycila {
+  /**
+   * @brief Schedules Modbus-RTU transactions of several devices sharing the same UART.
+   *
+   * Each call to poll() runs at most one transaction, so that a slow or missing device never holds the bus for the others.
+   * Devices are registered by priority: the first one registered wins when several devices are equally overdue.
+   * Each device has a minimum interval between 2 polls so that less important devices (e.g. output meters) can be polled less often than the grid meter.
+   */
+  class UARTBus {
+    public:
+      /**
+       * @brief Performs a blocking read of the device and returns true if a valid response was received
+       */
+      typedef std::function<bool()> ReadCallback;
+
+      struct Device {
+          const char* name;
+          ReadCallback read;
+          uint32_t interval;
+          uint32_t lastPoll;
+          uint32_t reads;
+          uint32_t timeouts;
+          uint32_t lastRTT;
+          uint32_t maxRTT;
+          float avgRTT;
+      };
+
+      explicit UARTBus(const char* name) : _name(name) {}
+
+      const char* name() const { return _name; }
+
+      /**
+       * @brief Register a device on the bus.
+       *
+       * @param name: the device name, used in JSON output
+       * @param read: the blocking read function of the device
+       * @param interval: the minimum interval in ms between 2 polls of this device (0 to poll as often as possible)
+       * @return the device index to use with setInterval()
+       */
+      size_t addDevice(const char* name, ReadCallback read, uint32_t interval = 0);
+
+      /**
+       * @brief Change the minimum interval in ms between 2 polls of a device
+       */
+      void setInterval(size_t device, uint32_t interval);
+
+      /**
+       * @brief Poll the most overdue device, if any.
+       *
+       * @return true if a transaction was made on the bus
+       */
+      bool poll();
+
+      size_t getDeviceCount() const { return _devices.size(); }
+      const Device& getDevice(size_t device) const { return _devices[device]; }
+
+      /**
+       * @brief Get the timeout rate of a device in the range [0.0, 1.0]
+       */
+      float getTimeoutRate(size_t device) const;
+
+#ifdef MYCILA_JSON_SUPPORT
+      void toJson(const JsonObject& root) const {
+        root["polls"] = _polls;
+        for (size_t i = 0; i < _devices.size(); i++) {
+          const Device& device = _devices[i];
+          JsonObject json = root[device.name].to<JsonObject>();
+          json["interval"] = device.interval;
+          json["reads"] = device.reads;
+          json["timeouts"] = device.timeouts;
+          json["timeout_rate"] = getTimeoutRate(i);
+          json["rtt_last"] = device.lastRTT;
+          json["rtt_avg"] = device.avgRTT;
+          json["rtt_max"] = device.maxRTT;
+        }
+      }
+#endif
+
+    private:
+      const char* _name;
+      std::vector<Device> _devices;
+      uint32_t _polls = 0;
+  };
+} // namespace Mycila
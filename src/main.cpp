@@ -8,48 +8,48 @@ void setup() {
   yasolr_init_logging(); // init logging
 
   logger.info(TAG, "Booting %s", Mycila::AppInfo.nameModelVersion.c_str());
-  yasolr_init_system();       // init system (safeboot, restart, reset, etc)
-  yasolr_init_config();       // load configuration from NVS
-  yasolr_configure_logging(); // configure logging
+  yasolr_boot_step("system", yasolr_init_system);       // init system (safeboot, restart, reset, etc)
+  yasolr_boot_step("config", yasolr_init_config);       // load configuration from NVS
+  yasolr_boot_step("logging", yasolr_configure_logging); // configure logging
 
   logger.info(TAG, "Starting %s", Mycila::AppInfo.nameModelVersion.c_str());
-  yasolr_init_lights();
-  yasolr_init_trial();
-  // measurements
-  yasolr_init_ds18();
-  yasolr_init_jsy();
-  yasolr_init_jsy_remote();
-  yasolr_init_pzem();
+  yasolr_boot_step("lights", yasolr_init_lights);
+  yasolr_boot_step("trial", yasolr_init_trial);
+  // measurements: slow hardware probes (DS18 search, JSY baud negotiation) run in the background
+  yasolr_boot_step("ds18", yasolr_init_ds18);
+  yasolr_boot_step("jsy", yasolr_init_jsy);
+  yasolr_boot_step("jsy_remote", yasolr_init_jsy_remote);
+  yasolr_boot_step("pzem", yasolr_init_pzem);
   // router hardware
-  yasolr_init_relays();
-  yasolr_init_router();
-  yasolr_init_grid();
+  yasolr_boot_step("relays", yasolr_init_relays);
+  yasolr_boot_step("router", yasolr_init_router);
+  yasolr_boot_step("grid", yasolr_init_grid);
+  yasolr_boot_step("checkpoint", yasolr_init_checkpoint); // warm restart: resume control state
+  yasolr_boot_step("supervisor", yasolr_init_supervisor); // control loop deadlines and safe state
+  // wait for the hardware probes and start the measurement tasks
+  yasolr_boot_join();
+  yasolr_boot_step("ds18_start", yasolr_start_ds18);
+  yasolr_boot_step("jsy_start", yasolr_start_jsy);
   // UI: display, web, mqtt, etc
-  yasolr_init_display();
-  yasolr_init_web_server();
-  yasolr_init_mqtt();
-  yasolr_init_victron();
+  yasolr_boot_step("display", yasolr_init_display);
+  yasolr_boot_step("web_server", yasolr_init_web_server);
+  yasolr_boot_step("mqtt", yasolr_init_mqtt);
+  yasolr_boot_step("modbus_meter", yasolr_init_modbus_meter);
+  yasolr_boot_step("http_meter", yasolr_init_http_meter);
   // network
-  yasolr_init_network();
+  yasolr_boot_step("network", yasolr_init_network);
   // start tasks
-  yasolr_init_tasks();
+  yasolr_boot_step("tasks", yasolr_init_tasks);
 
   // STARTUP READY!
+  yasolr_boot_end();
   logger.info(TAG, "Started %s", Mycila::AppInfo.nameModelVersion.c_str());
+
+#ifdef YASOLR_HEAP_GUARD
+  // from now on, allocations should only come from the network stack and the web pages
+  yasolr_heap_guard_arm();
+#endif
 }
 
 // Destroy default Arduino async task
 void loop() { vTaskDelete(NULL); }
-
-// #include "esp_heap_caps.h"
-// void esp_heap_trace_alloc_hook(void* ptr, size_t size, uint32_t caps) {
-//   if (size >= 1024 && caps == 6144) {
-//     ets_printf("alloc: %p %d\n", ptr, size);
-//     if (size > 2308) {
-//       assert(false);
-//     }
-//   }
-// }
-// void esp_heap_trace_free_hook(void* ptr) {
-//   // ets_printf("free: %p\n", ptr);
-// }
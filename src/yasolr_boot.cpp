@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#include <yasolr.h>
+
+#include <freertos/semphr.h>
+
+#include <vector>
+
+struct BootStep {
+    const char* name;
+    uint32_t start;
+    uint32_t duration;
+    bool async;
+};
+
+struct BootProbe {
+    std::function<void()> fn;
+    // index of the step to update once joined
+    size_t step;
+    uint32_t duration;
+};
+
+static std::vector<BootStep> steps;
+// probes started and not joined yet: each one is only accessed by its own task until joined
+static std::vector<BootProbe*> probes;
+static SemaphoreHandle_t done = nullptr;
+static uint32_t bootTime = 0;
+
+static void runProbe(BootProbe* probe) {
+  const uint32_t start = millis();
+  probe->fn();
+  probe->duration = millis() - start;
+}
+
+void yasolr_boot_step(const char* name, void (*init)()) {
+  const uint32_t start = millis();
+  init();
+  const uint32_t duration = millis() - start;
+  steps.push_back({name, start, duration, false});
+  logger.debug(TAG, "Boot step %s: %" PRIu32 " ms", name, duration);
+}
+
+void yasolr_boot_async(const char* name, std::function<void()> fn) {
+  if (done == nullptr)
+    done = xSemaphoreCreateCounting(YASOLR_BOOT_MAX_PROBES, 0);
+
+  steps.push_back({name, millis(), 0, true});
+  BootProbe* probe = new BootProbe{std::move(fn), steps.size() - 1, 0};
+  probes.push_back(probe);
+
+  // probes only touch their own hardware: they run concurrently in short-lived tasks
+  BaseType_t created = xTaskCreatePinnedToCore([](void* params) {
+    runProbe(static_cast<BootProbe*>(params));
+    xSemaphoreGive(done);
+    vTaskDelete(NULL); }, "y-boot", YASOLR_BOOT_PROBE_STACK_SIZE, probe, 1, nullptr, 0);
+
+  if (created != pdPASS) {
+    logger.warn(TAG, "Unable to start boot probe %s: running it now", name);
+    runProbe(probe);
+    xSemaphoreGive(done);
+  }
+}
+
+void yasolr_boot_join() {
+  const uint32_t start = millis();
+
+  for (size_t i = 0; i < probes.size(); i++)
+    xSemaphoreTake(done, portMAX_DELAY);
+
+  for (BootProbe* probe : probes) {
+    steps[probe->step].duration = probe->duration;
+    logger.debug(TAG, "Boot probe %s: %" PRIu32 " ms", steps[probe->step].name, probe->duration);
+    delete probe;
+  }
+  probes.clear();
+
+  steps.push_back({"join", start, millis() - start, false});
+}
+
+void yasolr_boot_end() {
+  bootTime = millis();
+  logger.info(TAG, "Boot completed in %" PRIu32 " ms", bootTime);
+}
+
+void yasolr_boot_toJson(const JsonObject& root) {
+  root["time"] = bootTime;
+  JsonArray array = root["steps"].to<JsonArray>();
+  for (const BootStep& step : steps) {
+    JsonObject s = array.add<JsonObject>();
+    s["name"] = step.name;
+    s["start"] = step.start;
+    s["duration"] = step.duration;
+    if (step.async)
+      s["async"] = true;
+  }
+}
@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#include <yasolr.h>
+
+#include <esp_attr.h>
+
+#include <stddef.h>
+
+#define YASOLR_CHECKPOINT_MAGIC   0x59534352 // "YSCR"
+#define YASOLR_CHECKPOINT_VERSION 1
+
+// control state kept in RTC slow memory: it survives software restarts without any flash write
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;
+    uint32_t sequence;
+    float powerToDivert;
+    float dutyCycle[2];
+    uint8_t bypass[2];
+    uint8_t relay[2];
+    uint32_t crc; // must stay last
+} Checkpoint;
+
+static RTC_NOINIT_ATTR Checkpoint checkpoint;
+
+static uint32_t checkpointCRC(const Checkpoint& state) {
+  FastCRC32 crc32;
+  crc32.add(reinterpret_cast<const uint8_t*>(&state), offsetof(Checkpoint, crc));
+  return crc32.calc();
+}
+
+static bool isValid() {
+  return checkpoint.magic == YASOLR_CHECKPOINT_MAGIC &&
+         checkpoint.version == YASOLR_CHECKPOINT_VERSION &&
+         checkpoint.size == sizeof(Checkpoint) &&
+         checkpoint.crc == checkpointCRC(checkpoint);
+}
+
+static void saveOutput(Checkpoint& state, size_t i, const Mycila::RouterOutput* output) {
+  state.dutyCycle[i] = output ? output->getDimmerDutyCycle() : 0;
+  // auto bypass is re-evaluated from time and temperature: only a manual bypass is kept
+  state.bypass[i] = output && output->isBypassOn() && !output->isAutoBypassEnabled();
+}
+
+static void restoreOutput(size_t i, Mycila::RouterOutput* output) {
+  if (!output)
+    return;
+  if (checkpoint.bypass[i]) {
+    output->setBypassOn();
+  } else if (!output->isAutoDimmerEnabled() && checkpoint.dutyCycle[i] > 0) {
+    // auto dimmers are restored through the router warm start power
+    output->setDimmerDutyCycle(checkpoint.dutyCycle[i]);
+  }
+}
+
+static Mycila::Task checkpointTask("Checkpoint", [](void* params) { yasolr_checkpoint_save(); });
+
+// set once the checkpoint is cleared: the state of this boot must not be resumed, even by the checkpoint saved before restarting
+static bool cleared = false;
+// the checkpoint task saves while a restart or a factory reset can clear from another task
+static portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
+
+void yasolr_checkpoint_save() {
+  // calibration and the supervisor safe state drive the dimmers on their own: keep the last routing state
+  if (cleared || router.isCalibrationRunning() || yasolr_supervisor_is_safe_state())
+    return;
+
+  // only this task writes the checkpoint: build it aside, then publish it unless it was cleared meanwhile
+  Checkpoint state;
+  memset(&state, 0, sizeof(Checkpoint));
+  state.magic = YASOLR_CHECKPOINT_MAGIC;
+  state.version = YASOLR_CHECKPOINT_VERSION;
+  state.size = sizeof(Checkpoint);
+  state.sequence = checkpoint.sequence + 1;
+  state.powerToDivert = pidController.getOutput() + router.getWarmStartPower();
+  saveOutput(state, 0, output1);
+  saveOutput(state, 1, output2);
+  state.relay[0] = relay1 && relay1->isOn();
+  state.relay[1] = relay2 && relay2->isOn();
+  state.crc = checkpointCRC(state);
+
+  portENTER_CRITICAL(&lock);
+  if (!cleared)
+    checkpoint = state;
+  portEXIT_CRITICAL(&lock);
+}
+
+void yasolr_checkpoint_clear() {
+  portENTER_CRITICAL(&lock);
+  cleared = true;
+  checkpoint.magic = 0;
+  checkpoint.crc = 0;
+  portEXIT_CRITICAL(&lock);
+}
+
+void yasolr_init_checkpoint() {
+  // RTC memory is only kept across software restarts: anything else (power loss, crash, watchdog) starts from a clean state
+  if (esp_reset_reason() == ESP_RST_SW && isValid()) {
+    logger.info(TAG, "Warm restart: resuming control state #%" PRIu32 " (%.02f W)", checkpoint.sequence, checkpoint.powerToDivert);
+
+    if (std::isfinite(checkpoint.powerToDivert) && checkpoint.powerToDivert > 0)
+      router.setWarmStartPower(checkpoint.powerToDivert);
+
+    restoreOutput(0, output1);
+    restoreOutput(1, output2);
+
+    if (relay1 && checkpoint.relay[0])
+      relay1->trySwitchRelay(true);
+    if (relay2 && checkpoint.relay[1])
+      relay2->trySwitchRelay(true);
+  } else {
+    logger.info(TAG, "Cold start: control state starts from zero");
+    memset(&checkpoint, 0, sizeof(Checkpoint));
+  }
+
+  checkpointTask.setInterval(YASOLR_CHECKPOINT_INTERVAL);
+  coreTaskManager.addTask(checkpointTask);
+}
@@ -3,10 +3,326 @@
  * Copyright (C) 2023-2025 Mathieu Carbou
  */
 #include <yasolr.h>
+#include <yasolr_dashboard.h>
 
+#include <string.h>
+
+#include <algorithm>
+#include <mutex>
 #include <string>
 
 Mycila::Config config;
+YaSolR::Settings settings;
+
+// side effects of a configuration change, merged when a transaction changes several keys
+#define YASOLR_REACTION_OUTPUTS 0x01
+#define YASOLR_REACTION_PID     0x02
+#define YASOLR_REACTION_REFRESH 0x04
+
+// commits are serialized: while one runs, the listener collects the reactions of the keys changed by the committing task.
+// keys changed by any other task during the commit react at once.
+static std::mutex commitMutex;
+static TaskHandle_t batchingTask = nullptr;
+static uint8_t pendingReactions = 0;
+
+// keys applied live by the config listener or by the settings listeners: any other key is only applied after a restart
+static const char* hotKeys[] = {
+  KEY_DISPLAY_SPEED,
+  KEY_ENABLE_HA_DISCOVERY,
+  KEY_ENABLE_OUTPUT1_AUTO_BYPASS,
+  KEY_ENABLE_OUTPUT1_AUTO_DIMMER,
+  KEY_ENABLE_OUTPUT2_AUTO_BYPASS,
+  KEY_ENABLE_OUTPUT2_AUTO_DIMMER,
+  KEY_HA_DISCOVERY_TOPIC,
+  KEY_MQTT_PUBLISH_INTERVAL,
+  KEY_NTP_SERVER,
+  KEY_NTP_TIMEZONE,
+  KEY_OUTPUT1_DAYS,
+  KEY_OUTPUT1_DIMMER_LIMIT,
+  KEY_OUTPUT1_DIMMER_MAX,
+  KEY_OUTPUT1_DIMMER_MIN,
+  KEY_OUTPUT1_DIMMER_TEMP_LIMITER,
+  KEY_OUTPUT1_EXCESS_LIMITER,
+  KEY_OUTPUT1_RESISTANCE,
+  KEY_OUTPUT1_TEMPERATURE_START,
+  KEY_OUTPUT1_TEMPERATURE_STOP,
+  KEY_OUTPUT1_TIME_START,
+  KEY_OUTPUT1_TIME_STOP,
+  KEY_OUTPUT2_DAYS,
+  KEY_OUTPUT2_DIMMER_LIMIT,
+  KEY_OUTPUT2_DIMMER_MAX,
+  KEY_OUTPUT2_DIMMER_MIN,
+  KEY_OUTPUT2_DIMMER_TEMP_LIMITER,
+  KEY_OUTPUT2_EXCESS_LIMITER,
+  KEY_OUTPUT2_RESISTANCE,
+  KEY_OUTPUT2_TEMPERATURE_START,
+  KEY_OUTPUT2_TEMPERATURE_STOP,
+  KEY_OUTPUT2_TIME_START,
+  KEY_OUTPUT2_TIME_STOP,
+  KEY_PID_D_MODE,
+  KEY_PID_IC_MODE,
+  KEY_PID_KD,
+  KEY_PID_KI,
+  KEY_PID_KP,
+  KEY_PID_OUT_MAX,
+  KEY_PID_OUT_MIN,
+  KEY_PID_P_MODE,
+  KEY_PID_SETPOINT,
+  KEY_RELAY1_LOAD,
+  KEY_RELAY2_LOAD,
+};
+
+// keys holding a number
+static const char* numberKeys[] = {
+  KEY_DISPLAY_ROTATION,
+  KEY_DISPLAY_SPEED,
+  KEY_GRID_FREQUENCY,
+  KEY_HTTP_METER_PORT,
+  KEY_MODBUS_METER_PORT,
+  KEY_MQTT_PORT,
+  KEY_MQTT_PUBLISH_INTERVAL,
+  KEY_OUTPUT1_DIMMER_LIMIT,
+  KEY_OUTPUT1_DIMMER_MAX,
+  KEY_OUTPUT1_DIMMER_MIN,
+  KEY_OUTPUT1_DIMMER_TEMP_LIMITER,
+  KEY_OUTPUT1_EXCESS_LIMITER,
+  KEY_OUTPUT1_RESISTANCE,
+  KEY_OUTPUT1_TEMPERATURE_START,
+  KEY_OUTPUT1_TEMPERATURE_STOP,
+  KEY_OUTPUT2_DIMMER_LIMIT,
+  KEY_OUTPUT2_DIMMER_MAX,
+  KEY_OUTPUT2_DIMMER_MIN,
+  KEY_OUTPUT2_DIMMER_TEMP_LIMITER,
+  KEY_OUTPUT2_EXCESS_LIMITER,
+  KEY_OUTPUT2_RESISTANCE,
+  KEY_OUTPUT2_TEMPERATURE_START,
+  KEY_OUTPUT2_TEMPERATURE_STOP,
+  KEY_PID_D_MODE,
+  KEY_PID_IC_MODE,
+  KEY_PID_KD,
+  KEY_PID_KI,
+  KEY_PID_KP,
+  KEY_PID_OUT_MAX,
+  KEY_PID_OUT_MIN,
+  KEY_PID_P_MODE,
+  KEY_PID_SETPOINT,
+  KEY_RELAY1_LOAD,
+  KEY_RELAY2_LOAD,
+  KEY_UDP_PORT,
+};
+
+// keys holding one of a list of choices: the startup code only knows these values
+static const struct {
+    const char* key;
+    const char* choices;
+} choiceKeys[] = {
+  {KEY_DISPLAY_TYPE, YASOLR_DISPLAY_TYPES},
+  {KEY_DS18_SYSTEM_RESOLUTION, YASOLR_DS18_RESOLUTION_CHOICES},
+  {KEY_HTTP_METER_MODEL, YASOLR_HTTP_METER_MODELS},
+  {KEY_JSY_UART, YASOLR_UART_CHOICES},
+  {KEY_MODBUS_METER_MODEL, YASOLR_MODBUS_METER_MODELS},
+  {KEY_OUTPUT1_DIMMER_TYPE, YASOLR_DIMMER_TYPES},
+  {KEY_OUTPUT1_DS18_RESOLUTION, YASOLR_DS18_RESOLUTION_CHOICES},
+  {KEY_OUTPUT1_RELAY_TYPE, YASOLR_RELAY_TYPES},
+  {KEY_OUTPUT2_DIMMER_TYPE, YASOLR_DIMMER_TYPES},
+  {KEY_OUTPUT2_DS18_RESOLUTION, YASOLR_DS18_RESOLUTION_CHOICES},
+  {KEY_OUTPUT2_RELAY_TYPE, YASOLR_RELAY_TYPES},
+  {KEY_PZEM_UART, YASOLR_UART_CHOICES},
+  {KEY_RELAY1_TYPE, YASOLR_RELAY_TYPES},
+  {KEY_RELAY2_TYPE, YASOLR_RELAY_TYPES},
+};
+
+static bool contains(const char* const* keys, size_t count, const char* key) {
+  for (size_t i = 0; i < count; i++)
+    if (strcmp(keys[i], key) == 0)
+      return true;
+  return false;
+}
+
+static bool isBoolKey(const char* key) {
+  const size_t len = strlen(key);
+  return strcmp(key, KEY_MQTT_SECURED) == 0 || (len > 7 && strcmp(key + len - 7, "_enable") == 0);
+}
+
+static bool isNumberKey(const char* key) {
+  return strncmp(key, "pin_", 4) == 0 || contains(numberKeys, sizeof(numberKeys) / sizeof(numberKeys[0]), key);
+}
+
+static bool isNumber(const std::string& value) {
+  if (value.empty())
+    return true; // unset: back to the default value
+  char* end = nullptr;
+  strtof(value.c_str(), &end);
+  return end && *end == '\0';
+}
+
+// returns the comma separated choices of the key, or nullptr if the key is not a choice
+static const char* choicesOf(const char* key) {
+  for (const auto& choice : choiceKeys)
+    if (strcmp(choice.key, key) == 0)
+      return choice.choices;
+  return nullptr;
+}
+
+static bool isChoice(const char* choices, const std::string& value) {
+  if (value.empty())
+    return true; // unset: back to the default value
+  for (const char* start = choices;;) {
+    const char* end = strchr(start, ',');
+    const size_t len = end ? end - start : strlen(start);
+    if (value.length() == len && strncmp(start, value.c_str(), len) == 0)
+      return true;
+    if (!end)
+      return false;
+    start = end + 1;
+  }
+}
+
+static void react(uint8_t reactions) {
+  // staged: applied by the router between two control cycles
+  if (reactions & YASOLR_REACTION_OUTPUTS)
+    yasolr_configure_outputs();
+
+  if (reactions & YASOLR_REACTION_PID)
+    yasolr_configure_pid();
+
+  if (reactions & YASOLR_REACTION_REFRESH) {
+    dashboardInitTask.resume();
+    if (mqttPublishConfigTask)
+      mqttPublishConfigTask->resume();
+  }
+}
+
+bool YaSolR::ConfigTransaction::set(const char* key, const std::string& value) {
+  const char* keyRef = config.keyRef(key);
+
+  if (!keyRef) {
+    _error = std::string("Unknown key: ") + key;
+    return false;
+  }
+
+  if (isBoolKey(keyRef) && !value.empty() && value != YASOLR_TRUE && value != YASOLR_FALSE) {
+    _error = std::string("Invalid boolean for ") + keyRef + ": " + value;
+    return false;
+  }
+
+  if (isNumberKey(keyRef) && !isNumber(value)) {
+    _error = std::string("Invalid number for ") + keyRef + ": " + value;
+    return false;
+  }
+
+  const char* choices = choicesOf(keyRef);
+  if (choices && !isChoice(choices, value)) {
+    _error = std::string("Invalid choice for ") + keyRef + ": " + value + " (expected: " + choices + ")";
+    return false;
+  }
+
+  // unchanged values have no side effect
+  if (config.getString(keyRef) == value)
+    return true;
+
+  _values[keyRef] = value;
+
+  if (!contains(hotKeys, sizeof(hotKeys) / sizeof(hotKeys[0]), keyRef))
+    _restartRequired = true;
+
+  return true;
+}
+
+bool YaSolR::ConfigTransaction::commit() {
+  if (!isValid())
+    return false;
+
+  if (_values.empty())
+    return true;
+
+  logger.info(TAG, "Applying %" PRIu32 " configuration changes%s", static_cast<uint32_t>(_values.size()), _restartRequired ? " (restart required)" : "");
+
+  // the listener is called for each changed key: side effects are collected and run once
+  uint8_t reactions;
+  {
+    std::lock_guard<std::mutex> lock(commitMutex);
+    batchingTask = xTaskGetCurrentTaskHandle();
+    pendingReactions = 0;
+    config.set(_values);
+    reactions = pendingReactions;
+    batchingTask = nullptr;
+  }
+
+  // the control state does not match the new configuration: the restart must start cold
+  if (_restartRequired)
+    yasolr_checkpoint_clear();
+
+  react(reactions);
+  return true;
+}
+
+size_t YaSolR::ConfigWriter::read(uint8_t* buffer, size_t maxLen) {
+  size_t written = 0;
+  while (written < maxLen) {
+    if (_offset == _line.length()) {
+      if (_index >= config.keys().size())
+        break;
+      const char* key = config.keys()[_index++];
+      _line = key;
+      _line += '=';
+      _line += config.getString(key);
+      _line += '\n';
+      _offset = 0;
+    }
+    const size_t n = std::min(maxLen - written, _line.length() - _offset);
+    memcpy(buffer + written, _line.c_str() + _offset, n);
+    _offset += n;
+    written += n;
+  }
+  return written;
+}
+
+bool YaSolR::ConfigReader::write(const uint8_t* data, size_t len) {
+  for (size_t i = 0; i < len && _transaction.isValid(); i++) {
+    const char c = static_cast<char>(data[i]);
+    if (c == '\n') {
+      _parse();
+    } else if (c != '\r') {
+      if (_line.length() == YASOLR_CONFIG_LINE_MAX_SIZE - 1) {
+        _transaction._error = "Line too long: " + _line.substr(0, _line.find('='));
+        return false;
+      }
+      _line += c;
+    }
+  }
+  return _transaction.isValid();
+}
+
+bool YaSolR::ConfigReader::end() {
+  if (_transaction.isValid() && !_line.empty())
+    _parse();
+  return _transaction.isValid();
+}
+
+bool YaSolR::ConfigReader::_parse() {
+  std::string line;
+  std::swap(line, _line);
+
+  if (line.empty())
+    return true;
+
+  const size_t separator = line.find('=');
+  if (separator == std::string::npos) {
+    _transaction._error = "Malformed line: " + line;
+    return false;
+  }
+  const std::string key = line.substr(0, separator);
+
+  // a backup made by another firmware version can contain keys that do not exist anymore
+  if (!config.keyRef(key.c_str())) {
+    logger.warn(TAG, "Skipping unknown key: %s", key.c_str());
+    _skipped++;
+    return true;
+  }
+
+  return _transaction.set(key.c_str(), line.substr(separator + 1));
+}
 
 void yasolr_init_config() {
   logger.info(TAG, "Configuring %s", Mycila::AppInfo.nameModelVersion.c_str());
@@ -17,14 +333,17 @@ void yasolr_init_config() {
   config.configure(KEY_DISPLAY_ROTATION, "0");
   config.configure(KEY_DISPLAY_SPEED, "3");
   config.configure(KEY_DISPLAY_TYPE, "SH1106");
+  config.configure(KEY_DS18_SYSTEM_RESOLUTION, "12");
   config.configure(KEY_ENABLE_AP_MODE, YASOLR_FALSE);
   config.configure(KEY_ENABLE_DEBUG, YASOLR_FALSE);
   config.configure(KEY_ENABLE_DISPLAY, YASOLR_FALSE);
   config.configure(KEY_ENABLE_DS18_SYSTEM, YASOLR_FALSE);
   config.configure(KEY_ENABLE_HA_DISCOVERY, YASOLR_FALSE);
+  config.configure(KEY_ENABLE_HTTP_METER, YASOLR_FALSE);
   config.configure(KEY_ENABLE_JSY_REMOTE, YASOLR_FALSE);
   config.configure(KEY_ENABLE_JSY, YASOLR_FALSE);
   config.configure(KEY_ENABLE_LIGHTS, YASOLR_FALSE);
+  config.configure(KEY_ENABLE_MODBUS_METER, YASOLR_FALSE);
   config.configure(KEY_ENABLE_MQTT, YASOLR_FALSE);
   config.configure(KEY_ENABLE_OUTPUT1_AUTO_BYPASS, YASOLR_FALSE);
   config.configure(KEY_ENABLE_OUTPUT1_AUTO_DIMMER, YASOLR_FALSE);
@@ -40,13 +359,18 @@ void yasolr_init_config() {
   config.configure(KEY_ENABLE_OUTPUT2_RELAY, YASOLR_FALSE);
   config.configure(KEY_ENABLE_RELAY1, YASOLR_FALSE);
   config.configure(KEY_ENABLE_RELAY2, YASOLR_FALSE);
-  config.configure(KEY_ENABLE_VICTRON_MODBUS, YASOLR_FALSE);
   config.configure(KEY_ENABLE_ZCD, YASOLR_FALSE);
   config.configure(KEY_GRID_FREQUENCY, "0");
   config.configure(KEY_GRID_POWER_MQTT_TOPIC);
   config.configure(KEY_GRID_VOLTAGE_MQTT_TOPIC);
   config.configure(KEY_HA_DISCOVERY_TOPIC, MYCILA_HA_DISCOVERY_TOPIC);
+  config.configure(KEY_HTTP_METER_MODEL, "Shelly Pro EM");
+  config.configure(KEY_HTTP_METER_PORT, "80");
+  config.configure(KEY_HTTP_METER_SERVER);
   config.configure(KEY_JSY_UART, JSY_UART_DEFAULT);
+  config.configure(KEY_MODBUS_METER_MODEL, "Victron");
+  config.configure(KEY_MODBUS_METER_PORT, "502");
+  config.configure(KEY_MODBUS_METER_SERVER);
   config.configure(KEY_MQTT_PASSWORD);
   config.configure(KEY_MQTT_PORT, "1883");
   config.configure(KEY_MQTT_PUBLISH_INTERVAL, "5");
@@ -66,6 +390,7 @@ void yasolr_init_config() {
   config.configure(KEY_OUTPUT1_DIMMER_MIN, "0");
   config.configure(KEY_OUTPUT1_DIMMER_TEMP_LIMITER, "0");
   config.configure(KEY_OUTPUT1_DIMMER_TYPE, YASOLR_DIMMER_ROBODYN);
+  config.configure(KEY_OUTPUT1_DS18_RESOLUTION, "12");
   config.configure(KEY_OUTPUT1_EXCESS_LIMITER, "0");
   config.configure(KEY_OUTPUT1_RELAY_TYPE, YASOLR_RELAY_TYPE_NO);
   config.configure(KEY_OUTPUT1_RESISTANCE, "0");
@@ -80,6 +405,7 @@ void yasolr_init_config() {
   config.configure(KEY_OUTPUT2_DIMMER_MIN, "0");
   config.configure(KEY_OUTPUT2_DIMMER_TEMP_LIMITER, "0");
   config.configure(KEY_OUTPUT2_DIMMER_TYPE, YASOLR_DIMMER_ROBODYN);
+  config.configure(KEY_OUTPUT2_DS18_RESOLUTION, "12");
   config.configure(KEY_OUTPUT2_EXCESS_LIMITER, "0");
   config.configure(KEY_OUTPUT2_RELAY_TYPE, YASOLR_RELAY_TYPE_NO);
   config.configure(KEY_OUTPUT2_RESISTANCE, "0");
@@ -122,11 +448,11 @@ void yasolr_init_config() {
   config.configure(KEY_RELAY2_LOAD, "0");
   config.configure(KEY_RELAY2_TYPE, YASOLR_RELAY_TYPE_NO);
   config.configure(KEY_UDP_PORT, std::to_string(YASOLR_UDP_PORT));
-  config.configure(KEY_VICTRON_MODBUS_PORT, "502");
-  config.configure(KEY_VICTRON_MODBUS_SERVER);
   config.configure(KEY_WIFI_PASSWORD);
   config.configure(KEY_WIFI_SSID);
 
+  settings.load();
+
   config.listen([]() {
     logger.info(TAG, "Configuration restored!");
     restartTask.resume();
@@ -134,146 +460,40 @@ void yasolr_init_config() {
 
   config.listen([](const char* k, const std::string& newValue) {
     logger.info(TAG, "'%s' => '%s'", k, newValue.c_str());
+    // keys only read at startup: the control state saved for the next boot was computed with the old value
+    if (!contains(hotKeys, sizeof(hotKeys) / sizeof(hotKeys[0]), k))
+      yasolr_checkpoint_clear();
+    settings.update(k);
+    website.invalidate(k);
     const std::string key = k;
+    uint8_t reactions = YASOLR_REACTION_REFRESH;
 
     if (key == KEY_RELAY1_LOAD) {
       if (relay1)
-        relay1->setLoad(config.getLong(KEY_RELAY1_LOAD));
+        relay1->setLoad(settings.relay1Load);
 
     } else if (key == KEY_RELAY2_LOAD) {
       if (relay2)
-        relay2->setLoad(config.getLong(KEY_RELAY2_LOAD));
-
-    } else if (key == KEY_OUTPUT1_RESISTANCE) {
-      if (output1)
-        output1->config.calibratedResistance = config.getFloat(KEY_OUTPUT1_RESISTANCE);
-
-    } else if (key == KEY_ENABLE_OUTPUT1_AUTO_DIMMER) {
-      if (output1) {
-        output1->config.autoDimmer = config.getBool(KEY_ENABLE_OUTPUT1_AUTO_DIMMER);
-        output1->setDimmerOff();
-      }
-
-    } else if (key == KEY_OUTPUT1_DIMMER_MIN) {
-      if (output1)
-        output1->setDimmerDutyCycleMin(config.getFloat(KEY_OUTPUT1_DIMMER_MIN) / 100.0f);
-
-    } else if (key == KEY_OUTPUT1_DIMMER_MAX) {
-      if (output1)
-        output1->setDimmerDutyCycleMax(config.getFloat(KEY_OUTPUT1_DIMMER_MAX) / 100.0f);
-
-    } else if (key == KEY_OUTPUT1_DIMMER_LIMIT) {
-      if (output1)
-        output1->setDimmerDutyCycleLimit(config.getFloat(KEY_OUTPUT1_DIMMER_LIMIT) / 100.0f);
-
-    } else if (key == KEY_OUTPUT1_DIMMER_TEMP_LIMITER) {
-      if (output1)
-        output1->config.dimmerTempLimit = config.getLong(KEY_OUTPUT1_DIMMER_TEMP_LIMITER);
-
-    } else if (key == KEY_ENABLE_OUTPUT1_AUTO_BYPASS) {
-      if (output1)
-        output1->config.autoBypass = config.getBool(KEY_ENABLE_OUTPUT1_AUTO_BYPASS);
-
-    } else if (key == KEY_OUTPUT1_TEMPERATURE_START) {
-      if (output1)
-        output1->config.autoStartTemperature = config.getLong(KEY_OUTPUT1_TEMPERATURE_START);
-
-    } else if (key == KEY_OUTPUT1_TEMPERATURE_STOP) {
-      if (output1)
-        output1->config.autoStopTemperature = config.getLong(KEY_OUTPUT1_TEMPERATURE_STOP);
+        relay2->setLoad(settings.relay2Load);
 
-    } else if (key == KEY_OUTPUT1_TIME_START) {
-      if (output1)
-        output1->config.autoStartTime = config.get(KEY_OUTPUT1_TIME_START);
-
-    } else if (key == KEY_OUTPUT1_TIME_STOP) {
-      if (output1)
-        output1->config.autoStopTime = config.get(KEY_OUTPUT1_TIME_STOP);
-
-    } else if (key == KEY_OUTPUT1_DAYS) {
-      if (output1)
-        output1->config.weekDays = config.get(KEY_OUTPUT1_DAYS);
-
-    } else if (key == KEY_OUTPUT1_EXCESS_LIMITER) {
-      if (output1)
-        output1->config.excessPowerLimiter = config.getFloat(KEY_OUTPUT1_EXCESS_LIMITER);
-
-    } else if (key == KEY_OUTPUT2_RESISTANCE) {
-      if (output2)
-        output2->config.calibratedResistance = config.getFloat(KEY_OUTPUT2_RESISTANCE);
-
-    } else if (key == KEY_ENABLE_OUTPUT2_AUTO_DIMMER) {
-      if (output2) {
-        output2->config.autoDimmer = config.getBool(KEY_ENABLE_OUTPUT2_AUTO_DIMMER);
-        output2->setDimmerOff();
-      }
-
-    } else if (key == KEY_OUTPUT2_DIMMER_MIN) {
-      if (output2)
-        output2->setDimmerDutyCycleMin(config.getFloat(KEY_OUTPUT2_DIMMER_MIN) / 100.0f);
-
-    } else if (key == KEY_OUTPUT2_DIMMER_MAX) {
-      if (output2)
-        output2->setDimmerDutyCycleMax(config.getFloat(KEY_OUTPUT2_DIMMER_MAX) / 100.0f);
-
-    } else if (key == KEY_OUTPUT2_DIMMER_LIMIT) {
-      if (output2)
-        output2->setDimmerDutyCycleLimit(config.getFloat(KEY_OUTPUT2_DIMMER_LIMIT) / 100.0f);
-
-    } else if (key == KEY_OUTPUT2_DIMMER_TEMP_LIMITER) {
-      if (output2)
-        output2->config.dimmerTempLimit = config.getLong(KEY_OUTPUT2_DIMMER_TEMP_LIMITER);
-
-    } else if (key == KEY_ENABLE_OUTPUT2_AUTO_BYPASS) {
-      if (output2)
-        output2->config.autoBypass = config.getBool(KEY_ENABLE_OUTPUT2_AUTO_BYPASS);
-
-    } else if (key == KEY_OUTPUT2_TEMPERATURE_START) {
-      if (output2)
-        output2->config.autoStartTemperature = config.getLong(KEY_OUTPUT2_TEMPERATURE_START);
-
-    } else if (key == KEY_OUTPUT2_TEMPERATURE_STOP) {
-      if (output2)
-        output2->config.autoStopTemperature = config.getLong(KEY_OUTPUT2_TEMPERATURE_STOP);
-
-    } else if (key == KEY_OUTPUT2_TIME_START) {
-      if (output2)
-        output2->config.autoStartTime = config.get(KEY_OUTPUT2_TIME_START);
-
-    } else if (key == KEY_OUTPUT2_TIME_STOP) {
-      if (output2)
-        output2->config.autoStopTime = config.get(KEY_OUTPUT2_TIME_STOP);
-
-    } else if (key == KEY_OUTPUT2_DAYS) {
-      if (output2)
-        output2->config.weekDays = config.get(KEY_OUTPUT2_DAYS);
-
-    } else if (key == KEY_OUTPUT2_EXCESS_LIMITER) {
-      if (output2)
-        output2->config.excessPowerLimiter = config.getFloat(KEY_OUTPUT2_EXCESS_LIMITER);
+    } else if (key.rfind("o1_", 0) == 0 || key.rfind("o2_", 0) == 0) {
+      // output keys: the whole configuration of the outputs is staged again
+      reactions |= YASOLR_REACTION_OUTPUTS;
 
     } else if (key == KEY_NTP_TIMEZONE) {
-      Mycila::NTP.setTimeZone(config.get(KEY_NTP_TIMEZONE));
+      Mycila::NTP.setTimeZone(settings.ntpTimezone.c_str());
 
     } else if (key == KEY_NTP_SERVER) {
-      if (!config.getBool(KEY_ENABLE_AP_MODE))
-        Mycila::NTP.sync(config.get(KEY_NTP_SERVER));
+      if (!settings.apMode)
+        Mycila::NTP.sync(settings.ntpServer.c_str());
 
     } else if (key == KEY_PID_KP || key == KEY_PID_KI || key == KEY_PID_KD || key == KEY_PID_OUT_MIN || key == KEY_PID_OUT_MAX || key == KEY_PID_P_MODE || key == KEY_PID_D_MODE || key == KEY_PID_IC_MODE || key == KEY_PID_SETPOINT) {
-      pidController.setProportionalMode((Mycila::PID::ProportionalMode)config.getLong(KEY_PID_P_MODE));
-      pidController.setDerivativeMode((Mycila::PID::DerivativeMode)config.getLong(KEY_PID_D_MODE));
-      pidController.setIntegralCorrectionMode((Mycila::PID::IntegralCorrectionMode)config.getLong(KEY_PID_IC_MODE));
-      pidController.setSetPoint(config.getFloat(KEY_PID_SETPOINT));
-      pidController.setTunings(config.getFloat(KEY_PID_KP), config.getFloat(KEY_PID_KI), config.getFloat(KEY_PID_KD));
-      pidController.setOutputLimits(config.getFloat(KEY_PID_OUT_MIN), config.getFloat(KEY_PID_OUT_MAX));
-      logger.info(TAG, "PID Controller reconfigured!");
-
-    } else if (key == KEY_MQTT_PUBLISH_INTERVAL) {
-      mqttPublishTask->setInterval(config.getLong(KEY_MQTT_PUBLISH_INTERVAL) * 1000);
+      reactions |= YASOLR_REACTION_PID;
     }
 
-    dashboardInitTask.resume();
-    if (mqttPublishConfigTask)
-      mqttPublishConfigTask->resume();
+    if (batchingTask == xTaskGetCurrentTaskHandle())
+      pendingReactions |= reactions;
+    else
+      react(reactions);
   });
 }
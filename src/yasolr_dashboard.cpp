@@ -109,12 +109,44 @@ static dash::SliderCard<float, 2> _output2DimmerSlider(dashboard, YASOLR_LBL_070
 static dash::SwitchCard _output2Bypass(dashboard, YASOLR_LBL_070 ": " YASOLR_LBL_051);
 #endif
 
-static int16_t _gridPowerHistoryY[YASOLR_GRAPH_POINTS] = {0};
-static uint16_t _routedPowerHistoryY[YASOLR_GRAPH_POINTS] = {0};
-static uint8_t _routerTHDiHistoryY[YASOLR_GRAPH_POINTS] = {0};
-static dash::LineChart<int8_t, int16_t> _gridPowerHistory(dashboard, YASOLR_LBL_044 " (W)");
-static dash::AreaChart<int8_t, uint16_t> _routedPowerHistory(dashboard, YASOLR_LBL_036 " (W)");
-static dash::BarChart<int8_t, uint8_t> _routerTHDiHistory(dashboard, YASOLR_LBL_039 " (%)");
+// charts history: 1 s samples averaged into 10 s, 1 min and 15 min levels
+#define YASOLR_HISTORY_LEVELS YASOLR_HISTORY_1S_POINTS, YASOLR_HISTORY_10S_POINTS, YASOLR_HISTORY_1M_POINTS, YASOLR_HISTORY_15M_POINTS
+static const uint16_t _historyFactors[] = {10, 6, 15};
+static Mycila::TimeSeries<int16_t, YASOLR_HISTORY_LEVELS> _gridPowerSeries(_historyFactors);
+static Mycila::TimeSeries<uint16_t, YASOLR_HISTORY_LEVELS> _routedPowerSeries(_historyFactors);
+static Mycila::TimeSeries<uint8_t, YASOLR_HISTORY_LEVELS> _routerTHDiSeries(_historyFactors);
+
+// displayed range of the charts: level of the history and number of points of this level, downsampled to YASOLR_GRAPH_POINTS
+static const struct {
+    const char* name;
+    uint8_t level;
+    uint16_t points;
+} _chartRanges[] = {
+  {"1 min", 0, 60},
+  {"1 h", 1, 360},
+  {"4 h", 2, 240},
+  {"24 h", 3, 96},
+  {YASOLR_LBL_204, 3, 672},
+};
+static size_t _chartRangeIndex = 0;
+
+// points sent to a chart, in seconds from now
+template <typename T>
+struct ChartPoints {
+    int32_t x[YASOLR_GRAPH_POINTS];
+    T y[YASOLR_GRAPH_POINTS];
+    size_t size = 0;
+};
+static ChartPoints<int16_t> _gridPowerPoints;
+static ChartPoints<uint16_t> _routedPowerPoints;
+static ChartPoints<uint8_t> _routerTHDiPoints;
+
+#ifdef APP_MODEL_PRO
+static dash::DropdownCard<const char*> _chartRange(dashboard, YASOLR_LBL_203, "1 min,1 h,4 h,24 h," YASOLR_LBL_204);
+#endif
+static dash::LineChart<int32_t, int16_t> _gridPowerHistory(dashboard, YASOLR_LBL_044 " (W)");
+static dash::AreaChart<int32_t, uint16_t> _routedPowerHistory(dashboard, YASOLR_LBL_036 " (W)");
+static dash::BarChart<int32_t, uint8_t> _routerTHDiHistory(dashboard, YASOLR_LBL_039 " (%)");
 
 #ifdef APP_MODEL_OSS
 static dash::SwitchCard _output1PZEMSync(dashboard, YASOLR_LBL_147);
@@ -233,6 +265,8 @@ static int16_t _pidSumHistoryY[YASOLR_GRAPH_POINTS] = {0};
 static int16_t _pidPTermHistoryY[YASOLR_GRAPH_POINTS] = {0};
 static int16_t _pidITermHistoryY[YASOLR_GRAPH_POINTS] = {0};
 static int16_t _pidDTermHistoryY[YASOLR_GRAPH_POINTS] = {0};
+// one bit per PID chart sampled with a new point since it was last sent
+static uint8_t _pidHistoryChanged = 0;
 static dash::SwitchCard _pidView(dashboard, YASOLR_LBL_169);
 static dash::DropdownCard<const char*> _pidPMode(dashboard, YASOLR_LBL_160, YASOLR_PID_P_MODE_1 "," YASOLR_PID_P_MODE_2 "," YASOLR_PID_P_MODE_3);
 static dash::DropdownCard<const char*> _pidDMode(dashboard, YASOLR_LBL_161, YASOLR_PID_D_MODE_1 "," YASOLR_PID_D_MODE_2 "," YASOLR_PID_D_MODE_3);
@@ -289,57 +323,65 @@ static dash::DropdownCard<const char*> _gridFreq(dashboard, YASOLR_LBL_141, "Aut
 static dash::FeedbackSwitchCard _jsy(dashboard, YASOLR_LBL_128);
 static dash::FeedbackSwitchCard _jsyRemote(dashboard, YASOLR_LBL_187);
 static dash::FeedbackSwitchCard _zcd(dashboard, YASOLR_LBL_125);
-static dash::FeedbackSwitchCard _victron(dashboard, YASOLR_LBL_195);
-static dash::TextInputCard<const char*> _victronServer(dashboard, YASOLR_LBL_196);
-static dash::TextInputCard<uint16_t> _victronPort(dashboard, YASOLR_LBL_197);
+static dash::FeedbackSwitchCard _modbusMeter(dashboard, YASOLR_LBL_195);
+static dash::DropdownCard<const char*> _modbusMeterModel(dashboard, YASOLR_LBL_198, YASOLR_MODBUS_METER_MODELS);
+static dash::TextInputCard<const char*> _modbusMeterServer(dashboard, YASOLR_LBL_196);
+static dash::TextInputCard<uint16_t> _modbusMeterPort(dashboard, YASOLR_LBL_197);
+static dash::FeedbackSwitchCard _httpMeter(dashboard, YASOLR_LBL_199);
+static dash::DropdownCard<const char*> _httpMeterModel(dashboard, YASOLR_LBL_202, YASOLR_HTTP_METER_MODELS);
+static dash::TextInputCard<const char*> _httpMeterServer(dashboard, YASOLR_LBL_200);
+static dash::TextInputCard<uint16_t> _httpMeterPort(dashboard, YASOLR_LBL_201);
 
 // output 1 dimmer
 static dash::FeedbackSwitchCard _output1Dimmer(dashboard, YASOLR_LBL_046 ": " YASOLR_LBL_050);
-static dash::DropdownCard<const char*> _output1DimmerType(dashboard, YASOLR_LBL_151, YASOLR_DIMMER_LSA_GP8211S "," YASOLR_DIMMER_LSA_GP8403 "," YASOLR_DIMMER_LSA_GP8413 "," YASOLR_DIMMER_LSA_PWM "," YASOLR_DIMMER_LSA_PWM_ZCD "," YASOLR_DIMMER_RANDOM_SSR "," YASOLR_DIMMER_ROBODYN "," YASOLR_DIMMER_TRIAC "," YASOLR_DIMMER_ZC_SSR);
+static dash::DropdownCard<const char*> _output1DimmerType(dashboard, YASOLR_LBL_151, YASOLR_DIMMER_TYPES);
 static dash::RangeSliderCard<uint8_t> _output1DimmerMapper(dashboard, YASOLR_LBL_183, 0, 100, 1, "%");
 static dash::FeedbackSwitchCard _output1PZEM(dashboard, YASOLR_LBL_133);
 static dash::SwitchCard _output1PZEMSync(dashboard, YASOLR_LBL_147);
 
 // output 1 bypass relay
 static dash::FeedbackSwitchCard _output1Relay(dashboard, YASOLR_LBL_046 ": " YASOLR_LBL_134);
-static dash::DropdownCard<const char*> _output1RelayType(dashboard, YASOLR_LBL_151, "NO,NC");
+static dash::DropdownCard<const char*> _output1RelayType(dashboard, YASOLR_LBL_151, YASOLR_RELAY_TYPES);
 
 // output 1 ds18
 static dash::FeedbackSwitchCard _output1DS18(dashboard, YASOLR_LBL_046 ": " YASOLR_LBL_132);
+static dash::DropdownCard<uint8_t> _output1DS18Resolution(dashboard, YASOLR_LBL_205, YASOLR_DS18_RESOLUTION_CHOICES);
 
 // output 2 dimmer
 static dash::FeedbackSwitchCard _output2Dimmer(dashboard, YASOLR_LBL_070 ": " YASOLR_LBL_050);
-static dash::DropdownCard<const char*> _output2DimmerType(dashboard, YASOLR_LBL_151, YASOLR_DIMMER_LSA_GP8211S "," YASOLR_DIMMER_LSA_GP8403 "," YASOLR_DIMMER_LSA_GP8413 "," YASOLR_DIMMER_LSA_PWM "," YASOLR_DIMMER_LSA_PWM_ZCD "," YASOLR_DIMMER_RANDOM_SSR "," YASOLR_DIMMER_ROBODYN "," YASOLR_DIMMER_TRIAC "," YASOLR_DIMMER_ZC_SSR);
+static dash::DropdownCard<const char*> _output2DimmerType(dashboard, YASOLR_LBL_151, YASOLR_DIMMER_TYPES);
 static dash::RangeSliderCard<uint8_t> _output2DimmerMapper(dashboard, YASOLR_LBL_183, 0, 100, 1, "%");
 static dash::FeedbackSwitchCard _output2PZEM(dashboard, YASOLR_LBL_133);
 static dash::SwitchCard _output2PZEMSync(dashboard, YASOLR_LBL_148);
 
 // output 2 bypass relay
 static dash::FeedbackSwitchCard _output2Relay(dashboard, YASOLR_LBL_070 ": " YASOLR_LBL_134);
-static dash::DropdownCard<const char*> _output2RelayType(dashboard, YASOLR_LBL_151, "NO,NC");
+static dash::DropdownCard<const char*> _output2RelayType(dashboard, YASOLR_LBL_151, YASOLR_RELAY_TYPES);
 
 // output 2 ds18
 static dash::FeedbackSwitchCard _output2DS18(dashboard, YASOLR_LBL_070 ": " YASOLR_LBL_132);
+static dash::DropdownCard<uint8_t> _output2DS18Resolution(dashboard, YASOLR_LBL_205, YASOLR_DS18_RESOLUTION_CHOICES);
 
 // relay1
 static dash::FeedbackSwitchCard _relay1(dashboard, YASOLR_LBL_074);
-static dash::DropdownCard<const char*> _relay1Type(dashboard, YASOLR_LBL_151, "NO,NC");
+static dash::DropdownCard<const char*> _relay1Type(dashboard, YASOLR_LBL_151, YASOLR_RELAY_TYPES);
 static dash::TextInputCard<uint16_t> _relay1Load(dashboard, YASOLR_LBL_072);
 
 // relay2
 static dash::FeedbackSwitchCard _relay2(dashboard, YASOLR_LBL_077);
-static dash::DropdownCard<const char*> _relay2Type(dashboard, YASOLR_LBL_151, "NO,NC");
+static dash::DropdownCard<const char*> _relay2Type(dashboard, YASOLR_LBL_151, YASOLR_RELAY_TYPES);
 static dash::TextInputCard<uint16_t> _relay2Load(dashboard, YASOLR_LBL_075);
 
 // router ds18
 static dash::FeedbackSwitchCard _routerDS18(dashboard, YASOLR_LBL_135 ": " YASOLR_LBL_132);
+static dash::DropdownCard<uint8_t> _routerDS18Resolution(dashboard, YASOLR_LBL_205, YASOLR_DS18_RESOLUTION_CHOICES);
 
 // router led
 static dash::FeedbackSwitchCard _led(dashboard, YASOLR_LBL_135 ": " YASOLR_LBL_129);
 
 // display
 static dash::FeedbackSwitchCard _display(dashboard, YASOLR_LBL_135 ": " YASOLR_LBL_127);
-static dash::DropdownCard<const char*> _displayType(dashboard, YASOLR_LBL_143, "SH1106,SH1107,SSD1306");
+static dash::DropdownCard<const char*> _displayType(dashboard, YASOLR_LBL_143, YASOLR_DISPLAY_TYPES);
 static dash::DropdownCard<uint16_t> _displayRotation(dashboard, YASOLR_LBL_144, "0,90,180,270");
 static dash::SliderCard<uint8_t> _displaySpeed(dashboard, YASOLR_LBL_142, 1, 10, 1, "s");
 
@@ -391,6 +433,7 @@ static void _onChangeResistanceCalibration(bool value) {
     });
 
     // because we set false to trigger events
+    invalidate({Section::OUTPUT1, Section::OUTPUT2, Section::OUTPUT1_CONFIG, Section::OUTPUT2_CONFIG});
     dashboardInitTask.resume();
     if (mqttPublishConfigTask)
       mqttPublishConfigTask->resume();
@@ -425,10 +468,6 @@ void YaSolR::Website::begin() {
     _outputDimmerSlider(_output2DimmerSlider, *output2);
   }
 
-  _gridPowerHistory.setX(_historyX, YASOLR_GRAPH_POINTS);
-  _routedPowerHistory.setX(_historyX, YASOLR_GRAPH_POINTS);
-  _routerTHDiHistory.setX(_historyX, YASOLR_GRAPH_POINTS);
-
   _output1ResistanceCalibration.onChange(_onChangeResistanceCalibration);
   _output2ResistanceCalibration.onChange(_onChangeResistanceCalibration);
 
@@ -449,6 +488,18 @@ void YaSolR::Website::begin() {
 
   // tab: home
 
+  _chartRange.setValue(_chartRanges[_chartRangeIndex].name);
+  _chartRange.onChange([](const char* value) {
+    for (size_t i = 0; i < sizeof(_chartRanges) / sizeof(_chartRanges[0]); i++) {
+      if (strcmp(value, _chartRanges[i].name) == 0) {
+        _chartRangeIndex = i;
+        _chartRange.setValue(_chartRanges[i].name);
+        break;
+      }
+    }
+    dashboard.refresh(_chartRange);
+    dashboardUpdateTask.requestEarlyRun();
+  });
   _gridPowerHistory.setSize(FULL_SIZE);
   _routedPowerHistory.setSize(FULL_SIZE);
   _routerTHDiHistory.setSize(FULL_SIZE);
@@ -617,6 +668,7 @@ void YaSolR::Website::begin() {
   _mqttServerCertDelete.onPush([this]() {
     if (LittleFS.exists(YASOLR_MQTT_SERVER_CERT_FILE) && LittleFS.remove(YASOLR_MQTT_SERVER_CERT_FILE)) {
       logger.warn(TAG, "MQTT server certificate deleted successfully!");
+      invalidate({Section::MQTT});
       dashboardInitTask.resume();
     }
   });
@@ -669,6 +721,7 @@ void YaSolR::Website::begin() {
     if (value)
       resetPIDCharts();
     dashboard.refresh(_pidView);
+    invalidate({Section::PID});
     dashboardInitTask.resume();
   });
 
@@ -774,16 +827,26 @@ void YaSolR::Website::begin() {
   _jsy.setTab(_hardwareConfigTab);
   _jsyRemote.setTab(_hardwareConfigTab);
   _zcd.setTab(_hardwareConfigTab);
-  _victron.setTab(_hardwareConfigTab);
-  _victronServer.setTab(_hardwareConfigTab);
-  _victronPort.setTab(_hardwareConfigTab);
+  _modbusMeter.setTab(_hardwareConfigTab);
+  _modbusMeterModel.setTab(_hardwareConfigTab);
+  _modbusMeterServer.setTab(_hardwareConfigTab);
+  _modbusMeterPort.setTab(_hardwareConfigTab);
+  _httpMeter.setTab(_hardwareConfigTab);
+  _httpMeterModel.setTab(_hardwareConfigTab);
+  _httpMeterServer.setTab(_hardwareConfigTab);
+  _httpMeterPort.setTab(_hardwareConfigTab);
 
   _boolConfig(_jsy, KEY_ENABLE_JSY);
   _boolConfig(_jsyRemote, KEY_ENABLE_JSY_REMOTE);
   _boolConfig(_zcd, KEY_ENABLE_ZCD);
-  _boolConfig(_victron, KEY_ENABLE_VICTRON_MODBUS);
-  _textConfig(_victronServer, KEY_VICTRON_MODBUS_SERVER);
-  _numConfig(_victronPort, KEY_VICTRON_MODBUS_PORT);
+  _boolConfig(_modbusMeter, KEY_ENABLE_MODBUS_METER);
+  _textConfig(_modbusMeterModel, KEY_MODBUS_METER_MODEL);
+  _textConfig(_modbusMeterServer, KEY_MODBUS_METER_SERVER);
+  _numConfig(_modbusMeterPort, KEY_MODBUS_METER_PORT);
+  _boolConfig(_httpMeter, KEY_ENABLE_HTTP_METER);
+  _textConfig(_httpMeterModel, KEY_HTTP_METER_MODEL);
+  _textConfig(_httpMeterServer, KEY_HTTP_METER_SERVER);
+  _numConfig(_httpMeterPort, KEY_HTTP_METER_PORT);
 
   _gridFreq.onChange([](const char* value) {
     if (strcmp(value, "50 Hz") == 0)
@@ -818,7 +881,9 @@ void YaSolR::Website::begin() {
   // output 1 ds18
   _output1DS18.setTab(_hardwareConfigTab);
   _output1DS18.setSize(FULL_SIZE);
+  _output1DS18Resolution.setTab(_hardwareConfigTab);
   _boolConfig(_output1DS18, KEY_ENABLE_OUTPUT1_DS18);
+  _numConfig(_output1DS18Resolution, KEY_OUTPUT1_DS18_RESOLUTION);
 
   // output 2 dimmer
   _output2Dimmer.setTab(_hardwareConfigTab);
@@ -842,7 +907,9 @@ void YaSolR::Website::begin() {
   // output 2 ds18
   _output2DS18.setTab(_hardwareConfigTab);
   _output2DS18.setSize(FULL_SIZE);
+  _output2DS18Resolution.setTab(_hardwareConfigTab);
   _boolConfig(_output2DS18, KEY_ENABLE_OUTPUT2_DS18);
+  _numConfig(_output2DS18Resolution, KEY_OUTPUT2_DS18_RESOLUTION);
 
   // relay1
   _relay1.setTab(_hardwareConfigTab);
@@ -865,7 +932,9 @@ void YaSolR::Website::begin() {
   // router ds18
   _routerDS18.setTab(_hardwareConfigTab);
   _routerDS18.setSize(FULL_SIZE);
+  _routerDS18Resolution.setTab(_hardwareConfigTab);
   _boolConfig(_routerDS18, KEY_ENABLE_DS18_SYSTEM);
+  _numConfig(_routerDS18Resolution, KEY_DS18_SYSTEM_RESOLUTION);
 
   // router led
   _led.setTab(_hardwareConfigTab);
@@ -934,16 +1003,130 @@ void YaSolR::Website::begin() {
   _daysConfig(_output2AutoStartWDays, KEY_OUTPUT2_DAYS);
 #endif
 
+  invalidateAll();
   initCards();
   updateCards();
 }
 
+void YaSolR::Website::invalidate(std::initializer_list<Section> sections) {
+  for (Section section : sections)
+    _generations[static_cast<size_t>(section)]++;
+}
+
+void YaSolR::Website::invalidate(const char* key) {
+  const std::string k = key;
+  if (k.rfind("o1_", 0) == 0)
+    invalidate({Section::STATISTICS, Section::TABS, Section::OUTPUT1, Section::SYSTEM, Section::MQTT, Section::HARDWARE, Section::OUTPUT1_CONFIG});
+  else if (k.rfind("o2_", 0) == 0)
+    invalidate({Section::STATISTICS, Section::TABS, Section::OUTPUT2, Section::SYSTEM, Section::MQTT, Section::HARDWARE, Section::OUTPUT2_CONFIG});
+  else if (k.rfind("relay", 0) == 0)
+    invalidate({Section::STATISTICS, Section::TABS, Section::RELAYS, Section::HARDWARE});
+  else if (k.rfind("pin_", 0) == 0 || k == KEY_JSY_UART || k == KEY_PZEM_UART)
+    invalidate({Section::GPIO});
+  else if (k.rfind("mqtt_", 0) == 0 || k.rfind("ha_disco_", 0) == 0 || k == KEY_GRID_POWER_MQTT_TOPIC || k == KEY_GRID_VOLTAGE_MQTT_TOPIC)
+    invalidate({Section::MQTT});
+  else if (k.rfind("pid_", 0) == 0)
+    invalidate({Section::PID});
+  else if (k.rfind("net_", 0) == 0 || k.rfind("wifi_", 0) == 0 || k == KEY_ADMIN_PASSWORD || k == KEY_ENABLE_AP_MODE)
+    invalidate({Section::NETWORK});
+  else if (k.rfind("ntp_", 0) == 0)
+    invalidate({Section::NTP});
+  else if (k == KEY_ENABLE_DEBUG)
+    invalidate({Section::DEBUG});
+  else if (k == KEY_ENABLE_JSY)
+    invalidate({Section::SYSTEM, Section::HARDWARE, Section::OUTPUT1_CONFIG, Section::OUTPUT2_CONFIG});
+  else if (k == KEY_ENABLE_JSY_REMOTE)
+    invalidate({Section::STATISTICS, Section::HARDWARE});
+  else if (k.rfind("disp_", 0) == 0 || k.rfind("http_mt_", 0) == 0 || k.rfind("vic_mb_", 0) == 0 || k == KEY_GRID_FREQUENCY || k == KEY_ENABLE_LIGHTS || k == KEY_ENABLE_ZCD || k == KEY_ENABLE_DS18_SYSTEM || k == KEY_DS18_SYSTEM_RESOLUTION)
+    invalidate({Section::HARDWARE});
+  else
+    invalidateAll();
+}
+
+void YaSolR::Website::invalidateAll() {
+  for (auto& generation : _generations)
+    generation++;
+}
+
 void YaSolR::Website::initCards() {
-  logger.info(TAG, "Initialize dashboard cards");
+  static const char* names[] = {"statistics", "home", "tabs", "output 1", "output 2", "relays", "system", "debug", "network", "ntp", "mqtt", "pid", "gpio", "hardware", "output 1 config", "output 2 config"};
+
+  std::string initialized;
+  for (size_t i = 0; i < static_cast<size_t>(Section::COUNT); i++) {
+    // a section invalidated while being initialized keeps a newer generation and is initialized again on next call
+    const uint32_t generation = _generations[i];
+    if (generation == _initialized[i])
+      continue;
+    _initSection(static_cast<Section>(i));
+    _initialized[i] = generation;
+    if (!initialized.empty())
+      initialized += ", ";
+    initialized += names[i];
+  }
 
-  const Mycila::ESPConnect::Mode mode = espConnect.getMode();
+  if (!initialized.empty())
+    logger.info(TAG, "Initialize dashboard cards: %s", initialized.c_str());
+}
 
-  // statistics
+void YaSolR::Website::_initSection(Section section) {
+  switch (section) {
+    case Section::STATISTICS:
+      _initStatistics();
+      break;
+    case Section::HOME:
+      _initHome();
+      break;
+#ifdef APP_MODEL_PRO
+    case Section::TABS:
+      _initTabs();
+      break;
+    case Section::OUTPUT1:
+      _initOutput1();
+      break;
+    case Section::OUTPUT2:
+      _initOutput2();
+      break;
+    case Section::RELAYS:
+      _initRelays();
+      break;
+    case Section::SYSTEM:
+      _initSystem();
+      break;
+    case Section::DEBUG:
+      _initDebug();
+      break;
+    case Section::NETWORK:
+      _initNetwork();
+      break;
+    case Section::NTP:
+      _initNTP();
+      break;
+    case Section::MQTT:
+      _initMQTT();
+      break;
+    case Section::PID:
+      _initPID();
+      break;
+    case Section::GPIO:
+      _initGPIO();
+      break;
+    case Section::HARDWARE:
+      _initHardware();
+      break;
+    case Section::OUTPUT1_CONFIG:
+      _initOutput1Config();
+      break;
+    case Section::OUTPUT2_CONFIG:
+      _initOutput2Config();
+      break;
+#endif
+    default:
+      break;
+  }
+}
+
+void YaSolR::Website::_initStatistics() {
+  const Mycila::ESPConnect::Mode mode = espConnect.getMode();
 
   _appName.setValue(Mycila::AppInfo.name.c_str());
   _appModel.setValue(Mycila::AppInfo.model.c_str());
@@ -984,8 +1167,23 @@ void YaSolR::Website::initCards() {
       break;
   }
 
-  // home
+#ifdef APP_MODEL_PRO
+  _udpMessageRateBuffer.setDisplay(config.getBool(KEY_ENABLE_JSY_REMOTE));
+  _networkAPIP.setDisplay(mode == Mycila::ESPConnect::Mode::AP);
+  _networkAPMAC.setDisplay(mode == Mycila::ESPConnect::Mode::AP);
+  _networkEthIP.setDisplay(mode == Mycila::ESPConnect::Mode::ETH);
+  _networkEthMAC.setDisplay(mode == Mycila::ESPConnect::Mode::ETH);
+  _networkWiFiIP.setDisplay(mode == Mycila::ESPConnect::Mode::STA);
+  _networkWiFiMAC.setDisplay(mode == Mycila::ESPConnect::Mode::STA);
+  _networkWiFiSSID.setDisplay(mode == Mycila::ESPConnect::Mode::STA);
+  _output1RelaySwitchCount.setDisplay(output1 && output1->isBypassRelayEnabled());
+  _output2RelaySwitchCount.setDisplay(output2 && output2->isBypassRelayEnabled());
+  _relay1SwitchCount.setDisplay(relay1 && relay1->isEnabled());
+  _relay2SwitchCount.setDisplay(relay2 && relay2->isEnabled());
+#endif
+}
 
+void YaSolR::Website::_initHome() {
   if (!output1) {
     // initialize values for OSS components which cannot be hidden
     _output1State.setFeedback("DISABLED", dash::Status::IDLE);
@@ -1001,60 +1199,33 @@ void YaSolR::Website::initCards() {
     _output2DimmerSlider.setValue(0);
     _output2Bypass.setValue(false);
   }
+}
 
 #ifdef APP_MODEL_PRO
-  const bool debugEnabled = config.getBool(KEY_ENABLE_DEBUG);
-  const bool jsyEnabled = config.getBool(KEY_ENABLE_JSY);
-  const bool mqttEnabled = config.getBool(KEY_ENABLE_MQTT);
-  const bool pidViewEnabled = realTimePIDEnabled();
-  const bool displayEnabled = config.getBool(KEY_ENABLE_DISPLAY);
-  const bool serverCertExists = LittleFS.exists(YASOLR_MQTT_SERVER_CERT_FILE);
-
+void YaSolR::Website::_initTabs() {
   const bool dimmer1Enabled = config.getBool(KEY_ENABLE_OUTPUT1_DIMMER);
   const bool output1RelayEnabled = config.getBool(KEY_ENABLE_OUTPUT1_RELAY);
-  const bool bypass1Possible = dimmer1Enabled || output1RelayEnabled;
-  const bool autoDimmer1Activated = config.getBool(KEY_ENABLE_OUTPUT1_AUTO_DIMMER);
-  const bool autoBypass1Activated = config.getBool(KEY_ENABLE_OUTPUT1_AUTO_BYPASS);
   const bool output1TempReceived = output1 && !output1->temperature().neverUpdated();
-  const bool pzem1Enabled = config.getBool(KEY_ENABLE_OUTPUT1_PZEM);
-
   const bool dimmer2Enabled = config.getBool(KEY_ENABLE_OUTPUT2_DIMMER);
   const bool output2RelayEnabled = config.getBool(KEY_ENABLE_OUTPUT2_RELAY);
-  const bool bypass2Possible = dimmer2Enabled || output2RelayEnabled;
-  const bool autoDimmer2Activated = config.getBool(KEY_ENABLE_OUTPUT2_AUTO_DIMMER);
-  const bool autoBypass2Activated = config.getBool(KEY_ENABLE_OUTPUT2_AUTO_BYPASS);
   const bool output2TempReceived = output2 && !output2->temperature().neverUpdated();
-  const bool pzem2Enabled = config.getBool(KEY_ENABLE_OUTPUT2_PZEM);
-
   const bool relay1Enabled = config.getBool(KEY_ENABLE_RELAY1);
   const bool relay2Enabled = config.getBool(KEY_ENABLE_RELAY2);
-  const uint16_t load1 = config.getInt(KEY_RELAY1_LOAD);
-  const uint16_t load2 = config.getInt(KEY_RELAY2_LOAD);
-
-  // statistics
-
-  _udpMessageRateBuffer.setDisplay(config.getBool(KEY_ENABLE_JSY_REMOTE));
-  _networkAPIP.setDisplay(mode == Mycila::ESPConnect::Mode::AP);
-  _networkAPMAC.setDisplay(mode == Mycila::ESPConnect::Mode::AP);
-  _networkEthIP.setDisplay(mode == Mycila::ESPConnect::Mode::ETH);
-  _networkEthMAC.setDisplay(mode == Mycila::ESPConnect::Mode::ETH);
-  _networkWiFiIP.setDisplay(mode == Mycila::ESPConnect::Mode::STA);
-  _networkWiFiMAC.setDisplay(mode == Mycila::ESPConnect::Mode::STA);
-  _networkWiFiSSID.setDisplay(mode == Mycila::ESPConnect::Mode::STA);
-  _output1RelaySwitchCount.setDisplay(output1 && output1->isBypassRelayEnabled());
-  _output2RelaySwitchCount.setDisplay(output2 && output2->isBypassRelayEnabled());
-  _relay1SwitchCount.setDisplay(relay1 && relay1->isEnabled());
-  _relay2SwitchCount.setDisplay(relay2 && relay2->isEnabled());
-
-  // tabs
 
   _output1Tab.setDisplay(dimmer1Enabled || output1RelayEnabled || output1TempReceived);
   _output2Tab.setDisplay(dimmer2Enabled || output2RelayEnabled || output2TempReceived);
   _relaysTab.setDisplay(relay1Enabled || relay2Enabled);
   _output1ConfigTab.setDisplay(dimmer1Enabled || output1RelayEnabled);
   _output2ConfigTab.setDisplay(dimmer2Enabled || output2RelayEnabled);
+}
 
-  // tab: output 1
+void YaSolR::Website::_initOutput1() {
+  const bool dimmer1Enabled = config.getBool(KEY_ENABLE_OUTPUT1_DIMMER);
+  const bool output1RelayEnabled = config.getBool(KEY_ENABLE_OUTPUT1_RELAY);
+  const bool bypass1Possible = dimmer1Enabled || output1RelayEnabled;
+  const bool autoDimmer1Activated = config.getBool(KEY_ENABLE_OUTPUT1_AUTO_DIMMER);
+  const bool autoBypass1Activated = config.getBool(KEY_ENABLE_OUTPUT1_AUTO_BYPASS);
+  const bool pzem1Enabled = config.getBool(KEY_ENABLE_OUTPUT1_PZEM);
 
   _output1DimmerAuto.setValue(autoDimmer1Activated);
   _output1BypassAuto.setValue(autoBypass1Activated);
@@ -1086,8 +1257,15 @@ void YaSolR::Website::initCards() {
   _output1BypassAuto.setDisplay(bypass1Possible);
   _output1Bypass.setDisplay(bypass1Possible && !autoBypass1Activated);
   _output1BypassRO.setDisplay(bypass1Possible && autoBypass1Activated);
+}
 
-  // tab: output 2
+void YaSolR::Website::_initOutput2() {
+  const bool dimmer2Enabled = config.getBool(KEY_ENABLE_OUTPUT2_DIMMER);
+  const bool output2RelayEnabled = config.getBool(KEY_ENABLE_OUTPUT2_RELAY);
+  const bool bypass2Possible = dimmer2Enabled || output2RelayEnabled;
+  const bool autoDimmer2Activated = config.getBool(KEY_ENABLE_OUTPUT2_AUTO_DIMMER);
+  const bool autoBypass2Activated = config.getBool(KEY_ENABLE_OUTPUT2_AUTO_BYPASS);
+  const bool pzem2Enabled = config.getBool(KEY_ENABLE_OUTPUT2_PZEM);
 
   _output2DimmerAuto.setValue(autoDimmer2Activated);
   _output2BypassAuto.setValue(autoBypass2Activated);
@@ -1119,15 +1297,24 @@ void YaSolR::Website::initCards() {
   _output2BypassAuto.setDisplay(bypass2Possible);
   _output2Bypass.setDisplay(bypass2Possible && !autoBypass2Activated);
   _output2BypassRO.setDisplay(bypass2Possible && autoBypass2Activated);
+}
 
-  // tab: relays
+void YaSolR::Website::_initRelays() {
+  const bool relay1Enabled = config.getBool(KEY_ENABLE_RELAY1);
+  const bool relay2Enabled = config.getBool(KEY_ENABLE_RELAY2);
+  const uint16_t load1 = config.getInt(KEY_RELAY1_LOAD);
+  const uint16_t load2 = config.getInt(KEY_RELAY2_LOAD);
 
   _relay1Switch.setDisplay(relay1Enabled && load1 <= 0);
   _relay1SwitchRO.setDisplay(relay1Enabled && load1 > 0);
   _relay2Switch.setDisplay(relay2Enabled && load2 <= 0);
   _relay2SwitchRO.setDisplay(relay2Enabled && load2 > 0);
+}
 
-  // tab: system
+void YaSolR::Website::_initSystem() {
+  const bool jsyEnabled = config.getBool(KEY_ENABLE_JSY);
+  const bool pzem1Enabled = config.getBool(KEY_ENABLE_OUTPUT1_PZEM);
+  const bool pzem2Enabled = config.getBool(KEY_ENABLE_OUTPUT2_PZEM);
 
   _configBackup.setValue("/api/config/backup");
   _configRestore.setValue("/api/config/restore");
@@ -1135,8 +1322,10 @@ void YaSolR::Website::initCards() {
   _energyReset.setDisplay(jsyEnabled || pzem1Enabled || pzem2Enabled);
   _safebootUpload.setDisplay(true);
   _safebootUploadStatus.setDisplay(false);
+}
 
-  // tab: debug
+void YaSolR::Website::_initDebug() {
+  const bool debugEnabled = config.getBool(KEY_ENABLE_DEBUG);
 
   _status(_debugMode, KEY_ENABLE_DEBUG, logger.isDebugEnabled());
   _debugInfo.setValue("/api/debug");
@@ -1146,9 +1335,9 @@ void YaSolR::Website::initCards() {
   _debugInfo.setDisplay(debugEnabled);
   _startupLogs.setDisplay(debugEnabled);
   _consoleLink.setDisplay(debugEnabled);
+}
 
-  // tab: network
-
+void YaSolR::Website::_initNetwork() {
   _adminPwd.setValue(config.get(KEY_ADMIN_PASSWORD));
   _wifiSSID.setValue(config.get(KEY_WIFI_SSID));
   _wifiPwd.setValue(config.get(KEY_WIFI_PASSWORD));
@@ -1157,13 +1346,16 @@ void YaSolR::Website::initCards() {
   _subnetMask.setValue(config.get(KEY_NET_SUBNET));
   _gateway.setValue(config.get(KEY_NET_GATEWAY));
   _dnsServer.setValue(config.get(KEY_NET_DNS));
+}
 
-  // tab: ntp
-
+void YaSolR::Website::_initNTP() {
   _ntpServer.setValue(config.get(KEY_NTP_SERVER));
   _ntpTimezone.setValue(config.get(KEY_NTP_TIMEZONE));
+}
 
-  // tab: mqtt
+void YaSolR::Website::_initMQTT() {
+  const bool mqttEnabled = config.getBool(KEY_ENABLE_MQTT);
+  const bool serverCertExists = LittleFS.exists(YASOLR_MQTT_SERVER_CERT_FILE);
 
   _mqttServer.setValue(config.get(KEY_MQTT_SERVER));
   _mqttServer.setDisplay(mqttEnabled);
@@ -1195,8 +1387,10 @@ void YaSolR::Website::initCards() {
   _haDiscovery.setDisplay(mqttEnabled);
   _haDiscoveryTopic.setValue(config.get(KEY_HA_DISCOVERY_TOPIC));
   _haDiscoveryTopic.setDisplay(mqttEnabled && config.getBool(KEY_ENABLE_HA_DISCOVERY));
+}
 
-  // tab: pid
+void YaSolR::Website::_initPID() {
+  const bool pidViewEnabled = realTimePIDEnabled();
 
   switch (config.getInt(KEY_PID_P_MODE)) {
     case 1:
@@ -1254,9 +1448,9 @@ void YaSolR::Website::initCards() {
   _pidPTermHistory.setDisplay(pidViewEnabled);
   _pidITermHistory.setDisplay(pidViewEnabled);
   _pidDTermHistory.setDisplay(pidViewEnabled);
+}
 
-  // tab: gpio
-
+void YaSolR::Website::_initGPIO() {
   std::unordered_map<int32_t, dash::FeedbackTextInputCard<int32_t>*> pinout = {};
   _pinout(_pinDimmerO1, KEY_PIN_OUTPUT1_DIMMER, pinout);
   _pinout(_pinDS18O1, KEY_PIN_OUTPUT1_DS18, pinout);
@@ -1280,8 +1474,20 @@ void YaSolR::Website::initCards() {
 
   _serialJsy.setValue(config.get(KEY_JSY_UART));
   _serialPZEM.setValue(config.get(KEY_PZEM_UART));
+}
 
-  // tab: hardware
+void YaSolR::Website::_initHardware() {
+  const bool displayEnabled = config.getBool(KEY_ENABLE_DISPLAY);
+  const bool dimmer1Enabled = config.getBool(KEY_ENABLE_OUTPUT1_DIMMER);
+  const bool output1RelayEnabled = config.getBool(KEY_ENABLE_OUTPUT1_RELAY);
+  const bool pzem1Enabled = config.getBool(KEY_ENABLE_OUTPUT1_PZEM);
+  const bool dimmer2Enabled = config.getBool(KEY_ENABLE_OUTPUT2_DIMMER);
+  const bool output2RelayEnabled = config.getBool(KEY_ENABLE_OUTPUT2_RELAY);
+  const bool pzem2Enabled = config.getBool(KEY_ENABLE_OUTPUT2_PZEM);
+  const bool relay1Enabled = config.getBool(KEY_ENABLE_RELAY1);
+  const bool relay2Enabled = config.getBool(KEY_ENABLE_RELAY2);
+  const uint16_t load1 = config.getInt(KEY_RELAY1_LOAD);
+  const uint16_t load2 = config.getInt(KEY_RELAY2_LOAD);
 
   // grid
   switch (config.getInt(KEY_GRID_FREQUENCY)) {
@@ -1296,8 +1502,12 @@ void YaSolR::Website::initCards() {
       break;
   }
   _status(_jsyRemote, KEY_ENABLE_JSY_REMOTE, udp && udp->connected(), YASOLR_LBL_113);
-  _victronServer.setValue(config.get(KEY_VICTRON_MODBUS_SERVER));
-  _victronPort.setValue(config.getInt(KEY_VICTRON_MODBUS_PORT));
+  _modbusMeterModel.setValue(config.get(KEY_MODBUS_METER_MODEL));
+  _modbusMeterServer.setValue(config.get(KEY_MODBUS_METER_SERVER));
+  _modbusMeterPort.setValue(config.getInt(KEY_MODBUS_METER_PORT));
+  _httpMeterModel.setValue(config.get(KEY_HTTP_METER_MODEL));
+  _httpMeterServer.setValue(config.get(KEY_HTTP_METER_SERVER));
+  _httpMeterPort.setValue(config.getInt(KEY_HTTP_METER_PORT));
 
   // output 1 dimmer
   _output1DimmerType.setValue(config.get(KEY_OUTPUT1_DIMMER_TYPE));
@@ -1312,6 +1522,10 @@ void YaSolR::Website::initCards() {
   _output1RelayType.setValue(config.get(KEY_OUTPUT1_RELAY_TYPE));
   _output1RelayType.setDisplay(output1RelayEnabled);
 
+  // output 1 ds18
+  _output1DS18Resolution.setValue(config.getInt(KEY_OUTPUT1_DS18_RESOLUTION));
+  _output1DS18Resolution.setDisplay(config.getBool(KEY_ENABLE_OUTPUT1_DS18));
+
   // output 2 dimmer
   _output2DimmerType.setValue(config.get(KEY_OUTPUT2_DIMMER_TYPE));
   _output2DimmerType.setDisplay(dimmer2Enabled);
@@ -1325,6 +1539,10 @@ void YaSolR::Website::initCards() {
   _output2RelayType.setValue(config.get(KEY_OUTPUT2_RELAY_TYPE));
   _output2RelayType.setDisplay(output2RelayEnabled);
 
+  // output 2 ds18
+  _output2DS18Resolution.setValue(config.getInt(KEY_OUTPUT2_DS18_RESOLUTION));
+  _output2DS18Resolution.setDisplay(config.getBool(KEY_ENABLE_OUTPUT2_DS18));
+
   // relay1
   _status(_relay1, KEY_ENABLE_RELAY1, relay1 && relay1->isEnabled());
   _relay1Type.setValue(config.get(KEY_RELAY1_TYPE));
@@ -1339,6 +1557,10 @@ void YaSolR::Website::initCards() {
   _relay2Load.setValue(load2);
   _relay2Load.setDisplay(relay2Enabled);
 
+  // router ds18
+  _routerDS18Resolution.setValue(config.getInt(KEY_DS18_SYSTEM_RESOLUTION));
+  _routerDS18Resolution.setDisplay(config.getBool(KEY_ENABLE_DS18_SYSTEM));
+
   // router led
   _status(_led, KEY_ENABLE_LIGHTS, lights.isEnabled());
 
@@ -1350,8 +1572,14 @@ void YaSolR::Website::initCards() {
   _displayRotation.setDisplay(displayEnabled);
   _displaySpeed.setValue(config.getInt(KEY_DISPLAY_SPEED));
   _displaySpeed.setDisplay(displayEnabled);
+}
 
-  // tab: output 1 config
+void YaSolR::Website::_initOutput1Config() {
+  const bool jsyEnabled = config.getBool(KEY_ENABLE_JSY);
+  const bool dimmer1Enabled = config.getBool(KEY_ENABLE_OUTPUT1_DIMMER);
+  const bool output1RelayEnabled = config.getBool(KEY_ENABLE_OUTPUT1_RELAY);
+  const bool bypass1Possible = dimmer1Enabled || output1RelayEnabled;
+  const bool pzem1Enabled = config.getBool(KEY_ENABLE_OUTPUT1_PZEM);
 
   _output1ConfigSep0.setDisplay(dimmer1Enabled);
   _output1ResistanceInput.setValue(config.getFloat(KEY_OUTPUT1_RESISTANCE));
@@ -1376,8 +1604,14 @@ void YaSolR::Website::initCards() {
   _output1AutoStoptTime.setDisplay(bypass1Possible);
   _output1AutoStartWDays.setValue(config.isEqual(KEY_OUTPUT1_DAYS, YASOLR_WEEK_DAYS_EMPTY) ? "" : config.get(KEY_OUTPUT1_DAYS));
   _output1AutoStartWDays.setDisplay(bypass1Possible);
+}
 
-  // tab: output 2 config
+void YaSolR::Website::_initOutput2Config() {
+  const bool jsyEnabled = config.getBool(KEY_ENABLE_JSY);
+  const bool dimmer2Enabled = config.getBool(KEY_ENABLE_OUTPUT2_DIMMER);
+  const bool output2RelayEnabled = config.getBool(KEY_ENABLE_OUTPUT2_RELAY);
+  const bool bypass2Possible = dimmer2Enabled || output2RelayEnabled;
+  const bool pzem2Enabled = config.getBool(KEY_ENABLE_OUTPUT2_PZEM);
 
   _output2ConfigSep0.setDisplay(dimmer2Enabled);
   _output2ResistanceInput.setValue(config.getFloat(KEY_OUTPUT2_RESISTANCE));
@@ -1402,52 +1636,52 @@ void YaSolR::Website::initCards() {
   _output2AutoStoptTime.setDisplay(bypass2Possible);
   _output2AutoStartWDays.setValue(config.isEqual(KEY_OUTPUT2_DAYS, YASOLR_WEEK_DAYS_EMPTY) ? "" : config.get(KEY_OUTPUT2_DAYS));
   _output2AutoStartWDays.setDisplay(bypass2Possible);
-#endif
 }
+#endif
 
 void YaSolR::Website::updateCards() {
   // metrics
 
   Mycila::Grid::Metrics* gridMetrics = new Mycila::Grid::Metrics();
   grid.getGridMeasurements(*gridMetrics);
-  _gridEnergy.setValue(gridMetrics->energy);
-  _gridEnergyReturned.setValue(gridMetrics->energyReturned);
-  _routerVoltage.setValue(gridMetrics->voltage);
-  _gridPower.setValue(gridMetrics->power);
+  _setChanged(_gridEnergy, gridMetrics->energy);
+  _setChanged(_gridEnergyReturned, gridMetrics->energyReturned);
+  _setQuantized(_routerVoltage, gridMetrics->voltage, YASOLR_DASH_STEP_VOLTAGE);
+  _setQuantized(_gridPower, gridMetrics->power, YASOLR_DASH_STEP_POWER);
   delete gridMetrics;
   gridMetrics = nullptr;
 
   Mycila::Router::Metrics* routerMetrics = new Mycila::Router::Metrics();
   router.getRouterMeasurements(*routerMetrics);
-  _routerPower.setValue(routerMetrics->power);
-  _routerApparentPower.setValue(routerMetrics->apparentPower);
-  _routerPowerFactor.setValue(routerMetrics->powerFactor);
-  _routerTHDi.setValue(routerMetrics->thdi);
-  _routerCurrent.setValue(routerMetrics->current);
-  _routerResistance.setValue(routerMetrics->resistance);
-  _routerEnergy.setValue(routerMetrics->energy);
+  _setQuantized(_routerPower, routerMetrics->power, YASOLR_DASH_STEP_POWER);
+  _setQuantized(_routerApparentPower, routerMetrics->apparentPower, YASOLR_DASH_STEP_POWER);
+  _setQuantized(_routerPowerFactor, routerMetrics->powerFactor, YASOLR_DASH_STEP_RATIO);
+  _setQuantized(_routerTHDi, routerMetrics->thdi, YASOLR_DASH_STEP_PERCENT);
+  _setQuantized(_routerCurrent, routerMetrics->current, YASOLR_DASH_STEP_CURRENT);
+  _setQuantized(_routerResistance, routerMetrics->resistance, YASOLR_DASH_STEP_RESISTANCE);
+  _setChanged(_routerEnergy, routerMetrics->energy);
   delete routerMetrics;
   routerMetrics = nullptr;
 
   Mycila::System::Memory* memory = new Mycila::System::Memory();
   Mycila::System::getMemory(*memory);
-  _deviceHeapTotal.setValue(memory->total);
-  _deviceHeapUsed.setValue(memory->used);
-  _deviceHeapUsage.setValue(memory->usage);
-  _deviceHeapMinFree.setValue(memory->minimumFree);
+  _setChanged(_deviceHeapTotal, memory->total);
+  _setChanged(_deviceHeapUsed, memory->used);
+  _setQuantized(_deviceHeapUsage, memory->usage, YASOLR_DASH_STEP_PERCENT);
+  _setChanged(_deviceHeapMinFree, memory->minimumFree);
   delete memory;
   memory = nullptr;
 
   // statistics
 
-  _gridFrequency.setValue(yasolr_frequency());
-  _udpMessageRateBuffer.setValue(udpMessageRateBuffer ? udpMessageRateBuffer->rate() : 0);
-  _networkWiFiRSSI.setValue(espConnect.getWiFiRSSI());
-  _networkWiFiSignal.setValue(espConnect.getWiFiSignalQuality());
-  _output1RelaySwitchCount.setValue(output1 ? output1->getBypassRelaySwitchCount() : 0);
-  _output2RelaySwitchCount.setValue(output2 ? output2->getBypassRelaySwitchCount() : 0);
-  _relay1SwitchCount.setValue(relay1 ? relay1->getSwitchCount() : 0);
-  _relay2SwitchCount.setValue(relay2 ? relay2->getSwitchCount() : 0);
+  _setQuantized(_gridFrequency, yasolr_frequency(), YASOLR_DASH_STEP_FREQUENCY);
+  _setChanged(_udpMessageRateBuffer, udpMessageRateBuffer ? udpMessageRateBuffer->rate() : 0);
+  _setChanged(_networkWiFiRSSI, espConnect.getWiFiRSSI());
+  _setChanged(_networkWiFiSignal, espConnect.getWiFiSignalQuality());
+  _setChanged(_output1RelaySwitchCount, output1 ? output1->getBypassRelaySwitchCount() : 0);
+  _setChanged(_output2RelaySwitchCount, output2 ? output2->getBypassRelaySwitchCount() : 0);
+  _setChanged(_relay1SwitchCount, relay1 ? relay1->getSwitchCount() : 0);
+  _setChanged(_relay2SwitchCount, relay2 ? relay2->getSwitchCount() : 0);
   _time.setValue(Mycila::Time::getLocalStr());
   _uptime.setValue(Mycila::Time::toDHHMMSS(Mycila::System::getUptime()));
 #ifdef APP_MODEL_TRIAL
@@ -1456,9 +1690,9 @@ void YaSolR::Website::updateCards() {
 
   // home
 
-  _routerDS18State.setValue(ds18Sys ? ds18Sys->getTemperature().value_or(0.0f) : 0);
-  _relay1Switch.setValue(relay1 && relay1->isOn());
-  _relay2Switch.setValue(relay2 && relay2->isOn());
+  _setQuantized(_routerDS18State, ds18Sys ? ds18Sys->getTemperature().value_or(0.0f) : 0, YASOLR_DASH_STEP_TEMPERATURE);
+  _setChanged(_relay1Switch, relay1 && relay1->isOn());
+  _setChanged(_relay2Switch, relay2 && relay2->isOn());
 
   if (output1) {
     switch (output1->getState()) {
@@ -1477,9 +1711,9 @@ void YaSolR::Website::updateCards() {
         _output1State.setFeedback(YASOLR_LBL_109, dash::Status::DANGER);
         break;
     }
-    _output1DS18State.setValue(output1->temperature().orElse(NAN));
-    _output1DimmerSlider.setValue(output1->getDimmerDutyCycle() * 100.0f);
-    _output1Bypass.setValue(output1->isBypassOn());
+    _setQuantized(_output1DS18State, output1->temperature().orElse(NAN), YASOLR_DASH_STEP_TEMPERATURE);
+    _setQuantized(_output1DimmerSlider, output1->getDimmerDutyCycle() * 100.0f, YASOLR_DASH_STEP_PERCENT);
+    _setChanged(_output1Bypass, output1->isBypassOn());
   }
 
   if (output2) {
@@ -1499,15 +1733,15 @@ void YaSolR::Website::updateCards() {
         _output2State.setFeedback(YASOLR_LBL_109, dash::Status::DANGER);
         break;
     }
-    _output2DS18State.setValue(output2->temperature().orElse(NAN));
-    _output2DimmerSlider.setValue(output2->getDimmerDutyCycle() * 100.0f);
-    _output2Bypass.setValue(output2->isBypassOn());
+    _setQuantized(_output2DS18State, output2->temperature().orElse(NAN), YASOLR_DASH_STEP_TEMPERATURE);
+    _setQuantized(_output2DimmerSlider, output2->getDimmerDutyCycle() * 100.0f, YASOLR_DASH_STEP_PERCENT);
+    _setChanged(_output2Bypass, output2->isBypassOn());
   }
 
-  _output1PZEMSync.setValue(pzemO1PairingTask && pzemO1PairingTask->scheduled());
-  _output2PZEMSync.setValue(pzemO2PairingTask && pzemO2PairingTask->scheduled());
-  _output1ResistanceCalibration.setValue(router.isCalibrationRunning());
-  _output2ResistanceCalibration.setValue(router.isCalibrationRunning());
+  _setChanged(_output1PZEMSync, pzemO1PairingTask && pzemO1PairingTask->scheduled());
+  _setChanged(_output2PZEMSync, pzemO2PairingTask && pzemO2PairingTask->scheduled());
+  _setChanged(_output1ResistanceCalibration, router.isCalibrationRunning());
+  _setChanged(_output2ResistanceCalibration, router.isCalibrationRunning());
 
 #ifdef APP_MODEL_PRO
   // tab: output 1
@@ -1516,15 +1750,15 @@ void YaSolR::Website::updateCards() {
     Mycila::RouterOutput::Metrics output1Measurements;
     output1->getOutputMeasurements(output1Measurements);
 
-    _output1DimmerSliderRO.setValue(output1->getDimmerDutyCycleLive() * 100.0f);
-    _output1Power.setValue(output1Measurements.power);
-    _output1ApparentPower.setValue(output1Measurements.apparentPower);
-    _output1PowerFactor.setValue(output1Measurements.powerFactor);
-    _output1THDi.setValue(output1Measurements.thdi);
-    _output1Voltage.setValue(output1Measurements.dimmedVoltage);
-    _output1Current.setValue(output1Measurements.current);
-    _output1Resistance.setValue(output1Measurements.resistance);
-    _output1Energy.setValue(output1Measurements.energy);
+    _setQuantized(_output1DimmerSliderRO, output1->getDimmerDutyCycleLive() * 100.0f, YASOLR_DASH_STEP_PERCENT);
+    _setQuantized(_output1Power, output1Measurements.power, YASOLR_DASH_STEP_POWER);
+    _setQuantized(_output1ApparentPower, output1Measurements.apparentPower, YASOLR_DASH_STEP_POWER);
+    _setQuantized(_output1PowerFactor, output1Measurements.powerFactor, YASOLR_DASH_STEP_RATIO);
+    _setQuantized(_output1THDi, output1Measurements.thdi, YASOLR_DASH_STEP_PERCENT);
+    _setQuantized(_output1Voltage, output1Measurements.dimmedVoltage, YASOLR_DASH_STEP_VOLTAGE);
+    _setQuantized(_output1Current, output1Measurements.current, YASOLR_DASH_STEP_CURRENT);
+    _setQuantized(_output1Resistance, output1Measurements.resistance, YASOLR_DASH_STEP_RESISTANCE);
+    _setChanged(_output1Energy, output1Measurements.energy);
     _output1BypassRO.setFeedback(YASOLR_STATE(output1->isBypassOn()), output1->isBypassOn() ? dash::Status::SUCCESS : dash::Status::IDLE);
   }
 
@@ -1534,15 +1768,15 @@ void YaSolR::Website::updateCards() {
     Mycila::RouterOutput::Metrics output2Measurements;
     output2->getOutputMeasurements(output2Measurements);
 
-    _output2DimmerSliderRO.setValue(output2->getDimmerDutyCycleLive() * 100.0f);
-    _output2Power.setValue(output2Measurements.power);
-    _output2ApparentPower.setValue(output2Measurements.apparentPower);
-    _output2PowerFactor.setValue(output2Measurements.powerFactor);
-    _output2THDi.setValue(output2Measurements.thdi);
-    _output2Voltage.setValue(output2Measurements.dimmedVoltage);
-    _output2Current.setValue(output2Measurements.current);
-    _output2Resistance.setValue(output2Measurements.resistance);
-    _output2Energy.setValue(output2Measurements.energy);
+    _setQuantized(_output2DimmerSliderRO, output2->getDimmerDutyCycleLive() * 100.0f, YASOLR_DASH_STEP_PERCENT);
+    _setQuantized(_output2Power, output2Measurements.power, YASOLR_DASH_STEP_POWER);
+    _setQuantized(_output2ApparentPower, output2Measurements.apparentPower, YASOLR_DASH_STEP_POWER);
+    _setQuantized(_output2PowerFactor, output2Measurements.powerFactor, YASOLR_DASH_STEP_RATIO);
+    _setQuantized(_output2THDi, output2Measurements.thdi, YASOLR_DASH_STEP_PERCENT);
+    _setQuantized(_output2Voltage, output2Measurements.dimmedVoltage, YASOLR_DASH_STEP_VOLTAGE);
+    _setQuantized(_output2Current, output2Measurements.current, YASOLR_DASH_STEP_CURRENT);
+    _setQuantized(_output2Resistance, output2Measurements.resistance, YASOLR_DASH_STEP_RESISTANCE);
+    _setChanged(_output2Energy, output2Measurements.energy);
     _output2BypassRO.setFeedback(YASOLR_STATE(output2->isBypassOn()), output2->isBypassOn() ? dash::Status::SUCCESS : dash::Status::IDLE);
   }
 
@@ -1567,60 +1801,87 @@ void YaSolR::Website::updateCards() {
   _status(_output2PZEM, KEY_ENABLE_OUTPUT2_PZEM, pzemO2 && pzemO2->isEnabled(), pzemO2 && pzemO2->isConnected() && pzemO2->getDeviceAddress() == YASOLR_PZEM_ADDRESS_OUTPUT2, pzemO2 && pzemO2->isConnected() ? YASOLR_LBL_180 : YASOLR_LBL_110);
   _status(_output2DS18, KEY_ENABLE_OUTPUT2_DS18, ds18O2 && ds18O2->isEnabled(), ds18O2 && ds18O2->getLastTime() > 0, YASOLR_LBL_114);
   _status(_routerDS18, KEY_ENABLE_DS18_SYSTEM, ds18Sys && ds18Sys->isEnabled(), ds18Sys && ds18Sys->getLastTime() > 0, YASOLR_LBL_114);
-  _status(_victron, KEY_ENABLE_VICTRON_MODBUS, victron, victron && !victron->hasError(), victron && victron->hasError() ? "Com. Error" : "");
+  _status(_modbusMeter, KEY_ENABLE_MODBUS_METER, modbusMeter, modbusMeter && !modbusMeter->hasError(), modbusMeter && modbusMeter->hasError() ? "Com. Error" : "");
+  _status(_httpMeter, KEY_ENABLE_HTTP_METER, httpMeter, httpMeter && !httpMeter->hasError(), httpMeter && httpMeter->hasError() ? "Com. Error" : "");
 #endif
 }
 
-void YaSolR::Website::updateCharts() {
-  // shift array
-  memmove(&_gridPowerHistoryY[0], &_gridPowerHistoryY[1], sizeof(_gridPowerHistoryY) - sizeof(*_gridPowerHistoryY));
-  memmove(&_routedPowerHistoryY[0], &_routedPowerHistoryY[1], sizeof(_routedPowerHistoryY) - sizeof(*_routedPowerHistoryY));
-  memmove(&_routerTHDiHistoryY[0], &_routerTHDiHistoryY[1], sizeof(_routerTHDiHistoryY) - sizeof(*_routerTHDiHistoryY));
+// shifts the history and appends the new point. returns false if the history is unchanged (all the points equal to the new one).
+template <typename T, size_t N>
+static bool pushHistory(T (&history)[N], T value) {
+  bool changed = false;
+  for (size_t i = 0; i < N && !changed; i++)
+    changed = history[i] != value;
+  memmove(&history[0], &history[1], sizeof(history) - sizeof(*history));
+  history[N - 1] = value;
+  return changed;
+}
 
-  // set new value
-  _gridPowerHistoryY[YASOLR_GRAPH_POINTS - 1] = std::round(grid.getPower().orElse(0));
+// downsamples the selected range of the history into the chart points. returns false if the points are unchanged.
+template <typename T, typename S>
+static bool downsampleHistory(const S& series, ChartPoints<T>& points) {
+  ChartPoints<T> latest;
+  const size_t level = _chartRanges[_chartRangeIndex].level;
+  latest.size = series.downsample(level, _chartRanges[_chartRangeIndex].points, YASOLR_GRAPH_POINTS, latest.x, latest.y);
+  if (latest.size == points.size && memcmp(latest.x, points.x, latest.size * sizeof(*latest.x)) == 0 && memcmp(latest.y, points.y, latest.size * sizeof(*latest.y)) == 0)
+    return false;
+  points = latest;
+  return true;
+}
 
+void YaSolR::Website::updateHistory() {
   Mycila::Router::Metrics* routerMetrics = new Mycila::Router::Metrics();
   router.getRouterMeasurements(*routerMetrics);
-  _routedPowerHistoryY[YASOLR_GRAPH_POINTS - 1] = std::round(routerMetrics->power);
-  _routerTHDiHistoryY[YASOLR_GRAPH_POINTS - 1] = std::isnan(routerMetrics->thdi) ? 0 : std::round(routerMetrics->thdi);
+  _gridPowerSeries.add(std::round(grid.getPower().orElse(0)));
+  _routedPowerSeries.add(std::round(routerMetrics->power));
+  _routerTHDiSeries.add(std::isnan(routerMetrics->thdi) ? 0 : std::round(routerMetrics->thdi));
   delete routerMetrics;
   routerMetrics = nullptr;
+}
 
-  // update charts
-  _gridPowerHistory.setY(_gridPowerHistoryY, YASOLR_GRAPH_POINTS);
-  _routedPowerHistory.setY(_routedPowerHistoryY, YASOLR_GRAPH_POINTS);
-  _routerTHDiHistory.setY(_routerTHDiHistoryY, YASOLR_GRAPH_POINTS);
+void YaSolR::Website::updateCharts() {
+  // flat charts (i.e. nothing routed) are not sent again
+  if (downsampleHistory(_gridPowerSeries, _gridPowerPoints)) {
+    _gridPowerHistory.setX(_gridPowerPoints.x, _gridPowerPoints.size);
+    _gridPowerHistory.setY(_gridPowerPoints.y, _gridPowerPoints.size);
+  }
+  if (downsampleHistory(_routedPowerSeries, _routedPowerPoints)) {
+    _routedPowerHistory.setX(_routedPowerPoints.x, _routedPowerPoints.size);
+    _routedPowerHistory.setY(_routedPowerPoints.y, _routedPowerPoints.size);
+  }
+  if (downsampleHistory(_routerTHDiSeries, _routerTHDiPoints)) {
+    _routerTHDiHistory.setX(_routerTHDiPoints.x, _routerTHDiPoints.size);
+    _routerTHDiHistory.setY(_routerTHDiPoints.y, _routerTHDiPoints.size);
+  }
+}
+
+void YaSolR::Website::updatePIDHistory() {
+#ifdef APP_MODEL_PRO
+  const int16_t values[] = {
+    static_cast<int16_t>(std::round(pidController.getInput())),
+    static_cast<int16_t>(std::round(pidController.getOutput())),
+    static_cast<int16_t>(std::round(pidController.getError())),
+    static_cast<int16_t>(std::round(pidController.getSum())),
+    static_cast<int16_t>(std::round(pidController.getPTerm())),
+    static_cast<int16_t>(std::round(pidController.getITerm())),
+    static_cast<int16_t>(std::round(pidController.getDTerm())),
+  };
+  int16_t(*histories[])[YASOLR_GRAPH_POINTS] = {&_pidInputHistoryY, &_pidOutputHistoryY, &_pidErrorHistoryY, &_pidSumHistoryY, &_pidPTermHistoryY, &_pidITermHistoryY, &_pidDTermHistoryY};
+  for (size_t i = 0; i < sizeof(histories) / sizeof(histories[0]); i++)
+    if (pushHistory(*histories[i], values[i]))
+      _pidHistoryChanged |= 1 << i;
+#endif
 }
 
 void YaSolR::Website::updatePIDCharts() {
 #ifdef APP_MODEL_PRO
-  // shift array
-  memmove(&_pidInputHistoryY[0], &_pidInputHistoryY[1], sizeof(_pidInputHistoryY) - sizeof(*_pidInputHistoryY));
-  memmove(&_pidOutputHistoryY[0], &_pidOutputHistoryY[1], sizeof(_pidOutputHistoryY) - sizeof(*_pidOutputHistoryY));
-  memmove(&_pidErrorHistoryY[0], &_pidErrorHistoryY[1], sizeof(_pidErrorHistoryY) - sizeof(*_pidErrorHistoryY));
-  memmove(&_pidSumHistoryY[0], &_pidSumHistoryY[1], sizeof(_pidSumHistoryY) - sizeof(*_pidSumHistoryY));
-  memmove(&_pidPTermHistoryY[0], &_pidPTermHistoryY[1], sizeof(_pidPTermHistoryY) - sizeof(*_pidPTermHistoryY));
-  memmove(&_pidITermHistoryY[0], &_pidITermHistoryY[1], sizeof(_pidITermHistoryY) - sizeof(*_pidITermHistoryY));
-  memmove(&_pidDTermHistoryY[0], &_pidDTermHistoryY[1], sizeof(_pidDTermHistoryY) - sizeof(*_pidDTermHistoryY));
-
-  // set new values
-  _pidInputHistoryY[YASOLR_GRAPH_POINTS - 1] = std::round(pidController.getInput());
-  _pidOutputHistoryY[YASOLR_GRAPH_POINTS - 1] = std::round(pidController.getOutput());
-  _pidErrorHistoryY[YASOLR_GRAPH_POINTS - 1] = std::round(pidController.getError());
-  _pidSumHistoryY[YASOLR_GRAPH_POINTS - 1] = std::round(pidController.getSum());
-  _pidPTermHistoryY[YASOLR_GRAPH_POINTS - 1] = std::round(pidController.getPTerm());
-  _pidITermHistoryY[YASOLR_GRAPH_POINTS - 1] = std::round(pidController.getITerm());
-  _pidDTermHistoryY[YASOLR_GRAPH_POINTS - 1] = std::round(pidController.getDTerm());
-
-  // update charts
-  _pidInputHistory.setY(_pidInputHistoryY, YASOLR_GRAPH_POINTS);
-  _pidOutputHistory.setY(_pidOutputHistoryY, YASOLR_GRAPH_POINTS);
-  _pidErrorHistory.setY(_pidErrorHistoryY, YASOLR_GRAPH_POINTS);
-  _pidSumHistory.setY(_pidSumHistoryY, YASOLR_GRAPH_POINTS);
-  _pidPTermHistory.setY(_pidPTermHistoryY, YASOLR_GRAPH_POINTS);
-  _pidITermHistory.setY(_pidITermHistoryY, YASOLR_GRAPH_POINTS);
-  _pidDTermHistory.setY(_pidDTermHistoryY, YASOLR_GRAPH_POINTS);
+  // flat charts are not sent again
+  dash::LineChart<int8_t, int16_t>* charts[] = {&_pidInputHistory, &_pidOutputHistory, &_pidErrorHistory, &_pidSumHistory, &_pidPTermHistory, &_pidITermHistory, &_pidDTermHistory};
+  const int16_t* histories[] = {_pidInputHistoryY, _pidOutputHistoryY, _pidErrorHistoryY, _pidSumHistoryY, _pidPTermHistoryY, _pidITermHistoryY, _pidDTermHistoryY};
+  for (size_t i = 0; i < sizeof(charts) / sizeof(charts[0]); i++)
+    if (_pidHistoryChanged & (1 << i))
+      charts[i]->setY(histories[i], YASOLR_GRAPH_POINTS);
+  _pidHistoryChanged = 0;
 #endif
 }
 
@@ -1633,6 +1894,15 @@ void YaSolR::Website::resetPIDCharts() {
   memset(_pidPTermHistoryY, 0, sizeof(_pidPTermHistoryY));
   memset(_pidITermHistoryY, 0, sizeof(_pidITermHistoryY));
   memset(_pidDTermHistoryY, 0, sizeof(_pidDTermHistoryY));
+  _pidHistoryChanged = 0;
+  // flat charts are not sent by updatePIDCharts()
+  _pidInputHistory.setY(_pidInputHistoryY, YASOLR_GRAPH_POINTS);
+  _pidOutputHistory.setY(_pidOutputHistoryY, YASOLR_GRAPH_POINTS);
+  _pidErrorHistory.setY(_pidErrorHistoryY, YASOLR_GRAPH_POINTS);
+  _pidSumHistory.setY(_pidSumHistoryY, YASOLR_GRAPH_POINTS);
+  _pidPTermHistory.setY(_pidPTermHistoryY, YASOLR_GRAPH_POINTS);
+  _pidITermHistory.setY(_pidITermHistoryY, YASOLR_GRAPH_POINTS);
+  _pidDTermHistory.setY(_pidDTermHistoryY, YASOLR_GRAPH_POINTS);
 #endif
 }
 
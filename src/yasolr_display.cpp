@@ -39,7 +39,7 @@ void yasolr_init_display() {
     display->setActive(true);
 
     Mycila::Task* displayTask = new Mycila::Task("Display", [](void* params) {
-      if (lastDisplayUpdate && millis() - lastDisplayUpdate < config.getLong(KEY_DISPLAY_SPEED) * 1000)
+      if (lastDisplayUpdate && millis() - lastDisplayUpdate < settings.displaySpeed * 1000)
         return;
 
       // Serial.printf("clear()\n");
@@ -213,6 +213,6 @@ void yasolr_init_display() {
 
     displayTask->setInterval(1000);
 
-    coreTaskManager.addTask(*displayTask);
+    uiTaskManager.addTask(*displayTask);
   }
 }
@@ -3,21 +3,62 @@
  * Copyright (C) 2023-2025 Mathieu Carbou
  */
 #include <yasolr.h>
+#include <yasolr_dashboard.h>
 
-Mycila::DS18* ds18O1 = nullptr;
-Mycila::DS18* ds18O2 = nullptr;
-Mycila::DS18* ds18Sys = nullptr;
+Mycila::DS18Bus* ds18O1 = nullptr;
+Mycila::DS18Bus* ds18O2 = nullptr;
+Mycila::DS18Bus* ds18Sys = nullptr;
+Mycila::TaskManager* ds18TaskManager = nullptr;
+
+// one 1-Wire bus per probe role: several probes can be wired on the same bus
+static Mycila::OneWire::GPIOBus o1Bus;
+static Mycila::OneWire::GPIOBus o2Bus;
+static Mycila::OneWire::GPIOBus sysBus;
+static Mycila::DS18Scheduler scheduler;
+static Mycila::Task* schedulerTask = nullptr;
+
+static Mycila::DS18Bus* beginBus(const char* name, Mycila::OneWire::GPIOBus& bus, int8_t pin, uint8_t resolution) {
+  if (!bus.begin(pin)) {
+    logger.error(TAG, "Invalid DS18 pin: %d", pin);
+    return nullptr;
+  }
+  Mycila::DS18Bus* probe = new Mycila::DS18Bus(bus);
+  // the 1-Wire search can retry for a while when no probe answers: buses are searched in parallel
+  yasolr_boot_async(name, [probe, resolution]() {
+    // probes can answer late after power-on: leave them some time between 2 searches
+    for (uint8_t attempt = 0; !probe->begin(resolution) && attempt < YASOLR_DS18_SEARCH_MAX_RETRY; attempt++)
+      delay(YASOLR_DS18_SEARCH_RETRY_DELAY);
+  });
+  return probe;
+}
+
+static void endBus(Mycila::DS18Bus*& probe, Mycila::OneWire::GPIOBus& bus) {
+  probe->end();
+  delete probe;
+  probe = nullptr;
+  bus.end();
+}
 
 void yasolr_init_ds18() {
   logger.info(TAG, "Initialize DS18 probes");
-  uint8_t count = 0;
 
-  if (config.getBool(KEY_ENABLE_DS18_SYSTEM)) {
-    ds18Sys = new Mycila::DS18();
-    ds18Sys->begin(config.getLong(KEY_PIN_ROUTER_DS18), YASOLR_DS18_SEARCH_MAX_RETRY);
+  if (config.getBool(KEY_ENABLE_DS18_SYSTEM))
+    ds18Sys = beginBus("ds18_sys", sysBus, config.getLong(KEY_PIN_ROUTER_DS18), config.getInt(KEY_DS18_SYSTEM_RESOLUTION));
+
+  if (config.getBool(KEY_ENABLE_OUTPUT1_DS18))
+    ds18O1 = beginBus("ds18_o1", o1Bus, config.getLong(KEY_PIN_OUTPUT1_DS18), config.getInt(KEY_OUTPUT1_DS18_RESOLUTION));
+
+  if (config.getBool(KEY_ENABLE_OUTPUT2_DS18))
+    ds18O2 = beginBus("ds18_o2", o2Bus, config.getLong(KEY_PIN_OUTPUT2_DS18), config.getInt(KEY_OUTPUT2_DS18_RESOLUTION));
+}
+
+void yasolr_start_ds18() {
+  uint8_t count = 0;
 
+  if (ds18Sys) {
     if (ds18Sys->isEnabled()) {
       count++;
+      logger.info(TAG, "DS18 system bus: %u probe(s) found", ds18Sys->getProbeCount());
       ds18Sys->listen([](float temperature, bool changed) {
         if (changed) {
           logger.info(TAG, "Router Temperature changed to %.02f °C", temperature);
@@ -27,23 +68,20 @@ void yasolr_init_ds18() {
       });
     } else {
       logger.error(TAG, "DS18 system probe failed to initialize!");
-      ds18Sys->end();
-      delete ds18Sys;
-      ds18Sys = nullptr;
+      endBus(ds18Sys, sysBus);
     }
   }
 
-  if (config.getBool(KEY_ENABLE_OUTPUT1_DS18)) {
-    ds18O1 = new Mycila::DS18();
-    ds18O1->begin(config.getLong(KEY_PIN_OUTPUT1_DS18), YASOLR_DS18_SEARCH_MAX_RETRY);
-
+  if (ds18O1) {
     if (ds18O1->isEnabled()) {
       count++;
+      logger.info(TAG, "DS18 output 1 bus: %u probe(s) found", ds18O1->getProbeCount());
       ds18O1->listen([](float temperature, bool changed) {
         if (output1) {
           // update the temperature in the output
           if (!output1->temperature().update(temperature).has_value()) {
-            // if this is the first time we get the temperature, we can trigger the dashboard init task
+            // if this is the first time we get the temperature, the output tab can be shown
+            website.invalidate({YaSolR::Website::Section::TABS});
             dashboardInitTask.resume();
           }
         }
@@ -56,23 +94,20 @@ void yasolr_init_ds18() {
       });
     } else {
       logger.error(TAG, "DS18 output 1 probe failed to initialize!");
-      ds18O1->end();
-      delete ds18O1;
-      ds18O1 = nullptr;
+      endBus(ds18O1, o1Bus);
     }
   }
 
-  if (config.getBool(KEY_ENABLE_OUTPUT2_DS18)) {
-    ds18O2 = new Mycila::DS18();
-    ds18O2->begin(config.getLong(KEY_PIN_OUTPUT2_DS18), YASOLR_DS18_SEARCH_MAX_RETRY);
-
+  if (ds18O2) {
     if (ds18O2->isEnabled()) {
       count++;
+      logger.info(TAG, "DS18 output 2 bus: %u probe(s) found", ds18O2->getProbeCount());
       ds18O2->listen([](float temperature, bool changed) {
         if (output2) {
           // update the temperature in the output
           if (!output2->temperature().update(temperature).has_value()) {
-            // if this is the first time we get the temperature, we can trigger the dashboard init task
+            // if this is the first time we get the temperature, the output tab can be shown
+            website.invalidate({YaSolR::Website::Section::TABS});
             dashboardInitTask.resume();
           }
         }
@@ -83,34 +118,43 @@ void yasolr_init_ds18() {
             mqttPublishTask->requestEarlyRun();
         }
       });
-      ds18O2 = new Mycila::DS18();
     } else {
       logger.error(TAG, "DS18 output 2 probe failed to initialize!");
-      ds18O2->end();
-      delete ds18O2;
-      ds18O2 = nullptr;
+      endBus(ds18O2, o2Bus);
     }
   }
 
   if (count) {
-    Mycila::Task* ds18Task = new Mycila::Task("DS18", [](void* params) {
-      if (ds18Sys) {
-        ds18Sys->read();
-        yield();
-      }
-      if (ds18O1) {
-        ds18O1->read();
-        yield();
-      }
-      if (ds18O2) {
-        ds18O2->read();
-        yield();
-      }
-    });
-    ds18Task->setInterval(10000);
+    // All the buses are driven by one scheduler: the conversions of the buses which are due are started together
+    // and the task sleeps during the conversion time instead of blocking in the 1-Wire driver.
+    // Output temperatures are read more often than the router temperature so that output limits react faster.
+    if (ds18O1) {
+      ds18O1->setInterval(YASOLR_DS18_OUTPUT_READ_INTERVAL);
+      scheduler.add(*ds18O1);
+    }
+    if (ds18O2) {
+      ds18O2->setInterval(YASOLR_DS18_OUTPUT_READ_INTERVAL);
+      scheduler.add(*ds18O2);
+    }
+    if (ds18Sys) {
+      ds18Sys->setInterval(YASOLR_DS18_SYSTEM_READ_INTERVAL);
+      scheduler.add(*ds18Sys);
+    }
+
+    ds18TaskManager = new Mycila::TaskManager("y-ds18");
+
+    // the scheduler returns the delay until its next step
+    schedulerTask = new Mycila::Task("DS18 Scheduler", [](void* params) { schedulerTask->setInterval(scheduler.loop(millis())); });
     if (config.getBool(KEY_ENABLE_DEBUG))
-      ds18Task->enableProfiling();
+      schedulerTask->enableProfiling();
+    ds18TaskManager->addTask(*schedulerTask);
+
+    if (config.getBool(KEY_ENABLE_DEBUG)) {
+      ds18TaskManager->enableProfiling();
+    }
+
+    assert(ds18TaskManager->asyncStart(512 * 4, 1, 0, 100, true));
 
-    unsafeTaskManager.addTask(*ds18Task);
+    Mycila::TaskMonitor.addTask(ds18TaskManager->name());
   }
 }
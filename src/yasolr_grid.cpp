@@ -8,7 +8,7 @@ Mycila::Grid grid;
 
 float yasolr_frequency() {
   // 1. check if frequency is set in config
-  float frequency = config.getFloat(KEY_GRID_FREQUENCY);
+  float frequency = settings.gridFrequency;
   if (frequency > 0)
     return frequency;
 
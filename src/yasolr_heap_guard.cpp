@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#include <yasolr.h>
+
+#ifdef YASOLR_HEAP_GUARD
+
+  #include <esp_heap_caps.h>
+
+// Requires CONFIG_HEAP_USE_HOOKS=y: ESP-IDF then calls these hooks on every allocation and free.
+// Once armed at the end of setup(), each allocation is accounted to the task (or ISR) doing it,
+// so that any allocation happening on a hot path after boot shows up in /api/debug.
+// Live blocks are also remembered until freed: the live bytes of a task growing over time point to a leak.
+
+  #define YASOLR_HEAP_GUARD_SLOTS 24
+  #define YASOLR_HEAP_GUARD_LIVE  1024 // must be a power of 2
+
+struct HeapGuardSlot {
+    TaskHandle_t task;
+    char name[configMAX_TASK_NAME_LEN];
+    uint32_t allocations;
+    uint32_t bytes;
+    uint32_t liveBlocks;
+    uint32_t liveBytes;
+};
+
+struct HeapGuardBlock {
+    void* ptr;
+    uint32_t size;
+    uint8_t slot;
+};
+
+// freed entries are kept as tombstones (ptr == this table) so that probing continues past them
+static HeapGuardBlock live[YASOLR_HEAP_GUARD_LIVE];
+  #define TOMBSTONE reinterpret_cast<void*>(live)
+
+static HeapGuardSlot slots[YASOLR_HEAP_GUARD_SLOTS];
+static uint32_t untracked = 0;
+static uint32_t liveOverflow = 0;
+
+static inline size_t IRAM_ATTR hashPtr(const void* ptr) {
+  return (reinterpret_cast<uintptr_t>(ptr) >> 3) & (YASOLR_HEAP_GUARD_LIVE - 1);
+}
+
+static void IRAM_ATTR remember(void* ptr, uint32_t size, uint8_t slot) {
+  for (size_t i = 0, h = hashPtr(ptr); i < YASOLR_HEAP_GUARD_LIVE; i++, h = (h + 1) & (YASOLR_HEAP_GUARD_LIVE - 1)) {
+    if (live[h].ptr == nullptr || live[h].ptr == TOMBSTONE) {
+      live[h] = {ptr, size, slot};
+      slots[slot].liveBlocks++;
+      slots[slot].liveBytes += size;
+      return;
+    }
+  }
+  liveOverflow++;
+}
+
+static void IRAM_ATTR forget(void* ptr) {
+  for (size_t i = 0, h = hashPtr(ptr); i < YASOLR_HEAP_GUARD_LIVE; i++, h = (h + 1) & (YASOLR_HEAP_GUARD_LIVE - 1)) {
+    if (live[h].ptr == nullptr)
+      return;
+    if (live[h].ptr == ptr) {
+      slots[live[h].slot].liveBlocks--;
+      slots[live[h].slot].liveBytes -= live[h].size;
+      live[h].ptr = TOMBSTONE;
+      return;
+    }
+  }
+}
+static volatile bool armed = false;
+static portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
+
+extern "C" void IRAM_ATTR esp_heap_trace_alloc_hook(void* ptr, size_t size, uint32_t caps) {
+  if (!armed || ptr == nullptr)
+    return;
+
+  // no allocation and no logging here: this runs inside the heap functions
+  const TaskHandle_t task = xPortInIsrContext() ? nullptr : xTaskGetCurrentTaskHandle();
+
+  portENTER_CRITICAL_SAFE(&lock);
+  HeapGuardSlot* slot = nullptr;
+  uint8_t index = 0;
+  for (; index < YASOLR_HEAP_GUARD_SLOTS; index++) {
+    if (slots[index].allocations && slots[index].task == task) {
+      slot = &slots[index];
+      break;
+    }
+    if (!slots[index].allocations) {
+      slot = &slots[index];
+      slot->task = task;
+      strlcpy(slot->name, task ? pcTaskGetName(task) : "ISR", sizeof(slot->name));
+      break;
+    }
+  }
+  if (slot) {
+    slot->allocations++;
+    slot->bytes += size;
+    remember(ptr, size, index);
+  } else {
+    untracked++;
+  }
+  portEXIT_CRITICAL_SAFE(&lock);
+}
+
+extern "C" void IRAM_ATTR esp_heap_trace_free_hook(void* ptr) {
+  if (!armed || ptr == nullptr)
+    return;
+
+  portENTER_CRITICAL_SAFE(&lock);
+  forget(ptr);
+  portEXIT_CRITICAL_SAFE(&lock);
+}
+
+void yasolr_heap_guard_arm() {
+  logger.warn(TAG, "Heap guard armed: allocations are now tracked");
+  armed = true;
+}
+
+void yasolr_heap_guard_toJson(const JsonObject& root) {
+  // copied first: serializing the report allocates
+  HeapGuardSlot copy[YASOLR_HEAP_GUARD_SLOTS];
+  portENTER_CRITICAL(&lock);
+  memcpy(copy, slots, sizeof(slots));
+  const uint32_t others = untracked;
+  const uint32_t overflow = liveOverflow;
+  portEXIT_CRITICAL(&lock);
+
+  for (const HeapGuardSlot& slot : copy) {
+    if (!slot.allocations)
+      break;
+    JsonObject task = root[slot.name].to<JsonObject>();
+    task["allocations"] = slot.allocations;
+    task["bytes"] = slot.bytes;
+    task["live_blocks"] = slot.liveBlocks;
+    task["live_bytes"] = slot.liveBytes;
+  }
+
+  if (others)
+    root["untracked"] = others;
+  if (overflow)
+    root["live_overflow"] = overflow;
+}
+
+#endif
@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#include <yasolr.h>
+
+Mycila::HTTPMeter* httpMeter = nullptr;
+Mycila::Task* httpMeterConnectTask = nullptr;
+Mycila::TaskManager* httpMeterTaskManager = nullptr;
+
+static Mycila::Task* httpMeterReadTask = nullptr;
+
+// set while the meter address could not be resolved: the read task tries again.
+// only accessed from the y-http task manager.
+static bool connectPending = false;
+static uint32_t connectTime = 0;
+
+static void connect() {
+  httpMeter->end();
+  connectTime = millis();
+  const Mycila::HTTP::Map* map = Mycila::HTTP::findMap(settings.httpMeterModel.c_str());
+  // the model can be changed at runtime: it is checked again at each connection
+  if (!map) {
+    logger.error(TAG, "Unsupported HTTP meter: %s", settings.httpMeterModel.c_str());
+    connectPending = false;
+    return;
+  }
+  connectPending = !httpMeter->begin(settings.httpMeterServer.c_str(), static_cast<uint16_t>(settings.httpMeterPort), *map);
+}
+
+static Mycila::AdaptiveInterval readInterval(YASOLR_GRID_POLL_INTERVAL_MIN, YASOLR_GRID_POLL_INTERVAL_MAX, YASOLR_GRID_POLL_ACTIVITY_LOW, YASOLR_GRID_POLL_ACTIVITY_HIGH, YASOLR_GRID_POLL_VARIANCE_ALPHA);
+
+void yasolr_init_http_meter() {
+  if (config.getBool(KEY_ENABLE_HTTP_METER)) {
+    logger.info(TAG, "Initialize HTTP meter %s", config.get(KEY_HTTP_METER_MODEL));
+
+    if (!config.getString(KEY_HTTP_METER_SERVER).length()) {
+      logger.error(TAG, "HTTP meter server is not set");
+      return;
+    }
+
+    if (!Mycila::HTTP::findMap(config.get(KEY_HTTP_METER_MODEL))) {
+      logger.error(TAG, "Unsupported HTTP meter: %s", config.get(KEY_HTTP_METER_MODEL));
+      return;
+    }
+
+    httpMeter = new Mycila::HTTPMeter();
+
+    // when receiving data from the meter, update grid metrics
+    httpMeter->setCallback([](Mycila::HTTPMeter::EventType eventType) {
+      if (eventType == Mycila::HTTPMeter::EventType::EVT_READ) {
+        const Mycila::HTTP::Metrics& metrics = httpMeter->getMetrics();
+        grid.remoteMetrics().update({
+          .apparentPower = metrics.apparentPower,
+          .current = metrics.current,
+          .energy = isnan(metrics.energy) ? 0 : static_cast<uint32_t>(metrics.energy),
+          .energyReturned = isnan(metrics.energyReturned) ? 0 : static_cast<uint32_t>(metrics.energyReturned),
+          .frequency = metrics.frequency,
+          .power = metrics.power,
+          .powerFactor = metrics.powerFactor,
+          .voltage = metrics.voltage,
+        });
+
+        if (grid.updatePower()) {
+          yasolr_divert();
+        }
+
+        // poll faster when grid power moves or when the PID is far from its setpoint.
+        // the PID error only counts while a dimmer can act on it: saturated outputs (at night or at full power) keep a large error.
+        httpMeterReadTask->setInterval(readInterval.update(metrics.power, router.isRegulating() ? pidController.getError() : NAN));
+      }
+    });
+
+    // task called once network is up to resolve the meter address
+    httpMeterConnectTask = new Mycila::Task("HTTP Meter Connect", Mycila::Task::Type::ONCE, [](void* params) { connect(); });
+
+    // reader: polls are blocking so they run in their own task manager.
+    // until the meter address is resolved, it retries the connection instead.
+    httpMeterReadTask = new Mycila::Task("HTTP Meter Read", [](void* params) {
+      if (httpMeter->isEnabled())
+        httpMeter->read();
+      else if (millis() - connectTime >= YASOLR_HTTP_METER_CONNECT_RETRY)
+        connect();
+    });
+    httpMeterReadTask->setEnabledWhen([]() { return httpMeter->isEnabled() || connectPending; });
+    httpMeterReadTask->setInterval(readInterval.getInterval());
+
+    // both tasks use the HTTP client: they run in the same task manager so that a reconnection never races with a poll
+    httpMeterTaskManager = new Mycila::TaskManager("y-http");
+    httpMeterTaskManager->addTask(*httpMeterConnectTask);
+    httpMeterTaskManager->addTask(*httpMeterReadTask);
+
+    if (config.getBool(KEY_ENABLE_DEBUG)) {
+      httpMeterConnectTask->enableProfiling();
+      httpMeterTaskManager->enableProfiling();
+    }
+
+    assert(httpMeterTaskManager->asyncStart(512 * 8, 1, 0, 100, true));
+
+    Mycila::TaskMonitor.addTask(httpMeterTaskManager->name());
+  }
+}
@@ -15,14 +15,21 @@ void yasolr_init_jsy() {
 
     jsy = new Mycila::JSY();
 
-    if (config.getString(KEY_JSY_UART) == YASOLR_UART_1_NAME)
-      jsy->begin(Serial1, config.getLong(KEY_PIN_JSY_RX), config.getLong(KEY_PIN_JSY_TX));
+    // the JSY begin() negotiates the baud rate by probing all the speeds: run it while the other subsystems initialize
+    yasolr_boot_async("jsy", []() {
+      if (config.getString(KEY_JSY_UART) == YASOLR_UART_1_NAME)
+        jsy->begin(Serial1, config.getLong(KEY_PIN_JSY_RX), config.getLong(KEY_PIN_JSY_TX));
 
 #if SOC_UART_NUM > 2
-    if (config.getString(KEY_JSY_UART) == YASOLR_UART_2_NAME)
-      jsy->begin(Serial2, config.getLong(KEY_PIN_JSY_RX), config.getLong(KEY_PIN_JSY_TX));
+      if (config.getString(KEY_JSY_UART) == YASOLR_UART_2_NAME)
+        jsy->begin(Serial2, config.getLong(KEY_PIN_JSY_RX), config.getLong(KEY_PIN_JSY_TX));
 #endif
+    });
+  }
+}
 
+void yasolr_start_jsy() {
+  if (jsy) {
     if (!jsy->isEnabled()) {
       logger.error(TAG, "JSY failed to initialize!");
       jsy->end();
@@ -52,5 +52,5 @@ void yasolr_init_lights() {
   lights.set(Mycila::TrafficLight::State::OFF, Mycila::TrafficLight::State::ON, Mycila::TrafficLight::State::OFF);
 
   lightsTask.setInterval(200);
-  coreTaskManager.addTask(lightsTask);
+  uiTaskManager.addTask(lightsTask);
 }
@@ -4,48 +4,308 @@
  */
 #include <yasolr.h>
 
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
 Mycila::Logger logger;
+Mycila::LogFilter logFilter;
+Mycila::CPUProfiler cpuProfiler;
+Mycila::TraceLog traceLog;
 
 static Mycila::Task* loggingTask = nullptr;
+static Mycila::Task* cpuProfilerTask = nullptr;
+static Mycila::Task* traceLogTask = nullptr;
 static WebSerial* webSerial = nullptr;
+static Mycila::Task* webSerialTask = nullptr;
+
+#define YASOLR_LOG_BUFFER_MAGIC 0x594C4F47 // "YLOG"
+
+// Logs are appended to a ring buffer and written to flash in batches by a low priority task.
+// The buffer lives in RTC memory: what was not yet written when the device crashed or restarted
+// is recovered at the next boot.
+typedef struct {
+    uint32_t magic;
+    uint32_t head; // total bytes written
+    uint32_t tail; // total bytes flushed
+    uint32_t dropped;
+    char data[YASOLR_LOG_BUFFER_SIZE];
+} LogBuffer;
+
+static RTC_NOINIT_ATTR LogBuffer logBuffer;
+
+// the log files are streamed over several HTTP callbacks: they are neither rotated nor removed while a reader is active
+static std::mutex logFilesMutex;
+static uint32_t logReaders = 0;
 
-static File logFile;
+static void removeLogFiles() {
+  char path[16];
+  for (unsigned i = 1; i < YASOLR_LOG_FILES; i++) {
+    snprintf(path, sizeof(path), YASOLR_LOG_FILE_ROTATED, i);
+    LittleFS.remove(path);
+  }
+  if (LittleFS.remove(YASOLR_LOG_FILE))
+    logger.info(TAG, "Log files removed");
+}
 
-class LogStream : public Print {
+class LogSink : public Print {
   public:
-    LogStream(const char* path, size_t limit) : _path(path), _limit(limit) {
-      File file = LittleFS.open(_path, "r");
-      _logSize = file ? file.size() : 0;
-      file.close();
-      _accepting = _logSize < _limit;
-    }
     size_t write(const uint8_t* buffer, size_t size) override {
-      if (!_accepting)
-        return 0;
-      if (_logSize + size > _limit) {
-        _accepting = false;
+      portENTER_CRITICAL(&_lock);
+      const uint32_t free = YASOLR_LOG_BUFFER_SIZE - (logBuffer.head - logBuffer.tail);
+      if (size > free) {
+        logBuffer.dropped += size;
+        portEXIT_CRITICAL(&_lock);
         return 0;
       }
-      File file = LittleFS.open(_path, "a");
+      if (logBuffer.head == logBuffer.tail)
+        _since = millis();
+      for (size_t i = 0; i < size; i++)
+        logBuffer.data[(logBuffer.head + i) % YASOLR_LOG_BUFFER_SIZE] = buffer[i];
+      logBuffer.head += size;
+      portEXIT_CRITICAL(&_lock);
+      return size;
+    }
+    size_t write(uint8_t c) override { return write(&c, 1); }
+
+    // called at boot: the logs of the previous boots are shifted to the rotated segments
+    // and what the previous boot did not flush is written first in a new segment
+    void begin() {
+      File file = LittleFS.open(YASOLR_LOG_FILE, "r");
+      _fileSize = file ? file.size() : 0;
+      file.close();
+      if (_fileSize)
+        _rotate();
+
+      const uint32_t pending = logBuffer.head - logBuffer.tail;
+      if (esp_reset_reason() != ESP_RST_POWERON && logBuffer.magic == YASOLR_LOG_BUFFER_MAGIC && pending && pending <= YASOLR_LOG_BUFFER_SIZE) {
+        char header[96];
+        const int len = snprintf(header, sizeof(header), "--- %" PRIu32 " bytes recovered from previous boot (reset reason: %d) ---\n", pending, static_cast<int>(esp_reset_reason()));
+        _append(reinterpret_cast<const uint8_t*>(header), len);
+        flush(true);
+      } else {
+        logBuffer.head = 0;
+        logBuffer.tail = 0;
+      }
+
+      logBuffer.magic = YASOLR_LOG_BUFFER_MAGIC;
+      logBuffer.dropped = 0;
+    }
+
+    // requests the removal of all the log files: done by the flush task, which owns the files
+    void clear() { _clear = true; }
+
+    // writes the buffered logs when they are big or old enough, or when forced
+    void flush(bool force = false) {
+      if (_clear) {
+        std::lock_guard<std::mutex> lock(logFilesMutex);
+        // removal is postponed until the last download ends
+        if (!logReaders && _clear.exchange(false)) {
+          removeLogFiles();
+          _fileSize = 0;
+        }
+      }
+
+      portENTER_CRITICAL(&_lock);
+      const uint32_t head = logBuffer.head;
+      const uint32_t dropped = logBuffer.dropped;
+      logBuffer.dropped = 0;
+      portEXIT_CRITICAL(&_lock);
+
+      if (dropped) {
+        char marker[48];
+        const int len = snprintf(marker, sizeof(marker), "--- %" PRIu32 " bytes dropped ---\n", dropped);
+        _append(reinterpret_cast<const uint8_t*>(marker), len);
+      }
+
+      uint32_t pending = head - logBuffer.tail;
+      if (!pending || (!force && pending < YASOLR_LOG_FLUSH_SIZE && millis() - _since < YASOLR_LOG_FLUSH_DELAY))
+        return;
+
+      // only this task moves the tail: the region between tail and head is not touched by the writers
+      while (pending) {
+        const uint32_t offset = logBuffer.tail % YASOLR_LOG_BUFFER_SIZE;
+        const uint32_t len = std::min(pending, static_cast<uint32_t>(YASOLR_LOG_BUFFER_SIZE - offset));
+        _append(reinterpret_cast<const uint8_t*>(logBuffer.data + offset), len);
+        portENTER_CRITICAL(&_lock);
+        logBuffer.tail += len;
+        portEXIT_CRITICAL(&_lock);
+        pending -= len;
+      }
+
+      _since = millis();
+    }
+
+  private:
+    portMUX_TYPE _lock = portMUX_INITIALIZER_UNLOCKED;
+    uint32_t _since = 0;
+    size_t _fileSize = 0;
+    std::atomic<bool> _clear{false};
+
+    void _append(const uint8_t* buffer, size_t size) {
+      if (_fileSize && _fileSize + size > YASOLR_LOG_FILE_SIZE) {
+        std::lock_guard<std::mutex> lock(logFilesMutex);
+        // while a download is running, the current file grows past its size and is rotated afterwards
+        if (!logReaders)
+          _rotate();
+      }
+      File file = LittleFS.open(YASOLR_LOG_FILE, "a");
       if (!file)
-        return 0;
-      size_t written = file.write(buffer, size);
+        return;
+      _fileSize += file.write(buffer, size);
       file.close();
-      _logSize += written;
-      return written;
     }
-    size_t write(uint8_t c) override {
-      assert(false);
+
+    void _rotate() {
+      char from[16];
+      char to[16];
+      snprintf(to, sizeof(to), YASOLR_LOG_FILE_ROTATED, YASOLR_LOG_FILES - 1);
+      LittleFS.remove(to);
+      for (unsigned i = YASOLR_LOG_FILES - 1; i > 0; i--) {
+        if (i == 1)
+          snprintf(from, sizeof(from), "%s", YASOLR_LOG_FILE);
+        else
+          snprintf(from, sizeof(from), YASOLR_LOG_FILE_ROTATED, i - 1);
+        snprintf(to, sizeof(to), YASOLR_LOG_FILE_ROTATED, i);
+        if (LittleFS.exists(from))
+          LittleFS.rename(from, to);
+      }
+      _fileSize = 0;
+    }
+};
+
+static LogSink* logSink = nullptr;
+static Mycila::Task* logFlushTask = nullptr;
+
+// streams all the log files, oldest first
+class LogReader {
+  public:
+    LogReader() {
+      std::lock_guard<std::mutex> lock(logFilesMutex);
+      logReaders++;
+    }
+
+    ~LogReader() {
+      std::lock_guard<std::mutex> lock(logFilesMutex);
+      logReaders--;
+    }
+
+    size_t read(uint8_t* buffer, size_t maxLen) {
+      while (_segment > 0) {
+        if (!_file) {
+          char path[16];
+          if (_segment == 1)
+            snprintf(path, sizeof(path), "%s", YASOLR_LOG_FILE);
+          else
+            snprintf(path, sizeof(path), YASOLR_LOG_FILE_ROTATED, _segment - 1);
+          if (LittleFS.exists(path))
+            _file = LittleFS.open(path, "r");
+          if (!_file) {
+            _segment--;
+            continue;
+          }
+        }
+        const size_t n = _file.read(buffer, maxLen);
+        if (n)
+          return n;
+        _file.close();
+        _segment--;
+      }
       return 0;
     }
 
   private:
-    const char* _path;
-    const size_t _limit;
-    size_t _logSize = 0;
-    bool _accepting = false;
+    unsigned _segment = YASOLR_LOG_FILES;
+    File _file;
 };
 
+// Console lines are queued and sent to WebSerial in batches by a UI task so that a slow browser
+// never blocks a task that logs. When the queue is full, the oldest lines are dropped.
+class WebSerialSink : public Print {
+  public:
+    size_t write(const uint8_t* buffer, size_t size) override {
+      if (size > YASOLR_WEBSERIAL_BUFFER_SIZE) {
+        buffer += size - YASOLR_WEBSERIAL_BUFFER_SIZE;
+        size = YASOLR_WEBSERIAL_BUFFER_SIZE;
+      }
+      portENTER_CRITICAL(&_lock);
+      while (YASOLR_WEBSERIAL_BUFFER_SIZE - (_head - _tail) < size)
+        _dropLine();
+      for (size_t i = 0; i < size; i++)
+        _data[(_head + i) % YASOLR_WEBSERIAL_BUFFER_SIZE] = buffer[i];
+      _head += size;
+      portEXIT_CRITICAL(&_lock);
+      return size;
+    }
+    size_t write(uint8_t c) override { return write(&c, 1); }
+
+    // sends the pending lines as one frame, cut at a line boundary. returns false if there was nothing to send.
+    // only this task moves the tail forward, except writers dropping lines: the lock is only held to read and move
+    // the indices and the frame is copied outside of it, again if a writer dropped the lines being copied.
+    bool flush(Print& out) {
+      static char frame[YASOLR_WEBSERIAL_FRAME_SIZE];
+      uint32_t dropped = 0;
+      size_t len = 0;
+      bool copied = false;
+
+      while (!copied) {
+        portENTER_CRITICAL(&_lock);
+        dropped += _dropped;
+        _dropped = 0;
+        const uint32_t tail = _tail;
+        const uint32_t pending = _head - tail;
+        portEXIT_CRITICAL(&_lock);
+
+        const size_t size = std::min(static_cast<size_t>(pending), sizeof(frame));
+        size_t end = 0;
+        for (size_t i = 0; i < size; i++) {
+          frame[i] = _data[(tail + i) % YASOLR_WEBSERIAL_BUFFER_SIZE];
+          if (frame[i] == '\n')
+            end = i + 1;
+        }
+        // a line longer than a frame is sent in several frames
+        len = end ? end : size;
+
+        portENTER_CRITICAL(&_lock);
+        copied = _tail == tail;
+        if (copied)
+          _tail += len;
+        portEXIT_CRITICAL(&_lock);
+      }
+
+      if (dropped) {
+        char marker[48];
+        const int n = snprintf(marker, sizeof(marker), "--- %" PRIu32 " lines dropped ---\n", dropped);
+        out.write(reinterpret_cast<const uint8_t*>(marker), n);
+      }
+
+      if (len)
+        out.write(reinterpret_cast<const uint8_t*>(frame), len);
+
+      return len;
+    }
+
+  private:
+    portMUX_TYPE _lock = portMUX_INITIALIZER_UNLOCKED;
+    char _data[YASOLR_WEBSERIAL_BUFFER_SIZE];
+    uint32_t _head = 0;
+    uint32_t _tail = 0;
+    uint32_t _dropped = 0;
+
+    void _dropLine() {
+      while (_tail != _head) {
+        if (_data[_tail++ % YASOLR_WEBSERIAL_BUFFER_SIZE] == '\n')
+          break;
+      }
+      _dropped++;
+    }
+};
+
+static WebSerialSink* webSerialSink = nullptr;
+
 static void initWebSerial() {
   logger.info(TAG, "Redirecting logs to WebSerial");
   webSerial = new WebSerial();
@@ -55,16 +315,46 @@ static void initWebSerial() {
   webSerial->setInput(false);
 #endif
   webSerial->begin(&webServer, "/console");
-  logger.forwardTo(webSerial);
+
+  webSerialSink = new WebSerialSink();
+  webSerialTask = new Mycila::Task("WebSerial", [](void* params) {
+    // a full queue is sent within one run
+    for (size_t i = 0; i < YASOLR_WEBSERIAL_BUFFER_SIZE / YASOLR_WEBSERIAL_FRAME_SIZE; i++)
+      if (!webSerialSink->flush(*webSerial))
+        break;
+  });
+  webSerialTask->setInterval(YASOLR_WEBSERIAL_INTERVAL);
+  uiTaskManager.addTask(*webSerialTask);
+
+  logger.forwardTo(webSerialSink);
 }
 
 static void initLogDump() {
   logger.info(TAG, "Redirecting logs to " YASOLR_LOG_FILE);
+
+  logSink = new LogSink();
+  logSink->begin();
+
+  logFlushTask = new Mycila::Task("Log Flush", [](void* params) { logSink->flush(); });
+  logFlushTask->setInterval(YASOLR_LOG_FLUSH_INTERVAL);
+  unsafeTaskManager.addTask(*logFlushTask);
+
   webServer.on("/api" YASOLR_LOG_FILE, HTTP_GET, [](AsyncWebServerRequest* request) {
-    LittleFS.open(YASOLR_LOG_FILE, "r");
-    request->send(LittleFS, YASOLR_LOG_FILE, "text/plain");
+    // the files are streamed one after the other: the latest logs still in RAM are flushed soon after
+    logFlushTask->requestEarlyRun();
+    std::shared_ptr<LogReader> reader = std::make_shared<LogReader>();
+    request->send(request->beginChunkedResponse("text/plain", [reader](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+      return reader->read(buffer, maxLen);
+    }));
   });
-  logger.forwardTo(new LogStream(YASOLR_LOG_FILE, 32 * 1024));
+
+  webServer.on("/api" YASOLR_LOG_FILE, HTTP_DELETE, [](AsyncWebServerRequest* request) {
+    logSink->clear();
+    logFlushTask->requestEarlyRun();
+    request->send(200);
+  });
+
+  logger.forwardTo(logSink);
 }
 
 void yasolr_init_logging() {
@@ -84,10 +374,8 @@ void yasolr_init_logging() {
 void yasolr_configure_logging() {
   logger.info(TAG, "Initialize logging");
 
-  if (LittleFS.remove(YASOLR_LOG_FILE))
-    logger.info(TAG, "Previous log file removed");
-
   if (config.getBool(KEY_ENABLE_DEBUG)) {
+    logFilter.setDefaultLevel(ARDUHAL_LOG_LEVEL_DEBUG);
     logger.setLevel(ARDUHAL_LOG_LEVEL_DEBUG);
     esp_log_level_set("*", static_cast<esp_log_level_t>(ARDUHAL_LOG_LEVEL_DEBUG));
 
@@ -96,9 +384,12 @@ void yasolr_configure_logging() {
 
     loggingTask = new Mycila::Task("Debug", [](void* params) {
       logger.info(TAG, "Free Heap: %" PRIu32, ESP.getFreeHeap());
+      logger.info(TAG, "CPU: %s", cpuProfiler.toString().c_str());
+      logger.info(TAG, "Trace Log: %" PRIu32 " dropped", traceLog.getDropped());
       Mycila::TaskMonitor.log();
       coreTaskManager.log();
       unsafeTaskManager.log();
+      uiTaskManager.log();
       if (jsyTaskManager)
         jsyTaskManager->log();
       if (pzemTaskManager)
@@ -110,8 +401,53 @@ void yasolr_configure_logging() {
 
     unsafeTaskManager.addTask(*loggingTask);
 
+    // CPU load is only sampled in debug mode
+    cpuProfilerTask = new Mycila::Task("CPU Profiler", [](void* params) { cpuProfiler.sample(); });
+    cpuProfilerTask->setInterval(YASOLR_CPU_PROFILER_INTERVAL);
+    unsafeTaskManager.addTask(*cpuProfilerTask);
+
   } else {
+    // logs are not buffered: nothing to recover from this boot and the files of the previous debug sessions are removed
+    removeLogFiles();
+    logBuffer.magic = 0;
+    logFilter.setDefaultLevel(ARDUHAL_LOG_LEVEL_INFO);
     logger.setLevel(ARDUHAL_LOG_LEVEL_INFO);
     esp_log_level_set("*", static_cast<esp_log_level_t>(ARDUHAL_LOG_LEVEL_INFO));
   }
+
+  // hot path debug logs are only recorded at the call site and formatted here.
+  // the task always exists so that the debug level of a tag can be raised at runtime: it is idle while the trace log is empty.
+  traceLog.setEnabled(logFilter.getMaxLevel() >= ARDUHAL_LOG_LEVEL_DEBUG);
+  traceLogTask = new Mycila::Task("Trace Log", [](void* params) {
+    traceLog.drain([](uint32_t time, const char* tag, const char* message) {
+      if (logFilter.isEnabled(tag, ARDUHAL_LOG_LEVEL_DEBUG))
+        logger.debug(tag, "[%" PRIu32 "] %s", time, message);
+    });
+  });
+  traceLogTask->setInterval(YASOLR_TRACE_LOG_INTERVAL);
+  unsafeTaskManager.addTask(*traceLogTask);
+}
+
+bool yasolr_set_log_level(const char* tag, const char* level) {
+  const int8_t l = Mycila::LogFilter::parseLevel(level);
+  if (l < 0)
+    return false;
+
+  if (tag[0] == '\0' || strcmp(tag, "*") == 0) {
+    logFilter.clear();
+    logFilter.setDefaultLevel(l);
+    esp_log_level_set("*", static_cast<esp_log_level_t>(l));
+  } else {
+    if (!logFilter.setLevel(tag, l))
+      return false;
+    esp_log_level_set(tag, static_cast<esp_log_level_t>(l));
+  }
+
+  // the logger filters on its own level first: it must let the most verbose tag through
+  logger.setLevel(logFilter.getMaxLevel());
+  // the hot path debug logs are only recorded when a tag is at debug level or more
+  traceLog.setEnabled(logFilter.getMaxLevel() >= ARDUHAL_LOG_LEVEL_DEBUG);
+
+  logger.info(TAG, "Log level of '%s' set to %s", tag[0] == '\0' ? "*" : tag, Mycila::LogFilter::levelName(l));
+  return true;
 }
@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2023-2024 Mathieu Carbou
+ */
+#include <yasolr.h>
+
+Mycila::ModbusMeter* modbusMeter = nullptr;
+Mycila::Task* modbusMeterConnectTask = nullptr;
+
+static Mycila::Task* modbusMeterReadTask = nullptr;
+
+static Mycila::AdaptiveInterval readInterval(YASOLR_GRID_POLL_INTERVAL_MIN, YASOLR_GRID_POLL_INTERVAL_MAX, YASOLR_GRID_POLL_ACTIVITY_LOW, YASOLR_GRID_POLL_ACTIVITY_HIGH, YASOLR_GRID_POLL_VARIANCE_ALPHA);
+
+static void connect() {
+  modbusMeter->end();
+  const char* server = settings.modbusMeterServer.c_str();
+  uint16_t port = static_cast<uint16_t>(settings.modbusMeterPort);
+  const Mycila::Modbus::Map* map = Mycila::Modbus::findMap(settings.modbusMeterModel.c_str());
+  // the model can be changed at runtime: it is checked again at each connection
+  if (!map) {
+    logger.error(TAG, "Unsupported Modbus TCP meter: %s", settings.modbusMeterModel.c_str());
+    return;
+  }
+  modbusMeter->begin(server, port, *map);
+}
+
+void yasolr_init_modbus_meter() {
+  if (config.getBool(KEY_ENABLE_MODBUS_METER)) {
+    logger.info(TAG, "Initialize Modbus TCP meter %s", config.get(KEY_MODBUS_METER_MODEL));
+
+    if (!config.getString(KEY_MODBUS_METER_SERVER).length()) {
+      logger.error(TAG, "Modbus TCP server is not set");
+      return;
+    }
+
+    if (!Mycila::Modbus::findMap(config.get(KEY_MODBUS_METER_MODEL))) {
+      logger.error(TAG, "Unsupported Modbus TCP meter: %s", config.get(KEY_MODBUS_METER_MODEL));
+      return;
+    }
+
+    // class handling Modbus TCP connection
+    modbusMeter = new Mycila::ModbusMeter();
+
+    // when receiving data from the meter, update grid metrics
+    modbusMeter->setCallback([](Mycila::ModbusMeter::EventType eventType) {
+      if (eventType == Mycila::ModbusMeter::EventType::EVT_READ) {
+        const Mycila::Modbus::Metrics& metrics = modbusMeter->getMetrics();
+        grid.remoteMetrics().update({
+          .apparentPower = metrics.apparentPower,
+          .current = metrics.current,
+          .energy = isnan(metrics.energy) ? 0 : static_cast<uint32_t>(metrics.energy),
+          .energyReturned = isnan(metrics.energyReturned) ? 0 : static_cast<uint32_t>(metrics.energyReturned),
+          .frequency = metrics.frequency,
+          .power = metrics.power,
+          .powerFactor = metrics.powerFactor,
+          .voltage = metrics.voltage,
+        });
+
+        if (grid.updatePower()) {
+          yasolr_divert();
+        }
+
+        // poll faster when grid power moves or when the PID is far from its setpoint.
+        // the PID error only counts while a dimmer can act on it: saturated outputs (at night or at full power) keep a large error.
+        modbusMeterReadTask->setInterval(readInterval.update(metrics.power, router.isRegulating() ? pidController.getError() : NAN));
+      }
+    });
+
+    // task called once network is up to connect
+    modbusMeterConnectTask = new Mycila::Task("Modbus Connect", Mycila::Task::Type::ONCE, [](void* params) { connect(); });
+
+    // reader: a read is skipped while the previous one is still in flight
+    modbusMeterReadTask = new Mycila::Task("Modbus Read", [](void* params) { modbusMeter->read(); });
+    modbusMeterReadTask->setInterval(readInterval.getInterval());
+
+    // I/O tasks pinned to unsafe task manager
+    unsafeTaskManager.addTask(*modbusMeterConnectTask);
+    unsafeTaskManager.addTask(*modbusMeterReadTask);
+
+    if (config.getBool(KEY_ENABLE_DEBUG)) {
+      modbusMeterConnectTask->enableProfiling();
+      modbusMeterReadTask->enableProfiling();
+    }
+  }
+}
@@ -20,16 +20,16 @@ static Mycila::Task* haDiscoveryTask = nullptr;
 static void connect() {
   mqtt->end();
 
-  bool secured = config.getBool(KEY_MQTT_SECURED);
+  bool secured = settings.mqttSecured;
 
   Mycila::MQTT::Config mqttConfig;
-  mqttConfig.server = config.getString(KEY_MQTT_SERVER);
-  mqttConfig.port = static_cast<uint16_t>(config.getLong(KEY_MQTT_PORT));
+  mqttConfig.server = settings.mqttServer;
+  mqttConfig.port = static_cast<uint16_t>(settings.mqttPort);
   mqttConfig.secured = secured;
-  mqttConfig.username = config.getString(KEY_MQTT_USERNAME);
-  mqttConfig.password = config.getString(KEY_MQTT_PASSWORD);
+  mqttConfig.username = settings.mqttUsername;
+  mqttConfig.password = settings.mqttPassword;
   mqttConfig.clientId = Mycila::AppInfo.defaultMqttClientId;
-  mqttConfig.willTopic = config.getString(KEY_MQTT_TOPIC) + YASOLR_MQTT_WILL_TOPIC;
+  mqttConfig.willTopic = settings.mqttTopic + YASOLR_MQTT_WILL_TOPIC;
   mqttConfig.keepAlive = YASOLR_MQTT_KEEPALIVE;
 
   if (secured) {
@@ -56,7 +56,7 @@ static void connect() {
 static void subscribe() {
   logger.info(TAG, "Subscribing to MQTT topics");
 
-  const std::string& baseTopic = config.getString(KEY_MQTT_TOPIC);
+  const std::string& baseTopic = settings.mqttTopic;
 
   // config
 
@@ -141,37 +141,27 @@ static void subscribe() {
     restartTask.resume();
   });
 
+  // logging: <topic>/system/logging/<tag>/set with the level as payload
+
+  mqtt->subscribe(baseTopic + "/system/logging/+/set", [](const std::string& topic, const std::string_view& payload) {
+    const std::size_t end = topic.rfind("/set");
+    if (end == std::string::npos)
+      return;
+    const std::size_t start = topic.rfind("/", end - 1);
+    yasolr_set_log_level(topic.substr(start + 1, end - start - 1).c_str(), std::string(payload).c_str());
+  });
+
   // grid power
   const char* gridPowerMQTTTopic = config.get(KEY_GRID_POWER_MQTT_TOPIC);
   if (gridPowerMQTTTopic[0] != '\0') {
     logger.info(TAG, "Reading Grid Power from MQTT topic: %s", gridPowerMQTTTopic);
     mqtt->subscribe(gridPowerMQTTTopic, [](const std::string& topic, const std::string_view& payload) {
-      if (payload.length()) {
-        float p = NAN;
-
-        // check if first character is '{' for json data
-        if (payload[0] == '{') {
-          JsonDocument doc;
-          if (deserializeJson(doc, payload) == DeserializationError::Ok) {
-            // Shelly EM example: shellyproem50/status/em1:0
-            // {"id":1,"current":2.681,"voltage":236.7,"act_power":-607.3,"aprt_power":636.0,"pf":0.95,"freq":50.0,"calibration":"factory"}
-            // Shelly 3EM example: shellypowermeter/status/em:0
-            // {"id":0,"a_current":0.132,"a_voltage":236.0,"a_act_power":3.9,"a_aprt_power":31.0,"a_pf":-0.53,"b_current":0.594,"b_voltage":236.4,"b_act_power":45.4,"b_aprt_power":140.3,"b_pf":-0.61,"c_current":0.368,"c_voltage":237.8,"c_act_power":54.3,"c_aprt_power":87.5,"c_pf":-0.72,"n_current":null,"total_current":1.094,"total_act_power":103.610,"total_aprt_power":258.799, "user_calibrated_phase":[]}
-            p = doc["act_power"] | (doc["total_act_power"] | NAN);
-          }
-
-        } else {
-          // direct value ?
-          if (std::from_chars(payload.begin(), payload.end(), p).ec != std::errc{})
-            p = NAN;
-        }
-
-        if (!isnan(p)) {
-          logger.debug(TAG, "Grid Power from MQTT: %f", p);
-          grid.mqttPower().update(p);
-          if (grid.updatePower()) {
-            yasolr_divert();
-          }
+      const float p = Mycila::Payload::parseGridPower(payload);
+      if (!isnan(p)) {
+        traceLog.debug(TAG, "Grid Power from MQTT: %f", p);
+        grid.mqttPower().update(p);
+        if (grid.updatePower()) {
+          yasolr_divert();
         }
       }
     });
@@ -182,30 +172,10 @@ static void subscribe() {
   if (gridVoltageMQTTTopic[0] != '\0') {
     logger.info(TAG, "Reading Grid Voltage from MQTT topic: %s", gridVoltageMQTTTopic);
     mqtt->subscribe(gridVoltageMQTTTopic, [](const std::string& topic, const std::string_view& payload) {
-      if (payload.length()) {
-        float v = NAN;
-
-        // check if first character is '{' for json data
-        if (payload[0] == '{') {
-          JsonDocument doc;
-          if (deserializeJson(doc, payload) == DeserializationError::Ok) {
-            // Shelly EM example: shellyproem50/status/em1:0
-            // {"id":1,"current":2.681,"voltage":236.7,"act_power":-607.3,"aprt_power":636.0,"pf":0.95,"freq":50.0,"calibration":"factory"}
-            // Shelly 3EM example: shellypowermeter/status/em:0
-            // {"id":0,"a_current":0.132,"a_voltage":236.0,"a_act_power":3.9,"a_aprt_power":31.0,"a_pf":-0.53,"b_current":0.594,"b_voltage":236.4,"b_act_power":45.4,"b_aprt_power":140.3,"b_pf":-0.61,"c_current":0.368,"c_voltage":237.8,"c_act_power":54.3,"c_aprt_power":87.5,"c_pf":-0.72,"n_current":null,"total_current":1.094,"total_act_power":103.610,"total_aprt_power":258.799, "user_calibrated_phase":[]}
-            v = doc["voltage"] | (doc["a_voltage"] | (doc["b_voltage"] | (doc["c_voltage"] | NAN)));
-          }
-
-        } else {
-          // direct value
-          if (std::from_chars(payload.begin(), payload.end(), v).ec != std::errc{})
-            v = NAN;
-        }
-
-        if (!isnan(v)) {
-          logger.debug(TAG, "Grid Voltage from MQTT: %f", v);
-          grid.mqttVoltage().update(v);
-        }
+      const float v = Mycila::Payload::parseGridVoltage(payload);
+      if (!isnan(v)) {
+        traceLog.debug(TAG, "Grid Voltage from MQTT: %f", v);
+        grid.mqttVoltage().update(v);
       }
     });
   }
@@ -216,9 +186,9 @@ static void subscribe() {
     logger.info(TAG, "Reading Output 1 Temperature from MQTT topic: %s", output1TemperatureMQTTTopic);
     mqtt->subscribe(output1TemperatureMQTTTopic, [](const std::string& topic, const std::string_view& payload) {
       if (output1) {
-        float t;
-        if (std::from_chars(payload.begin(), payload.end(), t).ec == std::errc{}) {
-          logger.debug(TAG, "Output 1 Temperature from MQTT: %f", t);
+        const float t = Mycila::Payload::parseNumber(payload);
+        if (!isnan(t)) {
+          traceLog.debug(TAG, "Output 1 Temperature from MQTT: %f", t);
           output1->temperature().update(t);
         }
       }
@@ -231,9 +201,9 @@ static void subscribe() {
     logger.info(TAG, "Reading Output 2 Temperature from MQTT topic: %s", output2TemperatureMQTTTopic);
     mqtt->subscribe(output2TemperatureMQTTTopic, [](const std::string& topic, const std::string_view& payload) {
       if (output2) {
-        float t;
-        if (std::from_chars(payload.begin(), payload.end(), t).ec == std::errc{}) {
-          logger.debug(TAG, "Output 2 Temperature from MQTT: %f", t);
+        const float t = Mycila::Payload::parseNumber(payload);
+        if (!isnan(t)) {
+          traceLog.debug(TAG, "Output 2 Temperature from MQTT: %f", t);
           output2->temperature().update(t);
         }
       }
@@ -243,7 +213,7 @@ static void subscribe() {
 
 static void publishConfig() {
   logger.info(TAG, "Publishing config to MQTT");
-  const std::string& baseTopic = config.getString(KEY_MQTT_TOPIC);
+  const std::string& baseTopic = settings.mqttTopic;
 
   for (auto& key : config.keys()) {
     const char* value = config.get(key);
@@ -255,7 +225,7 @@ static void publishConfig() {
 
 static void publishStaticData() {
   logger.info(TAG, "Publishing static data to MQTT");
-  const std::string& baseTopic = config.getString(KEY_MQTT_TOPIC);
+  const std::string& baseTopic = settings.mqttTopic;
 
   mqtt->publish(baseTopic + "/system/app/manufacturer", Mycila::AppInfo.manufacturer, true);
   mqtt->publish(baseTopic + "/system/app/model", Mycila::AppInfo.model, true);
@@ -285,7 +255,7 @@ static void publishStaticData() {
 }
 
 static void publishData() {
-  const std::string& baseTopic = config.getString(KEY_MQTT_TOPIC);
+  const std::string& baseTopic = settings.mqttTopic;
 
   Mycila::System::Memory* memory = new Mycila::System::Memory();
   Mycila::System::getMemory(*memory);
@@ -295,6 +265,11 @@ static void publishData() {
   mqtt->publish(baseTopic + "/system/device/uptime", std::to_string(Mycila::System::getUptime()));
   delete memory;
   memory = nullptr;
+  const Mycila::HeapMonitor::Stats& heap = heapMonitor.get(Mycila::HeapMonitor::Pool::INTERNAL);
+  mqtt->publish(baseTopic + "/system/device/heap/fragmentation", std::to_string(heap.fragmentation));
+  mqtt->publish(baseTopic + "/system/device/heap/largest_free_block", std::to_string(heap.largestFreeBlock));
+  mqtt->publish(baseTopic + "/system/device/heap/min_free", std::to_string(heap.minFree));
+  mqtt->publish(baseTopic + "/system/device/heap/trend", std::to_string(heapMonitor.getTrend()));
   yield();
 
   mqtt->publish(baseTopic + "/system/network/eth/ip_address", espConnect.getIPAddress(Mycila::ESPConnect::Mode::ETH).toString().c_str());
@@ -380,8 +355,8 @@ static void haDiscovery() {
 
   Mycila::HA::Discovery haDiscovery;
 
-  haDiscovery.setDiscoveryTopic(config.get(KEY_HA_DISCOVERY_TOPIC));
-  haDiscovery.setWillTopic(config.getString(KEY_MQTT_TOPIC) + YASOLR_MQTT_WILL_TOPIC);
+  haDiscovery.setDiscoveryTopic(settings.haDiscoveryTopic.c_str());
+  haDiscovery.setWillTopic(settings.mqttTopic + YASOLR_MQTT_WILL_TOPIC);
   haDiscovery.begin({
                       .id = Mycila::AppInfo.defaultMqttClientId,
                       .name = Mycila::AppInfo.defaultHostname,
@@ -390,7 +365,7 @@ static void haDiscovery() {
                       .manufacturer = Mycila::AppInfo.manufacturer,
                       .url = std::string("http://") + espConnect.getIPAddress().toString().c_str(),
                     },
-                    config.get(KEY_MQTT_TOPIC),
+                    settings.mqttTopic.c_str(),
                     512,
                     [](const char* topic, const char* payload) { mqtt->publish(topic, payload, true); });
 
@@ -401,6 +376,8 @@ static void haDiscovery() {
   haDiscovery.publish(Mycila::HA::Counter("device_uptime", "Device: Uptime", "/system/device/uptime", "duration", nullptr, "s", Mycila::HA::Category::DIAGNOSTIC));
   haDiscovery.publish(Mycila::HA::Gauge("device_heap_usage", "Device: Heap Usage", "/system/device/heap/usage", nullptr, "mdi:memory", "%", Mycila::HA::Category::DIAGNOSTIC));
   haDiscovery.publish(Mycila::HA::Gauge("device_heap_used", "Device: Heap Used", "/system/device/heap/used", "data_size", "mdi:memory", "B", Mycila::HA::Category::DIAGNOSTIC));
+  haDiscovery.publish(Mycila::HA::Gauge("device_heap_fragmentation", "Device: Heap Fragmentation", "/system/device/heap/fragmentation", nullptr, "mdi:memory", "%", Mycila::HA::Category::DIAGNOSTIC));
+  haDiscovery.publish(Mycila::HA::Gauge("device_heap_largest_free_block", "Device: Heap Largest Free Block", "/system/device/heap/largest_free_block", "data_size", "mdi:memory", "B", Mycila::HA::Category::DIAGNOSTIC));
   haDiscovery.publish(Mycila::HA::Gauge("network_wifi_quality", "Net: WiFi Signal", "/system/network/wifi/quality", nullptr, "mdi:signal", "%", Mycila::HA::Category::DIAGNOSTIC));
   haDiscovery.publish(Mycila::HA::Gauge("network_wifi_rssi", "Net: WiFi RSSI", "/system/network/wifi/rssi", "signal_strength", "mdi:signal", "dBm", Mycila::HA::Category::DIAGNOSTIC));
   haDiscovery.publish(Mycila::HA::Value("device_id", "Device: ID", "/system/device/id", nullptr, "mdi:identifier", Mycila::HA::Category::DIAGNOSTIC));
@@ -500,11 +477,12 @@ void yasolr_init_mqtt() {
 
     subscribe();
 
-    haDiscoveryTask->setEnabledWhen([]() { return mqtt->isConnected() && config.getBool(KEY_ENABLE_HA_DISCOVERY) && !config.isEmpty(KEY_HA_DISCOVERY_TOPIC); });
+    haDiscoveryTask->setEnabledWhen([]() { return mqtt->isConnected() && settings.haDiscovery && !settings.haDiscoveryTopic.empty(); });
     mqttPublishConfigTask->setEnabledWhen([]() { return mqtt->isConnected(); });
     mqttPublishStaticTask->setEnabledWhen([]() { return mqtt->isConnected(); });
     mqttPublishTask->setEnabledWhen([]() { return mqtt->isConnected(); });
-    mqttPublishTask->setInterval(config.getLong(KEY_MQTT_PUBLISH_INTERVAL) * 1000);
+    mqttPublishTask->setInterval(settings.mqttPublishInterval * 1000);
+    settings.listen(YaSolR::Setting::MQTT_PUBLISH_INTERVAL, []() { mqttPublishTask->setInterval(settings.mqttPublishInterval * 1000); });
 
     unsafeTaskManager.addTask(*mqttConnectTask);
     unsafeTaskManager.addTask(*haDiscoveryTask);
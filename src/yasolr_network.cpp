@@ -16,10 +16,10 @@ static Mycila::Task networkStartTask("Network Start", Mycila::Task::Type::ONCE,
     request->send(404);
   });
 
-  if (!config.getBool(KEY_ENABLE_AP_MODE)) {
+  if (!settings.apMode) {
     // NTP
     logger.info(TAG, "Enable NTP");
-    Mycila::NTP.sync(config.get(KEY_NTP_SERVER));
+    Mycila::NTP.sync(settings.ntpServer.c_str());
 
     // mDNS
     logger.info(TAG, "Enable mDNS");
@@ -31,8 +31,12 @@ static Mycila::Task networkStartTask("Network Start", Mycila::Task::Type::ONCE,
     if (mqttConnectTask)
       mqttConnectTask->resume();
 
-    if (victronConnectTask) {
-      victronConnectTask->resume();
+    if (modbusMeterConnectTask) {
+      modbusMeterConnectTask->resume();
+    }
+
+    if (httpMeterConnectTask) {
+      httpMeterConnectTask->resume();
     }
   }
 });
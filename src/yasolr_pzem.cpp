@@ -9,6 +9,10 @@ Mycila::PZEM* pzemO2 = nullptr;
 Mycila::Task* pzemO1PairingTask = nullptr;
 Mycila::Task* pzemO2PairingTask = nullptr;
 Mycila::TaskManager* pzemTaskManager = nullptr;
+Mycila::UARTBus* pzemBus = nullptr;
+
+static size_t pzemO1Device = 0;
+static size_t pzemO2Device = 0;
 
 void yasolr_init_pzem() {
   uint8_t count = 0;
@@ -59,18 +63,18 @@ void yasolr_init_pzem() {
         logger.info(TAG, "Pairing connected PZEM to Output 1");
         pzemO1->end();
 
-        if (config.getString(KEY_PZEM_UART) == YASOLR_UART_1_NAME)
-          pzemO1->begin(Serial1, config.getLong(KEY_PIN_PZEM_RX), config.getLong(KEY_PIN_PZEM_TX), MYCILA_PZEM_ADDRESS_GENERAL);
+        if (settings.pzemUart == YASOLR_UART_1_NAME)
+          pzemO1->begin(Serial1, settings.pzemPinRx, settings.pzemPinTx, MYCILA_PZEM_ADDRESS_GENERAL);
 
 #if SOC_UART_NUM > 2
-        if (config.getString(KEY_PZEM_UART) == YASOLR_UART_2_NAME)
-          pzemO1->begin(Serial2, config.getLong(KEY_PIN_PZEM_RX), config.getLong(KEY_PIN_PZEM_TX), MYCILA_PZEM_ADDRESS_GENERAL);
+        if (settings.pzemUart == YASOLR_UART_2_NAME)
+          pzemO1->begin(Serial2, settings.pzemPinRx, settings.pzemPinTx, MYCILA_PZEM_ADDRESS_GENERAL);
 #endif
 
         switch (pzemO1->getDeviceAddress()) {
           case YASOLR_PZEM_ADDRESS_OUTPUT1:
             // already paired
-            if (!config.getBool(KEY_ENABLE_OUTPUT1_PZEM)) {
+            if (!settings.output1PZEM) {
               // stop PZEM if it was not enabled
               pzemO1->end();
             }
@@ -84,7 +88,7 @@ void yasolr_init_pzem() {
           default:
             // found a device
             if (pzemO1->setDeviceAddress(YASOLR_PZEM_ADDRESS_OUTPUT1)) {
-              if (!config.getBool(KEY_ENABLE_OUTPUT1_PZEM)) {
+              if (!settings.output1PZEM) {
                 // stop PZEM if it was not enabled
                 pzemO1->end();
               }
@@ -153,18 +157,18 @@ void yasolr_init_pzem() {
         logger.info(TAG, "Pairing connected PZEM to Output 2");
         pzemO2->end();
 
-        if (config.getString(KEY_PZEM_UART) == YASOLR_UART_1_NAME)
-          pzemO2->begin(Serial1, config.getLong(KEY_PIN_PZEM_RX), config.getLong(KEY_PIN_PZEM_TX), MYCILA_PZEM_ADDRESS_GENERAL);
+        if (settings.pzemUart == YASOLR_UART_1_NAME)
+          pzemO2->begin(Serial1, settings.pzemPinRx, settings.pzemPinTx, MYCILA_PZEM_ADDRESS_GENERAL);
 
 #if SOC_UART_NUM > 2
-        if (config.getString(KEY_PZEM_UART) == YASOLR_UART_2_NAME)
-          pzemO2->begin(Serial2, config.getLong(KEY_PIN_PZEM_RX), config.getLong(KEY_PIN_PZEM_TX), MYCILA_PZEM_ADDRESS_GENERAL);
+        if (settings.pzemUart == YASOLR_UART_2_NAME)
+          pzemO2->begin(Serial2, settings.pzemPinRx, settings.pzemPinTx, MYCILA_PZEM_ADDRESS_GENERAL);
 #endif
 
         switch (pzemO2->getDeviceAddress()) {
           case YASOLR_PZEM_ADDRESS_OUTPUT2:
             // already paired
-            if (!config.getBool(KEY_ENABLE_OUTPUT2_PZEM)) {
+            if (!settings.output2PZEM) {
               // stop PZEM if it was not enabled
               pzemO2->end();
             }
@@ -178,7 +182,7 @@ void yasolr_init_pzem() {
           default:
             // found a device
             if (pzemO2->setDeviceAddress(YASOLR_PZEM_ADDRESS_OUTPUT2)) {
-              if (!config.getBool(KEY_ENABLE_OUTPUT2_PZEM)) {
+              if (!settings.output2PZEM) {
                 // stop PZEM if it was not enabled
                 pzemO2->end();
               }
@@ -202,17 +206,26 @@ void yasolr_init_pzem() {
   }
 
   if (count) {
+    pzemBus = new Mycila::UARTBus("pzem");
+
+    if (pzemO1)
+      pzemO1Device = pzemBus->addDevice("output1", []() { return pzemO1->read(); });
+    if (pzemO2)
+      pzemO2Device = pzemBus->addDevice("output2", []() { return pzemO2->read(); });
+
     pzemTaskManager = new Mycila::TaskManager("y-pzem");
 
+    // one transaction per run so that a missing PZEM does not delay the other one
     Mycila::Task* pzemTask = new Mycila::Task("PZEM", [](void* params) {
-      if (pzemO1) {
-        pzemO1->read();
-        yield();
-      }
-      if (pzemO2) {
-        pzemO2->read();
+      // outputs which are not routing are polled less often
+      if (pzemO1)
+        pzemBus->setInterval(pzemO1Device, output1 && output1->isOn() ? 0 : YASOLR_PZEM_IDLE_INTERVAL);
+      if (pzemO2)
+        pzemBus->setInterval(pzemO2Device, output2 && output2->isOn() ? 0 : YASOLR_PZEM_IDLE_INTERVAL);
+      if (pzemBus->poll())
         yield();
-      }
+      else
+        delay(10);
     });
     pzemTask->setEnabledWhen([]() { return (!pzemO1PairingTask || pzemO1PairingTask->paused()) && (!pzemO2PairingTask || pzemO2PairingTask->paused()); });
     pzemTaskManager->addTask(*pzemTask);
@@ -61,20 +61,24 @@ void yasolr_init_relays() {
   }
 
   if (count) {
+    static Mycila::TaskBudget relayBudget("Relay", YASOLR_BUDGET_RELAY);
+
     Mycila::Task* relayTask = new Mycila::Task("Relay", [](void* params) {
-      if (grid.getPower().isAbsent())
-        return;
+      relayBudget.run([]() {
+        if (grid.getPower().isAbsent())
+          return;
 
-      Mycila::Router::Metrics routerMetrics;
-      router.getRouterMeasurements(routerMetrics);
+        Mycila::Router::Metrics routerMetrics;
+        router.getRouterMeasurements(routerMetrics);
 
-      float virtualGridPower = grid.getPower().get() - routerMetrics.power;
+        float virtualGridPower = grid.getPower().get() - routerMetrics.power;
 
-      if (relay1 && relay1->autoSwitch(virtualGridPower))
-        return;
+        if (relay1 && relay1->autoSwitch(virtualGridPower))
+          return;
 
-      if (relay2 && relay2->autoSwitch(virtualGridPower))
-        return;
+        if (relay2 && relay2->autoSwitch(virtualGridPower))
+          return;
+      });
     });
 
     relayTask->setEnabledWhen([]() { return !router.isCalibrationRunning() && ((relay1 && relay1->isAutoRelayEnabled()) || (relay2 && relay2->isAutoRelayEnabled())); });
@@ -25,21 +25,26 @@ static Mycila::Dimmer* dimmer2 = nullptr;
 
 static Mycila::Task calibrationTask("Calibration", [](void* params) { router.continueCalibration(); });
 
+static Mycila::TaskBudget routerBudget("Router", YASOLR_BUDGET_ROUTER, YASOLR_DEADLINE_ROUTER);
+
 static Mycila::Task routerTask("Router", [](void* params) {
-  std::optional<float> voltage = grid.getVoltage();
+  yasolr_supervisor_control_cycle();
+  routerBudget.run([]() {
+    std::optional<float> voltage = grid.getVoltage();
 
-  if (!voltage.has_value() || grid.getPower().isAbsent())
-    router.noDivert();
+    if (!voltage.has_value() || grid.getPower().isAbsent())
+      router.noDivert();
 
-  if (output1) {
-    output1->applyTemperatureLimit();
-    output1->applyAutoBypass();
-  }
+    if (output1) {
+      output1->applyTemperatureLimit();
+      output1->applyAutoBypass();
+    }
 
-  if (output2) {
-    output2->applyTemperatureLimit();
-    output2->applyAutoBypass();
-  }
+    if (output2) {
+      output2->applyTemperatureLimit();
+      output2->applyAutoBypass();
+    }
+  });
 });
 
 static Mycila::Task* frequencyMonitorTask;
@@ -140,6 +145,75 @@ static Mycila::Relay* createBypassRelay(const char* keyEnable, const char* keyTy
   return nullptr;
 }
 
+typedef struct {
+    const bool& autoBypass;
+    const bool& autoDimmer;
+    const uint32_t& autoStartTemperature;
+    const std::string& autoStartTime;
+    const uint32_t& autoStopTemperature;
+    const std::string& autoStopTime;
+    const float& calibratedResistance;
+    const uint32_t& dimmerTempLimit;
+    const uint32_t& excessPowerLimiter;
+    const std::string& weekDays;
+    const float& dutyCycleMin;
+    const float& dutyCycleMax;
+    const float& dutyCycleLimit;
+} OutputSettings;
+
+static const OutputSettings output1Settings = {
+  settings.output1AutoBypass,
+  settings.output1AutoDimmer,
+  settings.output1TemperatureStart,
+  settings.output1TimeStart,
+  settings.output1TemperatureStop,
+  settings.output1TimeStop,
+  settings.output1Resistance,
+  settings.output1DimmerTempLimiter,
+  settings.output1ExcessLimiter,
+  settings.output1Days,
+  settings.output1DimmerMin,
+  settings.output1DimmerMax,
+  settings.output1DimmerLimit,
+};
+
+static const OutputSettings output2Settings = {
+  settings.output2AutoBypass,
+  settings.output2AutoDimmer,
+  settings.output2TemperatureStart,
+  settings.output2TimeStart,
+  settings.output2TemperatureStop,
+  settings.output2TimeStop,
+  settings.output2Resistance,
+  settings.output2DimmerTempLimiter,
+  settings.output2ExcessLimiter,
+  settings.output2Days,
+  settings.output2DimmerMin,
+  settings.output2DimmerMax,
+  settings.output2DimmerLimit,
+};
+
+// the whole output configuration is staged at once so that several keys changed together are applied in the same control cycle
+static void configureOutput(Mycila::RouterOutput* output, const OutputSettings& values) {
+  if (!output)
+    return;
+  Mycila::RouterOutput::Config outputConfig;
+  outputConfig.autoBypass = values.autoBypass;
+  outputConfig.autoDimmer = values.autoDimmer;
+  outputConfig.autoStartTemperature = values.autoStartTemperature;
+  outputConfig.autoStartTime = values.autoStartTime;
+  outputConfig.autoStopTemperature = values.autoStopTemperature;
+  outputConfig.autoStopTime = values.autoStopTime;
+  outputConfig.calibratedResistance = values.calibratedResistance;
+  outputConfig.dimmerTempLimit = values.dimmerTempLimit;
+  outputConfig.excessPowerLimiter = values.excessPowerLimiter;
+  outputConfig.weekDays = values.weekDays;
+  output->setConfig(outputConfig,
+                    values.dutyCycleMin / 100.0f,
+                    values.dutyCycleMax / 100.0f,
+                    values.dutyCycleLimit / 100.0f);
+}
+
 static void initOutput1(uint16_t semiPeriod) {
   dimmer1 = createDimmer(1, KEY_ENABLE_OUTPUT1_DIMMER, KEY_OUTPUT1_DIMMER_TYPE, KEY_PIN_OUTPUT1_DIMMER);
   Mycila::Relay* bypassRelay = createBypassRelay(KEY_ENABLE_OUTPUT1_RELAY, KEY_OUTPUT1_RELAY_TYPE, KEY_PIN_OUTPUT1_RELAY);
@@ -153,22 +227,12 @@ static void initOutput1(uint16_t semiPeriod) {
 
   if (dimmer1) {
     output1 = new Mycila::RouterOutput("output1", *dimmer1, bypassRelay);
+    output1->setTraceLog(&traceLog);
 
     dimmer1->setSemiPeriod(semiPeriod);
-    dimmer1->setDutyCycleMin(config.getFloat(KEY_OUTPUT1_DIMMER_MIN) / 100.0f);
-    dimmer1->setDutyCycleMax(config.getFloat(KEY_OUTPUT1_DIMMER_MAX) / 100.0f);
-    dimmer1->setDutyCycleLimit(config.getFloat(KEY_OUTPUT1_DIMMER_LIMIT) / 100.0f);
-
-    output1->config.autoBypass = config.getBool(KEY_ENABLE_OUTPUT1_AUTO_BYPASS);
-    output1->config.autoDimmer = config.getBool(KEY_ENABLE_OUTPUT1_AUTO_DIMMER);
-    output1->config.autoStartTemperature = config.getLong(KEY_OUTPUT1_TEMPERATURE_START);
-    output1->config.autoStartTime = config.get(KEY_OUTPUT1_TIME_START);
-    output1->config.autoStopTemperature = config.getLong(KEY_OUTPUT1_TEMPERATURE_STOP);
-    output1->config.autoStopTime = config.get(KEY_OUTPUT1_TIME_STOP);
-    output1->config.calibratedResistance = config.getFloat(KEY_OUTPUT1_RESISTANCE);
-    output1->config.dimmerTempLimit = config.getInt(KEY_OUTPUT1_DIMMER_TEMP_LIMITER);
-    output1->config.excessPowerLimiter = config.getInt(KEY_OUTPUT1_EXCESS_LIMITER);
-    output1->config.weekDays = config.get(KEY_OUTPUT1_DAYS);
+
+    configureOutput(output1, output1Settings);
+
     output1->localMetrics().setExpiration(10000);                             // local is fast
     output1->temperature().setExpiration(YASOLR_MQTT_MEASUREMENT_EXPIRATION); // local or through mqtt
 
@@ -189,22 +253,12 @@ static void initOutput2(uint16_t semiPeriod) {
 
   if (dimmer2) {
     output2 = new Mycila::RouterOutput("output2", *dimmer2, bypassRelay);
+    output2->setTraceLog(&traceLog);
 
     dimmer2->setSemiPeriod(semiPeriod);
-    dimmer2->setDutyCycleMin(config.getFloat(KEY_OUTPUT2_DIMMER_MIN) / 100.0f);
-    dimmer2->setDutyCycleMax(config.getFloat(KEY_OUTPUT2_DIMMER_MAX) / 100.0f);
-    dimmer2->setDutyCycleLimit(config.getFloat(KEY_OUTPUT2_DIMMER_LIMIT) / 100.0f);
-
-    output2->config.autoBypass = config.getBool(KEY_ENABLE_OUTPUT2_AUTO_BYPASS);
-    output2->config.autoDimmer = config.getBool(KEY_ENABLE_OUTPUT2_AUTO_DIMMER);
-    output2->config.autoStartTemperature = config.getLong(KEY_OUTPUT2_TEMPERATURE_START);
-    output2->config.autoStartTime = config.get(KEY_OUTPUT2_TIME_START);
-    output2->config.autoStopTemperature = config.getLong(KEY_OUTPUT2_TEMPERATURE_STOP);
-    output2->config.autoStopTime = config.get(KEY_OUTPUT2_TIME_STOP);
-    output2->config.calibratedResistance = config.getFloat(KEY_OUTPUT2_RESISTANCE);
-    output2->config.dimmerTempLimit = config.getInt(KEY_OUTPUT2_DIMMER_TEMP_LIMITER);
-    output2->config.excessPowerLimiter = config.getInt(KEY_OUTPUT2_EXCESS_LIMITER);
-    output2->config.weekDays = config.get(KEY_OUTPUT2_DAYS);
+
+    configureOutput(output2, output2Settings);
+
     output2->localMetrics().setExpiration(10000);                             // local is fast
     output2->temperature().setExpiration(YASOLR_MQTT_MEASUREMENT_EXPIRATION); // local or through mqtt
 
@@ -216,7 +270,8 @@ void yasolr_divert() {
   if (router.isCalibrationRunning())
     return;
 
-  if (!router.isAutoDimmerEnabled())
+  // the supervisor holds the dimmers in a safe state
+  if (yasolr_supervisor_is_safe_state())
     return;
 
   std::optional<float> voltage = grid.getVoltage();
@@ -229,18 +284,40 @@ void yasolr_divert() {
   }
 }
 
+void yasolr_configure_pid() {
+  router.setPIDConfig({
+    .proportionalMode = (Mycila::PID::ProportionalMode)settings.pidPMode,
+    .derivativeMode = (Mycila::PID::DerivativeMode)settings.pidDMode,
+    .integralCorrectionMode = (Mycila::PID::IntegralCorrectionMode)settings.pidICMode,
+    .setPoint = settings.pidSetpoint,
+    .kp = settings.pidKp,
+    .ki = settings.pidKi,
+    .kd = settings.pidKd,
+    .outputMin = settings.pidOutMin,
+    .outputMax = settings.pidOutMax,
+  });
+}
+
+void yasolr_configure_outputs() {
+  configureOutput(output1, output1Settings);
+  configureOutput(output2, output2Settings);
+}
+
+void yasolr_router_safe_state(float dutyCycle) {
+  // dimmers are driven directly, whatever the output mode (auto, manual, bypass)
+  if (dimmer1)
+    dimmer1->setDutyCycle(dutyCycle);
+  if (dimmer2)
+    dimmer2->setDutyCycle(dutyCycle);
+}
+
 void yasolr_init_router() {
   logger.info(TAG, "Initialize router outputs");
 
   // PID Controller
 
   pidController.setReverse(false);
-  pidController.setProportionalMode((Mycila::PID::ProportionalMode)config.getLong(KEY_PID_P_MODE));
-  pidController.setDerivativeMode((Mycila::PID::DerivativeMode)config.getLong(KEY_PID_D_MODE));
-  pidController.setIntegralCorrectionMode((Mycila::PID::IntegralCorrectionMode)config.getLong(KEY_PID_IC_MODE));
-  pidController.setSetPoint(config.getFloat(KEY_PID_SETPOINT));
-  pidController.setTunings(config.getFloat(KEY_PID_KP), config.getFloat(KEY_PID_KI), config.getFloat(KEY_PID_KD));
-  pidController.setOutputLimits(config.getFloat(KEY_PID_OUT_MIN), config.getFloat(KEY_PID_OUT_MAX));
+  yasolr_configure_pid();
 
   // Router
 
@@ -298,6 +375,7 @@ void yasolr_init_router() {
             dimmer2->off();
           }
 
+          website.invalidate({YaSolR::Website::Section::HARDWARE});
           dashboardInitTask.resume();
         } else {
           Thyristor::setSemiPeriod(semiPeriod);
@@ -327,6 +405,7 @@ void yasolr_init_router() {
             dimmer2->setSemiPeriod(0);
           }
 
+          website.invalidate({YaSolR::Website::Section::HARDWARE});
           dashboardInitTask.resume();
         }
       }
@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#include <yasolr.h>
+
+#include <string.h>
+
+static void parse(const char* key, bool& value) { value = config.getBool(key); }
+static void parse(const char* key, int32_t& value) { value = static_cast<int32_t>(config.getLong(key)); }
+static void parse(const char* key, uint32_t& value) { value = static_cast<uint32_t>(config.getLong(key)); }
+static void parse(const char* key, float& value) { value = config.getFloat(key); }
+static void parse(const char* key, std::string& value) { value = config.getString(key); }
+
+static const char* keys[] = {
+#define YASOLR_SETTING_KEY(id, field, type, key) key,
+  YASOLR_SETTINGS(YASOLR_SETTING_KEY)
+#undef YASOLR_SETTING_KEY
+};
+
+const char* YaSolR::Settings::key(Setting setting) { return keys[static_cast<size_t>(setting)]; }
+
+void YaSolR::Settings::load() {
+#define YASOLR_SETTING_LOAD(id, field, type, key) parse(key, field);
+  YASOLR_SETTINGS(YASOLR_SETTING_LOAD)
+#undef YASOLR_SETTING_LOAD
+}
+
+bool YaSolR::Settings::update(const char* key) {
+  // keys are the same pointers as the KEY_ macros passed to config.set(), but the listener may get a copy
+  for (size_t i = 0; i < static_cast<size_t>(Setting::COUNT); i++) {
+    if (keys[i] == key || strcmp(keys[i], key) == 0) {
+      switch (static_cast<Setting>(i)) {
+#define YASOLR_SETTING_UPDATE(id, field, type, key) \
+  case Setting::id:                                 \
+    parse(key, field);                              \
+    break;
+        YASOLR_SETTINGS(YASOLR_SETTING_UPDATE)
+#undef YASOLR_SETTING_UPDATE
+        default:
+          break;
+      }
+      for (auto& listener : _listeners[i])
+        listener();
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#include <yasolr.h>
+
+#include <esp_timer.h>
+
+// The supervisor runs in its own task manager, on the other core and above the routing tasks,
+// so that it keeps running when a routing task hangs or spins.
+static Mycila::TaskManager supervisorTaskManager("y-super");
+
+typedef enum {
+  CAUSE_NONE = 0,
+  CAUSE_CONTROL,
+  CAUSE_GRID,
+  CAUSE_ZERO_CROSS,
+} Cause;
+
+static const char* causeNames[] = {"none", "control", "grid", "zero_cross"};
+
+typedef struct {
+    uint32_t time = 0;
+    Cause cause = CAUSE_NONE;
+    uint32_t controlAge = 0;
+    uint32_t gridAge = 0;
+    uint32_t zeroCrossAge = 0;
+} Incident;
+
+static volatile uint32_t lastControlCycle = 0;
+static volatile bool safeState = false;
+static uint32_t safeStateSince = 0;
+static uint32_t incidentCount = 0;
+static bool restarting = false;
+static Incident lastIncident;
+
+static bool isAutoDimmerOn() {
+  return (output1 && output1->isAutoDimmerEnabled() && output1->isDimmerOn()) ||
+         (output2 && output2->isAutoDimmerEnabled() && output2->isDimmerOn());
+}
+
+static bool isDimmerOn() {
+  return (output1 && output1->isDimmerOn()) || (output2 && output2->isDimmerOn());
+}
+
+static void logTaskStates() {
+  static const char* states[] = {"running", "ready", "blocked", "suspended", "deleted", "invalid"};
+  static const char* names[] = {"y-core", "y-unsafe", "y-ui", "y-jsy", "y-ds18", "y-pzem", "y-http", "async_tcp"};
+  for (const char* name : names) {
+    TaskHandle_t handle = xTaskGetHandle(name);
+    if (handle) {
+      const eTaskState state = eTaskGetState(handle);
+      logger.error(TAG, "Supervisor: task %s: %s, stack %" PRIu32 " bytes free", name, states[state], static_cast<uint32_t>(uxTaskGetStackHighWaterMark(handle)));
+    }
+  }
+}
+
+static void enterSafeState(Cause cause, uint32_t controlAge, uint32_t gridAge, uint32_t zeroCrossAge) {
+  yasolr_router_safe_state(YASOLR_SUPERVISOR_SAFE_DUTY);
+
+  if (safeState && lastIncident.cause == cause)
+    return;
+
+  safeState = true;
+  safeStateSince = millis();
+  incidentCount++;
+  lastIncident = {safeStateSince, cause, controlAge, gridAge, zeroCrossAge};
+
+  logger.error(TAG, "Supervisor: %s deadline missed: control=%" PRIu32 " ms, grid=%" PRIu32 " ms, zc=%" PRIu32 " ms: dimmers set to %.02f", causeNames[cause], controlAge, gridAge, zeroCrossAge, YASOLR_SUPERVISOR_SAFE_DUTY);
+  logTaskStates();
+}
+
+static void supervise() {
+  const uint32_t now = millis();
+
+  // control loop: armed once the router task ran once, not checked while the calibration drives the dimmers
+  const uint32_t lastControl = lastControlCycle;
+  const uint32_t controlAge = lastControl ? now - lastControl : 0;
+  const bool controlLate = lastControl && !router.isCalibrationRunning() && controlAge > YASOLR_SUPERVISOR_CONTROL_DEADLINE;
+
+  // grid: the routing must not keep diverting based on an old measurement
+  const uint32_t gridAge = grid.getPower().neverUpdated() ? 0 : now - grid.getPower().getLastUpdateTime();
+  const bool gridStale = gridAge > YASOLR_SUPERVISOR_GRID_DEADLINE;
+
+  // zero-cross: phase control dimmers fire relative to the last pulse
+  const uint32_t lastZeroCross = Mycila::ZeroCrossDimmer::getLastZeroCrossTime();
+  const uint32_t zeroCrossAge = pulseAnalyzer && lastZeroCross ? (static_cast<uint32_t>(esp_timer_get_time()) - lastZeroCross) / 1000 : 0;
+  const bool zeroCrossStale = zeroCrossAge > YASOLR_SUPERVISOR_ZC_DEADLINE;
+
+  if (controlLate || (safeState && lastIncident.cause == CAUSE_CONTROL)) {
+    enterSafeState(CAUSE_CONTROL, controlAge, gridAge, zeroCrossAge);
+
+    // a control loop which stalled once cannot be trusted anymore
+    if (!restarting && now - safeStateSince > YASOLR_SUPERVISOR_RESTART_DELAY) {
+      restarting = true;
+      logger.error(TAG, "Supervisor: control loop stalled: restarting");
+      // do not resume the stalled state on next boot
+      yasolr_checkpoint_clear();
+      Mycila::System::restart(0);
+    }
+
+  } else if (gridStale && (isAutoDimmerOn() || (safeState && lastIncident.cause == CAUSE_GRID))) {
+    enterSafeState(CAUSE_GRID, controlAge, gridAge, zeroCrossAge);
+
+  } else if (zeroCrossStale && (isDimmerOn() || (safeState && lastIncident.cause == CAUSE_ZERO_CROSS))) {
+    enterSafeState(CAUSE_ZERO_CROSS, controlAge, gridAge, zeroCrossAge);
+
+  } else if (safeState && lastIncident.cause != CAUSE_CONTROL) {
+    // grid or zero-cross came back: the router takes the dimmers back at next grid measurement
+    safeState = false;
+    logger.warn(TAG, "Supervisor: %s recovered after %" PRIu32 " ms", causeNames[lastIncident.cause], now - safeStateSince);
+  }
+}
+
+void yasolr_supervisor_control_cycle() { lastControlCycle = millis(); }
+
+bool yasolr_supervisor_is_safe_state() { return safeState; }
+
+void yasolr_supervisor_toJson(const JsonObject& root) {
+  root["safe_state"] = safeState;
+  root["incidents"] = incidentCount;
+  if (incidentCount) {
+    JsonObject incident = root["last_incident"].to<JsonObject>();
+    incident["time"] = lastIncident.time;
+    incident["cause"] = causeNames[lastIncident.cause];
+    incident["control_age"] = lastIncident.controlAge;
+    incident["grid_age"] = lastIncident.gridAge;
+    incident["zc_age"] = lastIncident.zeroCrossAge;
+  }
+}
+
+void yasolr_init_supervisor() {
+  logger.info(TAG, "Initialize supervisor");
+
+  Mycila::Task* supervisorTask = new Mycila::Task("Supervisor", [](void* params) { supervise(); });
+  supervisorTask->setInterval(YASOLR_SUPERVISOR_INTERVAL);
+  supervisorTaskManager.addTask(*supervisorTask);
+
+  if (config.getBool(KEY_ENABLE_DEBUG)) {
+    supervisorTaskManager.enableProfiling();
+  }
+
+  assert(supervisorTaskManager.asyncStart(512 * 6, 6, 0, 100, true));
+
+  Mycila::TaskMonitor.addTask(supervisorTaskManager.name());
+}
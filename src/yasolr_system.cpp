@@ -5,18 +5,23 @@
 #include <yasolr.h>
 
 #include <esp_core_dump.h>
+#include <esp_heap_caps.h>
 
 Mycila::TaskManager coreTaskManager("y-core");
 Mycila::TaskManager unsafeTaskManager("y-unsafe");
+Mycila::TaskManager uiTaskManager("y-ui");
+Mycila::HeapMonitor heapMonitor;
 
 Mycila::Task resetTask("Reset", Mycila::Task::Type::ONCE, [](void* params) {
   logger.warn("YaSolR", "Resetting %s", Mycila::AppInfo.nameModelVersion.c_str());
   config.clear();
+  yasolr_checkpoint_clear();
   Mycila::System::restart(500);
 });
 
 Mycila::Task restartTask("Restart", Mycila::Task::Type::ONCE, [](void* params) {
   logger.warn("YaSolR", "Restarting %s", Mycila::AppInfo.nameModelVersion.c_str());
+  yasolr_checkpoint_save();
   Mycila::System::restart(500);
 });
 
@@ -27,12 +32,30 @@ Mycila::Task safeBootTask("SafeBoot", Mycila::Task::Type::ONCE, [](void* params)
   Mycila::System::restartFactory(YASOLR_SAFEBOOT_PARTITION_NAME);
 });
 
+static Mycila::Task heapMonitorTask("Heap Monitor", [](void* params) {
+  heapMonitor.sample();
+
+  // restart in a controlled way before an allocation fails somewhere in the middle of routing or of a TLS handshake
+  if (heapMonitor.isCritical() && !restartTask.scheduled()) {
+    logger.error(TAG, "Heap fragmented: largest free block is %" PRIu32 " bytes", static_cast<uint32_t>(heapMonitor.get(Mycila::HeapMonitor::Pool::INTERNAL).largestFreeBlock));
+    restartTask.resume();
+  }
+});
+
 void yasolr_init_system() {
   logger.info(TAG, "Initialize system");
 
   disableLoopWDT();
   Mycila::System::init(true, "fs");
 
+  // large buffers (JSON documents, websocket and MQTT buffers, etc) go to PSRAM when available.
+  // internal RAM stays for stacks, ISR and DMA buffers which are allocated with explicit capabilities.
+  // boards without PSRAM keep allocating everything in internal RAM.
+  if (psramFound()) {
+    heap_caps_malloc_extmem_enable(YASOLR_PSRAM_MALLOC_THRESHOLD);
+    logger.info(TAG, "PSRAM: %" PRIu32 " bytes, used for allocations >= %d bytes", ESP.getPsramSize(), YASOLR_PSRAM_MALLOC_THRESHOLD);
+  }
+
   esp_reset_reason_t reason = esp_reset_reason();
   if (reason == esp_reset_reason_t::ESP_RST_POWERON || reason == esp_reset_reason_t::ESP_RST_SW || reason == esp_reset_reason_t::ESP_RST_DEEPSLEEP) {
     logger.info(TAG, "Erasing core dump");
@@ -45,8 +68,13 @@ void yasolr_init_system() {
   coreTaskManager.addTask(restartTask);
   coreTaskManager.addTask(safeBootTask);
 
+  heapMonitor.setCriticalThreshold(YASOLR_HEAP_CRITICAL_BLOCK, YASOLR_HEAP_CRITICAL_SAMPLES);
+  heapMonitorTask.setInterval(YASOLR_HEAP_MONITOR_INTERVAL);
+  coreTaskManager.addTask(heapMonitorTask);
+
   Mycila::TaskMonitor.addTask(coreTaskManager.name());   // YaSolR
   Mycila::TaskMonitor.addTask(unsafeTaskManager.name()); // YaSolR
+  Mycila::TaskMonitor.addTask(uiTaskManager.name());     // YaSolR
 
   // Mycila::TaskMonitor.addTask("arduino_events"); // used bt non controlable
   // Mycila::TaskMonitor.addTask("https_ota_task"); // unused
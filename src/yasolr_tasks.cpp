@@ -11,11 +11,15 @@ void yasolr_init_tasks() {
   if (config.getBool(KEY_ENABLE_DEBUG)) {
     coreTaskManager.enableProfiling();
     unsafeTaskManager.enableProfiling();
+    uiTaskManager.enableProfiling();
   }
 
   // core task manager
   assert(coreTaskManager.asyncStart(512 * 8, 5, 1, 100, true));
 
+  // task manager for the dashboard, display and lights: lower priority so that routing and safety tasks preempt it
+  assert(uiTaskManager.asyncStart(512 * 8, 2, 1, 100, true));
+
   // task manager for long running tasks like mqtt / pzem
   if (unsafeTaskManager.tasks())
     assert(unsafeTaskManager.asyncStart(512 * 8, 1, 1, 100, false));
@@ -8,6 +8,7 @@
 #include <esp_partition.h>
 
 #include <map>
+#include <memory>
 #include <string>
 
 extern const uint8_t logo_png_gz_start[] asm("_binary__pio_embed_logo_png_gz_start");
@@ -31,12 +32,22 @@ Mycila::Task dashboardInitTask("Init Dashboard", Mycila::Task::Type::ONCE, [](vo
   dashboard.sendUpdates();
 });
 
+// the charts history is sampled even when no client is connected
+static Mycila::Task dashboardHistoryTask("Dashboard History", [](void* params) { website.updateHistory(); });
+
+// the PID charts keep a point per second while the real-time PID view is enabled, even when no client is connected
+static Mycila::Task pidHistoryTask("PID History", [](void* params) { website.updatePIDHistory(); });
+
+static Mycila::TaskBudget dashboardBudget("Dashboard", YASOLR_BUDGET_DASHBOARD);
+
 Mycila::Task dashboardUpdateTask("Dashboard", [](void* params) {
-  if (website.realTimePIDEnabled())
-    website.updatePIDCharts();
-  website.updateCards();
-  website.updateCharts();
-  dashboard.sendUpdates();
+  dashboardBudget.run([]() {
+    if (website.realTimePIDEnabled())
+      website.updatePIDCharts();
+    website.updateCards();
+    website.updateCharts();
+    dashboard.sendUpdates();
+  });
 });
 
 void rewrites() {
@@ -128,24 +139,53 @@ void rest_api() {
     // system
     JsonObject system = root["system"].to<JsonObject>();
     Mycila::System::toJson(system);
+    yasolr_boot_toJson(system["boot"].to<JsonObject>());
     if (ds18Sys)
       ds18Sys->toJson(system["ds18"].to<JsonObject>());
     lights.toJson(system["leds"].to<JsonObject>());
+    yasolr_supervisor_toJson(system["supervisor"].to<JsonObject>());
 
     // stack
     Mycila::TaskMonitor.toJson(system["stack"].to<JsonObject>());
 
+    // cpu
+    cpuProfiler.toJson(system["cpu"].to<JsonObject>());
+
+    // memory
+    heapMonitor.toJson(system["memory"].to<JsonObject>());
+    JsonObject arena = system["arena"].to<JsonObject>();
+    Mycila::Payload::jsyArena().toJson(arena["jsy_remote"].to<JsonObject>());
+    Mycila::Payload::mqttArena().toJson(arena["mqtt"].to<JsonObject>());
+#ifdef YASOLR_HEAP_GUARD
+    yasolr_heap_guard_toJson(system["heap_guard"].to<JsonObject>());
+#endif
+
     // tasks
     JsonObject tasks = system["task"].to<JsonObject>();
     coreTaskManager.toJson(tasks[coreTaskManager.name()].to<JsonObject>());
+    if (ds18TaskManager)
+      ds18TaskManager->toJson(tasks[ds18TaskManager->name()].to<JsonObject>());
+    if (httpMeterTaskManager)
+      httpMeterTaskManager->toJson(tasks[httpMeterTaskManager->name()].to<JsonObject>());
     if (jsyTaskManager)
       jsyTaskManager->toJson(tasks[jsyTaskManager->name()].to<JsonObject>());
     if (pzemTaskManager)
       pzemTaskManager->toJson(tasks[pzemTaskManager->name()].to<JsonObject>());
     unsafeTaskManager.toJson(tasks[unsafeTaskManager.name()].to<JsonObject>());
+    uiTaskManager.toJson(tasks[uiTaskManager.name()].to<JsonObject>());
+
+    // budgets
+    Mycila::TaskBudget::allToJson(system["budget"].to<JsonObject>());
+
+    // uart buses
+    JsonObject uart = system["uart"].to<JsonObject>();
+    if (pzemBus)
+      pzemBus->toJson(uart[pzemBus->name()].to<JsonObject>());
 
-    if (victron)
-      victron->toJson(root["victron"].to<JsonObject>());
+    if (modbusMeter)
+      modbusMeter->toJson(root["modbus_meter"].to<JsonObject>());
+    if (httpMeter)
+      httpMeter->toJson(root["http_meter"].to<JsonObject>());
 
     // libs versions
     JsonObject library = system["lib"].to<JsonObject>();
@@ -154,7 +194,6 @@ void rest_api() {
     library["CRC"] = CRC_LIB_VERSION;
     library["ESPAsyncWebServer"] = ASYNCWEBSERVER_VERSION;
     library["MycilaConfig"] = MYCILA_CONFIG_VERSION;
-    library["MycilaDS18"] = MYCILA_DS18_VERSION;
     library["MycilaEasyDisplay"] = MYCILA_EASY_DISPLAY_VERSION;
     library["MycilaESPConnect"] = ESPCONNECT_VERSION;
     library["MycilaHADiscovery"] = MYCILA_HA_VERSION;
@@ -178,10 +217,11 @@ void rest_api() {
   // config
 
   webServer.on("/api/config/backup", HTTP_GET, [](AsyncWebServerRequest* request) {
-    StreamString body;
-    body.reserve(4096);
-    config.backup(body);
-    AsyncWebServerResponse* response = request->beginResponse(200, "text/plain", body);
+    // streamed line by line: the whole backup is never held in memory
+    std::shared_ptr<YaSolR::ConfigWriter> writer = std::make_shared<YaSolR::ConfigWriter>();
+    AsyncWebServerResponse* response = request->beginChunkedResponse("text/plain", [writer](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+      return writer->read(buffer, maxLen);
+    });
     response->addHeader("Content-Disposition", "attachment; filename=\"config.txt\"");
     request->send(response);
   });
@@ -193,25 +233,36 @@ void rest_api() {
       [](AsyncWebServerRequest* request) {
         if (!request->_tempObject) {
           request->send(400, "text/plain", "No config file uploaded");
-        } else {
-          StreamString* buffer = reinterpret_cast<StreamString*>(request->_tempObject);
-          config.restore((*buffer).c_str());
-          delete buffer;
-          request->_tempObject = nullptr;
-          request->send(200, "text/plain", "OK");
+          return;
+        }
+
+        YaSolR::ConfigReader* reader = reinterpret_cast<YaSolR::ConfigReader*>(request->_tempObject);
+        request->_tempObject = nullptr;
+
+        if (!reader->end()) {
+          logger.error(TAG, "Configuration restore failed: %s", reader->transaction().getError().c_str());
+          request->send(400, "text/plain", reader->transaction().getError().c_str());
+          delete reader;
+          return;
         }
+
+        logger.info(TAG, "Restoring configuration: %" PRIu32 " changes, %" PRIu32 " unknown keys skipped", static_cast<uint32_t>(reader->transaction().size()), static_cast<uint32_t>(reader->getSkipped()));
+        reader->transaction().commit();
+        delete reader;
+
+        request->send(200, "text/plain", "OK");
+        restartTask.resume();
       },
       [](AsyncWebServerRequest* request, String filename, size_t index, uint8_t* data, size_t len, bool final) {
         if (!index) {
           if (request->_tempObject) {
-            delete reinterpret_cast<StreamString*>(request->_tempObject);
+            delete reinterpret_cast<YaSolR::ConfigReader*>(request->_tempObject);
           }
-          StreamString* buffer = new StreamString();
-          buffer->reserve(4096);
-          request->_tempObject = buffer;
+          request->_tempObject = new YaSolR::ConfigReader();
         }
+        // lines are validated as they arrive and the changes are committed at once when the upload is complete
         if (len) {
-          reinterpret_cast<StreamString*>(request->_tempObject)->write(data, len);
+          reinterpret_cast<YaSolR::ConfigReader*>(request->_tempObject)->write(data, len);
         }
       });
 
@@ -265,6 +316,7 @@ void rest_api() {
           File serverCertFile = LittleFS.open(YASOLR_MQTT_SERVER_CERT_FILE, "r");
           logger.info(TAG, "Uploaded MQTT PEM server certificate:\n%s", serverCertFile.readString().c_str());
           serverCertFile.close();
+          website.invalidate({YaSolR::Website::Section::MQTT});
           dashboardInitTask.resume();
           request->send(response);
         }
@@ -278,17 +330,31 @@ void rest_api() {
           request->_tempFile.close();
       });
 
+  // POST /api/config?restart=true applies the form parameters at once and restarts only if one of them requires it
   webServer.on("/api/config", HTTP_POST, [](AsyncWebServerRequest* request) {
-    std::map<const char*, std::string> settings;
+    YaSolR::ConfigTransaction transaction;
     for (size_t i = 0, max = request->params(); i < max; i++) {
       const AsyncWebParameter* p = request->getParam(i);
-      if (p->isPost() && !p->isFile()) {
-        const char* keyRef = config.keyRef(p->name().c_str());
-        settings[keyRef] = p->value().c_str();
-      }
+      if (p->isPost() && !p->isFile() && !transaction.set(p->name().c_str(), p->value().c_str()))
+        break;
     }
-    request->send(200);
-    config.set(settings);
+
+    if (!transaction.isValid()) {
+      request->send(400, "text/plain", transaction.getError().c_str());
+      return;
+    }
+
+    AsyncJsonResponse* response = new AsyncJsonResponse();
+    JsonObject root = response->getRoot();
+    root["changes"] = transaction.size();
+    root["restart_required"] = transaction.isRestartRequired();
+    response->setLength();
+    request->send(response);
+
+    transaction.commit();
+
+    if (transaction.isRestartRequired() && request->hasParam("restart") && request->getParam("restart")->value() == YASOLR_TRUE)
+      restartTask.resume();
   });
 
   webServer.on("/api/config", HTTP_GET, [](AsyncWebServerRequest* request) {
@@ -315,6 +381,26 @@ void rest_api() {
     request->send(200);
   });
 
+  webServer.on("/api/system/logging", HTTP_POST, [](AsyncWebServerRequest* request) {
+    // tag=OUTPUT&level=debug, or tag=* to change the default level of all the tags
+    if (!request->hasParam("tag", true) || !request->hasParam("level", true)) {
+      request->send(400, "text/plain", "Missing tag or level");
+      return;
+    }
+    if (!yasolr_set_log_level(request->getParam("tag", true)->value().c_str(), request->getParam("level", true)->value().c_str())) {
+      request->send(400, "text/plain", "Invalid level or too many tags");
+      return;
+    }
+    request->send(200);
+  });
+
+  webServer.on("/api/system/logging", HTTP_GET, [](AsyncWebServerRequest* request) {
+    AsyncJsonResponse* response = new AsyncJsonResponse();
+    logFilter.toJson(response->getRoot());
+    response->setLength();
+    request->send(response);
+  });
+
   webServer.on("/api/system", HTTP_GET, [](AsyncWebServerRequest* request) {
     AsyncJsonResponse* response = new AsyncJsonResponse();
     JsonObject root = response->getRoot();
@@ -335,6 +421,11 @@ void rest_api() {
     root["device"]["heap"]["used"] = memory->used;
     delete memory;
     memory = nullptr;
+    const Mycila::HeapMonitor::Stats& heap = heapMonitor.get(Mycila::HeapMonitor::Pool::INTERNAL);
+    root["device"]["heap"]["fragmentation"] = heap.fragmentation;
+    root["device"]["heap"]["largest_free_block"] = heap.largestFreeBlock;
+    root["device"]["heap"]["min_free"] = heap.minFree;
+    root["device"]["heap"]["trend"] = heapMonitor.getTrend();
 
     root["device"]["id"] = Mycila::AppInfo.id;
     root["device"]["model"] = ESP.getChipModel();
@@ -523,6 +614,7 @@ void rest_api() {
     root["logs"] = base + YASOLR_LOG_FILE;
     root["router"] = base + "/router";
     root["system"] = base + "/system";
+    root["system/logging"] = base + "/system/logging";
 
     response->setLength();
     request->send(response);
@@ -558,6 +650,8 @@ void yasolr_init_web_server() {
   dashboard.onBeforeUpdate([](bool changes_only) {
     if (!changes_only) {
       logger.info(TAG, "Dashboard refresh requested!");
+      // the other sections only depend on the configuration and are still up to date
+      website.invalidate({YaSolR::Website::Section::STATISTICS, YaSolR::Website::Section::HARDWARE});
       website.initCards();
     }
   });
@@ -570,11 +664,19 @@ void yasolr_init_web_server() {
 
   dashboardInitTask.setEnabledWhen([]() { return espConnect.isConnected() && !dashboard.isAsyncAccessInProgress(); });
 
-  dashboardUpdateTask.setEnabledWhen([]() { return espConnect.isConnected() && !dashboard.isAsyncAccessInProgress(); });
+  // nothing is computed when nobody is watching
+  dashboardUpdateTask.setEnabledWhen([]() { return espConnect.isConnected() && dashboard.hasClient() && !dashboard.isAsyncAccessInProgress(); });
   dashboardUpdateTask.setInterval(1000);
 
-  coreTaskManager.addTask(dashboardInitTask);
-  coreTaskManager.addTask(dashboardUpdateTask);
+  uiTaskManager.addTask(dashboardInitTask);
+  uiTaskManager.addTask(dashboardUpdateTask);
+
+  dashboardHistoryTask.setInterval(YASOLR_HISTORY_INTERVAL);
+  uiTaskManager.addTask(dashboardHistoryTask);
+
+  pidHistoryTask.setEnabledWhen([]() { return website.realTimePIDEnabled(); });
+  pidHistoryTask.setInterval(1000);
+  uiTaskManager.addTask(pidHistoryTask);
 
   if (config.getBool(KEY_ENABLE_DEBUG)) {
     dashboardUpdateTask.enableProfiling();
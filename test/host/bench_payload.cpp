@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+// Measures the parsers of the measurements received from the network: messages per second and heap allocations per message.
+// Usage: bench_payload [iterations]
+#include <MycilaModbusMap.h>
+
+#if __has_include(<ArduinoJson.h>)
+  #include <FastCRC32.h>
+  #include <MycilaPayload.h>
+  #define BENCH_PAYLOAD
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+// heap allocations made by the code under test (ArduinoJson allocations go through the arenas, which count their heap fallbacks)
+static std::atomic<size_t> allocations{0};
+
+void* operator new(size_t size) {
+  allocations++;
+  if (void* ptr = malloc(size))
+    return ptr;
+  throw std::bad_alloc();
+}
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { free(ptr); }
+
+static int failures = 0;
+
+template <typename F>
+static void bench(const char* name, size_t iterations, uint32_t (*fallbacks)(), F&& parse) {
+  // warm up: buffers reach their final size
+  if (!parse()) {
+    printf("%-28s FAILED\n", name);
+    failures++;
+    return;
+  }
+
+  const size_t allocationsStart = allocations;
+  const uint32_t fallbacksStart = fallbacks ? fallbacks() : 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; i++)
+    parse();
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  const size_t heap = allocations - allocationsStart + (fallbacks ? fallbacks() - fallbacksStart : 0);
+
+  printf("%-28s %12.0f msg/s %8.2f alloc/msg\n", name, iterations / seconds, static_cast<double>(heap) / iterations);
+}
+
+static void benchModbus(const char* name, const Mycila::Modbus::Map& map, size_t iterations) {
+  std::vector<Mycila::Modbus::Block> blocks = Mycila::Modbus::plan(map);
+
+  // one response per block, all registers set to 100
+  std::vector<std::vector<uint8_t>> responses;
+  for (const Mycila::Modbus::Block& block : blocks) {
+    std::vector<uint8_t> response = {block.unit, block.function, static_cast<uint8_t>(2 * block.count)};
+    for (size_t i = 0; i < block.count; i++) {
+      response.push_back(0);
+      response.push_back(100);
+    }
+    responses.push_back(std::move(response));
+  }
+
+  bench(name, iterations, nullptr, [&]() {
+    for (size_t i = 0; i < blocks.size(); i++)
+      if (!Mycila::Modbus::parse(responses[i].data(), responses[i].size(), blocks[i]))
+        return false;
+    Mycila::Modbus::Metrics metrics;
+    return Mycila::Modbus::decode(map, blocks, metrics);
+  });
+}
+
+#ifdef BENCH_PAYLOAD
+static uint32_t jsyFallbacks() { return Mycila::Payload::jsyArena().getFallbacks(); }
+static uint32_t mqttFallbacks() { return Mycila::Payload::mqttArena().getFallbacks(); }
+
+static void channel(const JsonObject& channel, float power) {
+  channel["frequency"] = 50.02f;
+  channel["voltage"] = 231.4f;
+  channel["current"] = 4.12f;
+  channel["active_power"] = power;
+  channel["reactive_power"] = 0.0f;
+  channel["apparent_power"] = 953.4f;
+  channel["power_factor"] = 0.987f;
+  channel["active_energy"] = 3199016;
+  channel["active_energy_imported"] = 2304719;
+  channel["active_energy_returned"] = 894271;
+  channel["resistance"] = 56.1f;
+  channel["thdi_0"] = 0.18f;
+}
+
+// frame sent by the JSY Remote app for a JSY-MK-194
+static std::vector<uint8_t> jsyFrame() {
+  JsonDocument doc;
+  doc["model"] = 0x0194;
+  channel(doc["channel1"].to<JsonObject>(), 941.2f);
+  channel(doc["channel2"].to<JsonObject>(), -612.8f);
+
+  const uint32_t size = measureMsgPack(doc);
+  std::vector<uint8_t> frame(size + Mycila::Payload::JSY_FRAME_OVERHEAD);
+  frame[0] = Mycila::Payload::JSY_MSG_TYPE;
+  memcpy(frame.data() + 1, &size, 4);
+  serializeMsgPack(doc, frame.data() + 5, size);
+  FastCRC32 crc32;
+  crc32.add(frame.data(), size + 5);
+  const uint32_t crc = crc32.calc();
+  memcpy(frame.data() + size + 5, &crc, 4);
+  return frame;
+}
+#endif
+
+int main(int argc, char** argv) {
+  const size_t iterations = argc > 1 ? strtoul(argv[1], nullptr, 10) : 100000;
+
+#ifdef BENCH_PAYLOAD
+  const std::vector<uint8_t> frame = jsyFrame();
+  bench("JSY-MK-194 UDP frame", iterations, jsyFallbacks, [&]() {
+    Mycila::Payload::JsyData data;
+    return Mycila::Payload::decodeJsyFrame(frame.data(), frame.size(), data) && data.hasOutput;
+  });
+
+  const std::string em = R"({"id":1,"current":2.681,"voltage":236.7,"act_power":-607.3,"aprt_power":636.0,"pf":0.95,"freq":50.0,"calibration":"factory"})";
+  bench("Shelly EM power", iterations, mqttFallbacks, [&]() { return Mycila::Payload::parseGridPower(em) == -607.3f; });
+
+  const std::string em3 = R"({"id":0,"a_current":0.132,"a_voltage":236.0,"a_act_power":3.9,"a_aprt_power":31.0,"a_pf":-0.53,"b_current":0.594,"b_voltage":236.4,"b_act_power":45.4,"b_aprt_power":140.3,"b_pf":-0.61,"c_current":0.368,"c_voltage":237.8,"c_act_power":54.3,"c_aprt_power":87.5,"c_pf":-0.72,"n_current":null,"total_current":1.094,"total_act_power":103.610,"total_aprt_power":258.799, "user_calibrated_phase":[]})";
+  bench("Shelly 3EM power", iterations, mqttFallbacks, [&]() { return Mycila::Payload::parseGridPower(em3) == 103.61f; });
+  bench("Shelly 3EM voltage", iterations, mqttFallbacks, [&]() { return Mycila::Payload::parseGridVoltage(em3) == 236.0f; });
+
+  const std::string plain = "-607.3";
+  bench("Plain power", iterations, mqttFallbacks, [&]() { return Mycila::Payload::parseGridPower(plain) == -607.3f; });
+#else
+  printf("ArduinoJson not found: JSY and MQTT parsers skipped\n");
+#endif
+
+  benchModbus("Modbus Fronius read", Mycila::Modbus::FRONIUS, iterations);
+  benchModbus("Modbus SMA read", Mycila::Modbus::SMA, iterations);
+  benchModbus("Modbus SolarEdge read", Mycila::Modbus::SOLAREDGE, iterations);
+  benchModbus("Modbus Victron read", Mycila::Modbus::VICTRON, iterations);
+
+  return failures ? 1 : 0;
+}
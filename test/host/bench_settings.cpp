@@ -0,0 +1,126 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+// Measures the reads of the settings used by the tasks: through the configuration (lookup and parsing of a string key)
+// and through the cached fields of YaSolR::Settings, plus the cost of refreshing a setting when its key changes.
+// Usage: bench_settings [iterations]
+#include <yasolr.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+HostConfig config;
+YaSolR::Settings settings;
+
+// heap allocations made by the code under test
+static std::atomic<size_t> allocations{0};
+
+void* operator new(size_t size) {
+  allocations++;
+  if (void* ptr = malloc(size))
+    return ptr;
+  throw std::bad_alloc();
+}
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { free(ptr); }
+
+static int failures = 0;
+
+#define CHECK(condition)                                                     \
+  do {                                                                       \
+    if (!(condition)) {                                                      \
+      printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+      failures++;                                                            \
+    }                                                                        \
+  } while (0)
+
+// prevents the reads from being optimized out
+static volatile float sink;
+
+static float value(bool v) { return v; }
+static float value(int32_t v) { return static_cast<float>(v); }
+static float value(uint32_t v) { return static_cast<float>(v); }
+static float value(float v) { return v; }
+static float value(const std::string& v) { return static_cast<float>(v.size()); }
+
+// reads a key through the configuration, like the code did before the settings
+template <typename T>
+static float read(const char* key);
+template <>
+float read<bool>(const char* key) { return value(config.getBool(key)); }
+template <>
+float read<int32_t>(const char* key) { return value(static_cast<int32_t>(config.getLong(key))); }
+template <>
+float read<uint32_t>(const char* key) { return value(static_cast<uint32_t>(config.getLong(key))); }
+template <>
+float read<float>(const char* key) { return value(config.getFloat(key)); }
+template <>
+float read<std::string>(const char* key) { return value(config.getString(key)); }
+
+static constexpr size_t COUNT = static_cast<size_t>(YaSolR::Setting::COUNT);
+
+template <typename F>
+static void bench(const char* name, size_t iterations, size_t reads, F&& fn) {
+  fn();
+  const size_t allocationsStart = allocations;
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; i++)
+    fn();
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  const double count = static_cast<double>(iterations) * reads;
+  printf("%-28s %10.1f ns/op %8.2f alloc/op\n", name, seconds * 1e9 / count, (allocations - allocationsStart) / count);
+}
+
+int main(int argc, char** argv) {
+  const size_t iterations = argc > 1 ? strtoul(argv[1], nullptr, 10) : 100000;
+
+  // realistic values: numbers, booleans and strings
+  for (size_t i = 0; i < COUNT; i++) {
+    const char* key = YaSolR::Settings::key(static_cast<YaSolR::Setting>(i));
+    const size_t len = strlen(key);
+    if (len > 7 && strcmp(key + len - 7, "_enable") == 0)
+      config.set(key, YASOLR_TRUE);
+    else
+      config.set(key, std::to_string(1000 + i));
+  }
+  config.set(KEY_MQTT_TOPIC, "yasolr_a1b2c3");
+  config.set(KEY_PID_KP, "0.3");
+  settings.load();
+
+  CHECK(settings.mqttTopic == "yasolr_a1b2c3");
+  CHECK(settings.pidKp == 0.3f);
+  CHECK(settings.mqttSecured == false);
+  CHECK(settings.output1AutoDimmer);
+
+  // every setting read once, like a reconnection or a configuration of the outputs and of the PID
+  bench("config: lookup + parse", iterations, COUNT, []() {
+    float s = 0;
+#define YASOLR_SETTING_READ(id, field, type, key) s += read<type>(key);
+    YASOLR_SETTINGS(YASOLR_SETTING_READ)
+#undef YASOLR_SETTING_READ
+    sink = s;
+  });
+
+  bench("settings: cached fields", iterations, COUNT, []() {
+    float s = 0;
+#define YASOLR_SETTING_READ(id, field, type, key) s += value(settings.field);
+    YASOLR_SETTINGS(YASOLR_SETTING_READ)
+#undef YASOLR_SETTING_READ
+    sink = s;
+  });
+
+  // cost paid once per configuration change: find the setting of the key and parse it again
+  size_t listened = 0;
+  settings.listen(YaSolR::Setting::PID_KP, [&listened]() { listened++; });
+  bench("settings: update(key)", iterations, 1, []() { settings.update(KEY_PID_KP); });
+  CHECK(listened == iterations + 1);
+  CHECK(!settings.update("unknown_key"));
+
+  printf("%s\n", failures ? "FAILED" : "OK");
+  return failures;
+}
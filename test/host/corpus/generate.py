@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+# Copyright (C) 2023-2025 Mathieu Carbou
+#
+# Regenerates the seed corpus of the host fuzz targets:
+# - jsy: UDP frames sent by the JSY Remote app (MsgPack, as published by MycilaJSY)
+# - modbus: read responses of the built-in register maps (see fuzz_modbus_response.cpp for the format)
+# - mqtt: Shelly EM / 3EM status messages and plain values
+#
+# Usage: python3 generate.py
+
+import os
+import struct
+import zlib
+
+DIR = os.path.dirname(os.path.abspath(__file__))
+
+
+def write(folder, name, data):
+    os.makedirs(os.path.join(DIR, folder), exist_ok=True)
+    with open(os.path.join(DIR, folder, name), "wb") as f:
+        f.write(data.encode() if isinstance(data, str) else data)
+
+
+# ================================================================ MsgPack
+
+
+def msgpack(value):
+    if value is None:
+        return b"\xc0"
+    if isinstance(value, bool):
+        return b"\xc3" if value else b"\xc2"
+    if isinstance(value, int):
+        if 0 <= value < 0x80:
+            return struct.pack("B", value)
+        if -32 <= value < 0:
+            return struct.pack("b", value)
+        if 0 <= value <= 0xFFFF:
+            return b"\xcd" + struct.pack(">H", value)
+        if 0 <= value <= 0xFFFFFFFF:
+            return b"\xce" + struct.pack(">I", value)
+        return b"\xd2" + struct.pack(">i", value)
+    if isinstance(value, float):
+        return b"\xca" + struct.pack(">f", value)
+    if isinstance(value, str):
+        raw = value.encode()
+        return (struct.pack("B", 0xA0 | len(raw)) if len(raw) < 32 else b"\xd9" + struct.pack("B", len(raw))) + raw
+    if isinstance(value, dict):
+        out = struct.pack("B", 0x80 | len(value)) if len(value) < 16 else b"\xde" + struct.pack(">H", len(value))
+        for k, v in value.items():
+            out += msgpack(k) + msgpack(v)
+        return out
+    raise TypeError(value)
+
+
+def jsy_frame(doc):
+    body = msgpack(doc)
+    head = b"\x02" + struct.pack("<I", len(body)) + body
+    return head + struct.pack("<I", zlib.crc32(head) & 0xFFFFFFFF)
+
+
+def channel(voltage, current, power, pf, imported, returned, **extra):
+    doc = {
+        "frequency": 50.02,
+        "voltage": voltage,
+        "current": current,
+        "active_power": power,
+        "reactive_power": 0.0,
+        "apparent_power": round(voltage * current, 1),
+        "power_factor": pf,
+        "active_energy": imported + returned,
+        "active_energy_imported": imported,
+        "active_energy_returned": returned,
+    }
+    doc.update(extra)
+    return doc
+
+
+JSY_194 = {
+    "model": 0x0194,
+    "channel1": channel(231.4, 4.12, 941.2, 0.987, 153297, 0, resistance=56.1, dimmed_voltage=229.8, nominal_power=954.5, thdi_0=0.18),
+    "channel2": channel(231.4, 3.91, -612.8, 0.677, 2304719, 894271),
+}
+
+JSY_333 = {
+    "model": 0x0333,
+    "aggregate": channel(232.1, 9.84, 1523.6, 0.912, 5812043, 1320457),
+    "phaseA": channel(232.1, 4.02, 812.5, 0.871, 2103321, 401222),
+    "phaseB": channel(231.8, 3.11, 498.2, 0.691, 1904552, 502331),
+    "phaseC": channel(233.0, 2.71, 212.9, 0.337, 1804170, 416904),
+}
+
+JSY_163 = dict(model=0x0163, **channel(230.7, 1.52, 345.1, 0.984, 98102, 0))
+
+write("jsy", "jsy-mk-194.bin", jsy_frame(JSY_194))
+write("jsy", "jsy-mk-333.bin", jsy_frame(JSY_333))
+write("jsy", "jsy-mk-163.bin", jsy_frame(JSY_163))
+write("jsy", "jsy-mk-194-bad-crc.bin", jsy_frame(JSY_194)[:-1] + b"\x00")
+write("jsy", "jsy-mk-194-truncated.bin", jsy_frame(JSY_194)[:40])
+
+# ================================================================ Modbus
+
+MAX_WORDS = 125
+MAX_GAP = 32
+
+# (unit, function, address, width in words, words) per map, in the order of MAPS in fuzz_modbus_response.cpp
+# values: 5.2 A, 230.1 V, 50 Hz, 1200 W imported, 1250 VA, 1234567 Wh imported, 765432 Wh returned
+
+
+def u32(v):
+    return [(v >> 16) & 0xFFFF, v & 0xFFFF]
+
+
+def f32(v):
+    return list(struct.unpack(">HH", struct.pack(">f", v)))
+
+
+def i16(v):
+    return [v & 0xFFFF]
+
+
+FRONIUS = [(240, 3, 40071, f32(5.2)), (240, 3, 40081, f32(230.1)), (240, 3, 40095, f32(50.0)), (240, 3, 40097, f32(1200.0)),
+           (240, 3, 40105, f32(1250.0)), (240, 3, 40129, f32(765432.0)), (240, 3, 40137, f32(1234567.0))]
+SMA = [(3, 3, 30581, u32(1234567)), (3, 3, 30583, u32(765432)), (3, 3, 30865, u32(1200)), (3, 3, 30867, u32(0)),
+       (3, 3, 31253, u32(23010)), (3, 3, 31447, u32(5000))]
+SOLAREDGE = [(1, 3, 40189, i16(520)), (1, 3, 40193, i16(-2)), (1, 3, 40195, i16(2301)), (1, 3, 40202, i16(-1)),
+             (1, 3, 40203, i16(5000)), (1, 3, 40204, i16(-2)), (1, 3, 40205, i16(-1200)), (1, 3, 40209, i16(0)),
+             (1, 3, 40210, i16(1250)), (1, 3, 40214, i16(0)), (1, 3, 40220, i16(9600)), (1, 3, 40224, i16(-2)),
+             (1, 3, 40225, u32(765432)), (1, 3, 40233, u32(1234567)), (1, 3, 40241, i16(0))]
+VICTRON = [(228, 3, 3, i16(2301)), (228, 3, 6, i16(52)), (228, 3, 7, i16(0)), (228, 3, 8, i16(0)), (228, 3, 9, i16(5000)),
+           (228, 3, 12, i16(120)), (228, 3, 13, i16(0)), (228, 3, 14, i16(0))]
+
+
+# same grouping as Mycila::Modbus::plan()
+def plan(registers):
+    blocks = []
+    for unit, function, address, words in sorted(registers, key=lambda r: r[:3]):
+        if blocks:
+            last = blocks[-1]
+            last_end = last["address"] + len(last["words"])
+            end = address + len(words)
+            if last["unit"] == unit and last["function"] == function and address <= last_end + MAX_GAP and max(last_end, end) - last["address"] <= MAX_WORDS:
+                last["words"] += [0] * (max(last_end, end) - last_end)
+                last["words"][address - last["address"]:end - last["address"]] = words
+                continue
+        blocks.append({"unit": unit, "function": function, "address": address, "words": list(words)})
+    return blocks
+
+
+def responses(index, registers):
+    out = struct.pack("B", index)
+    for block in plan(registers):
+        out += struct.pack(">BBB", block["unit"], block["function"], 2 * len(block["words"]))
+        out += b"".join(struct.pack(">H", w) for w in block["words"])
+    return out
+
+
+for index, (name, registers) in enumerate([("fronius", FRONIUS), ("sma", SMA), ("solaredge", SOLAREDGE), ("victron", VICTRON)]):
+    write("modbus", f"{name}.bin", responses(index, registers))
+
+# exception response (illegal data address) and truncated response
+write("modbus", "victron-exception.bin", b"\x03\xe4\x83\x02")
+write("modbus", "sma-truncated.bin", responses(1, SMA)[:20])
+
+# ================================================================ MQTT
+
+write("mqtt", "plain-power.txt", "-607.3")
+write("mqtt", "plain-voltage.txt", "236.7")
+write("mqtt", "shelly-em.json", '{"id":1,"current":2.681,"voltage":236.7,"act_power":-607.3,"aprt_power":636.0,"pf":0.95,"freq":50.0,"calibration":"factory"}')
+write("mqtt", "shelly-3em.json", '{"id":0,"a_current":0.132,"a_voltage":236.0,"a_act_power":3.9,"a_aprt_power":31.0,"a_pf":-0.53,"b_current":0.594,"b_voltage":236.4,"b_act_power":45.4,"b_aprt_power":140.3,"b_pf":-0.61,"c_current":0.368,"c_voltage":237.8,"c_act_power":54.3,"c_aprt_power":87.5,"c_pf":-0.72,"n_current":null,"total_current":1.094,"total_act_power":103.610,"total_aprt_power":258.799, "user_calibrated_phase":[]}')
+write("mqtt", "shelly-3em-errors.json", '{"id":0,"a_current":0.132,"a_voltage":236.0,"a_act_power":3.9,"errors":["phase_sequence"],"total_act_power":3.9,"user_calibrated_phase":["a","b"]}')
+write("mqtt", "nested.json", '{"a":{"b":{"c":{"d":{"e":{"act_power":1}}}}}}')
@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+// Input: a UDP frame of the JSY Remote app.
+// The input is also framed as MsgPack data with a valid size and CRC so that the MsgPack decoding is reached.
+#include <FastCRC32.h>
+#include <MycilaPayload.h>
+
+#include <cstring>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+  Mycila::Payload::JsyData jsy;
+  Mycila::Payload::decodeJsyFrame(data, size, jsy);
+
+  std::vector<uint8_t> frame(size + Mycila::Payload::JSY_FRAME_OVERHEAD);
+  const uint32_t len = size;
+  frame[0] = Mycila::Payload::JSY_MSG_TYPE;
+  memcpy(frame.data() + 1, &len, 4);
+  if (size)
+    memcpy(frame.data() + 5, data, size);
+  FastCRC32 crc32;
+  crc32.add(frame.data(), size + 5);
+  const uint32_t crc = crc32.calc();
+  memcpy(frame.data() + size + 5, &crc, 4);
+  Mycila::Payload::decodeJsyFrame(frame.data(), frame.size(), jsy);
+
+  return 0;
+}
@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+// Replays the corpus through a fuzz target when the compiler has no libFuzzer (GCC).
+// Arguments are files or directories of inputs, like libFuzzer: fuzz_target corpus/jsy
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+static void run(const std::filesystem::path& path) {
+  std::ifstream in(path, std::ios::binary);
+  std::vector<uint8_t> input((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  // copied to an exact size buffer so that the sanitizers catch any read past the end
+  uint8_t* data = new uint8_t[input.size()];
+  std::copy(input.begin(), input.end(), data);
+  LLVMFuzzerTestOneInput(data, input.size());
+  delete[] data;
+}
+
+int main(int argc, char** argv) {
+  size_t count = 0;
+  for (int i = 1; i < argc; i++) {
+    if (std::filesystem::is_directory(argv[i])) {
+      for (const auto& entry : std::filesystem::directory_iterator(argv[i])) {
+        if (entry.is_regular_file()) {
+          run(entry.path());
+          count++;
+        }
+      }
+    } else {
+      run(argv[i]);
+      count++;
+    }
+  }
+  printf("Executed %zu inputs\n", count);
+  return count ? 0 : 1;
+}
@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+// Input: map index (1 byte), then one read response per block of the map plan:
+// unit (1 byte), function (1 byte), byte count (1 byte), data (byte count bytes)
+#include <MycilaModbusMap.h>
+
+#include <algorithm>
+
+static const Mycila::Modbus::Map* MAPS[] = {
+  &Mycila::Modbus::FRONIUS,
+  &Mycila::Modbus::SMA,
+  &Mycila::Modbus::SOLAREDGE,
+  &Mycila::Modbus::VICTRON,
+};
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+  if (size < 1)
+    return 0;
+
+  const Mycila::Modbus::Map& map = *MAPS[data[0] % (sizeof(MAPS) / sizeof(MAPS[0]))];
+  std::vector<Mycila::Modbus::Block> blocks = Mycila::Modbus::plan(map);
+
+  size_t offset = 1;
+  for (Mycila::Modbus::Block& block : blocks) {
+    if (offset >= size)
+      break;
+    const size_t len = size - offset < 3 ? size - offset : std::min<size_t>(size - offset, 3u + data[offset + 2]);
+    Mycila::Modbus::parse(data + offset, len, block);
+    offset += len;
+  }
+
+  Mycila::Modbus::Metrics metrics;
+  Mycila::Modbus::decode(map, blocks, metrics);
+  return 0;
+}
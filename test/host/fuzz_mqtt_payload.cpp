@@ -0,0 +1,14 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+// Input: an MQTT message received on the grid power or grid voltage topic
+#include <MycilaPayload.h>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+  const std::string_view payload(reinterpret_cast<const char*>(data), size);
+  Mycila::Payload::parseNumber(payload);
+  Mycila::Payload::parseGridPower(payload);
+  Mycila::Payload::parseGridVoltage(payload);
+  return 0;
+}
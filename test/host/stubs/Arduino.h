@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#pragma once
+
+// Host replacement of the few Arduino functions used by the libraries built in test/host
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+inline uint32_t millis() {
+  static const auto start = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+class String : public std::string {
+  public:
+    String() = default;
+    String(const char* s) : std::string(s ? s : "") {}
+    String(std::string s) : std::string(std::move(s)) {}
+
+    bool equalsIgnoreCase(const String& other) const {
+      return length() == other.length() && std::equal(begin(), end(), other.begin(), [](char a, char b) { return std::tolower(a) == std::tolower(b); });
+    }
+};
+
+class IPAddress {
+  public:
+    IPAddress() = default;
+    explicit IPAddress(const char* address) : _address(address ? address : "") {}
+    const char* c_str() const { return _address.c_str(); }
+    String toString() const { return _address; }
+
+  private:
+    std::string _address;
+};
+
+// Arduino stream: read() does not block, readBytes() waits for each byte up to the timeout
+class Stream {
+  public:
+    virtual ~Stream() = default;
+    virtual int available() = 0;
+    virtual int read() = 0;
+
+    void setTimeout(uint32_t timeout) { _timeout = timeout; }
+
+    size_t readBytes(char* buffer, size_t length) {
+      size_t count = 0;
+      while (count < length) {
+        const int c = _timedRead();
+        if (c < 0)
+          break;
+        buffer[count++] = static_cast<char>(c);
+      }
+      return count;
+    }
+
+  protected:
+    uint32_t _timeout = 1000;
+
+    int _timedRead() {
+      const uint32_t start = millis();
+      do {
+        const int c = read();
+        if (c >= 0)
+          return c;
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+      } while (millis() - start < _timeout);
+      return -1;
+    }
+};
+
+#define ARDUHAL_LOG_LEVEL_NONE    0
+#define ARDUHAL_LOG_LEVEL_ERROR   1
+#define ARDUHAL_LOG_LEVEL_WARN    2
+#define ARDUHAL_LOG_LEVEL_INFO    3
+#define ARDUHAL_LOG_LEVEL_DEBUG   4
+#define ARDUHAL_LOG_LEVEL_VERBOSE 5
+
+#define ESP_LOGD(tag, format, ...) ((void)0)
+#define ESP_LOGI(tag, format, ...) ((void)0)
+#define ESP_LOGW(tag, format, ...) fprintf(stderr, "W %s: " format "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGE(tag, format, ...) fprintf(stderr, "E %s: " format "\n", tag, ##__VA_ARGS__)
@@ -0,0 +1,25 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Host replacement of the FastCRC32 class of the CRC library (robtillaart/CRC): standard CRC-32 (reflected, polynomial 0xEDB88320)
+class FastCRC32 {
+  public:
+    void add(const uint8_t* data, size_t length) {
+      for (size_t i = 0; i < length; i++) {
+        _crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++)
+          _crc = (_crc >> 1) ^ (0xEDB88320UL & (0 - (_crc & 1)));
+      }
+    }
+
+    uint32_t calc() const { return ~_crc; }
+
+  private:
+    uint32_t _crc = 0xFFFFFFFFUL;
+};
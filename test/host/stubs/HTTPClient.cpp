@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#include <HTTPClient.h>
+
+#include <cstdlib>
+#include <string>
+
+static std::string toLower(std::string s) {
+  std::transform(s.begin(), s.end(), s.begin(), [](char c) { return std::tolower(c); });
+  return s;
+}
+
+bool HTTPClient::begin(WiFiClient& client, String host, uint16_t port, String uri) {
+  _client = &client;
+  _host = host;
+  _port = port;
+  _uri = uri;
+  return !host.empty() && !uri.empty() && uri[0] == '/';
+}
+
+void HTTPClient::end() {
+  if (!_client)
+    return;
+  if (_client->connected()) {
+    // what is left of the body is dropped
+    while (_client->available() > 0)
+      _client->read();
+    if (!_reuse || !_canReuse)
+      _client->stop();
+  }
+  _client = nullptr;
+}
+
+void HTTPClient::collectHeaders(const char* headerKeys[], const size_t headerKeysCount) {
+  _headers.clear();
+  for (size_t i = 0; i < headerKeysCount; i++)
+    _headers[toLower(headerKeys[i])] = "";
+}
+
+int HTTPClient::GET() {
+  if (!_client)
+    return HTTPC_ERROR_CONNECTION_REFUSED;
+  if (!_client->connected() && !_client->connect(_host.c_str(), _port, _connectTimeout))
+    return HTTPC_ERROR_CONNECTION_REFUSED;
+  _client->setTimeout(_timeout);
+
+  const std::string request = "GET " + _uri + (_http10 ? " HTTP/1.0" : " HTTP/1.1") + "\r\nHost: " + _host + ":" + std::to_string(_port) + "\r\nConnection: " + (_reuse ? "keep-alive" : "close") + "\r\n\r\n";
+  if (_client->write(reinterpret_cast<const uint8_t*>(request.data()), request.size()) != request.size())
+    return HTTPC_ERROR_SEND_HEADER_FAILED;
+
+  for (auto& entry : _headers)
+    entry.second = "";
+  _size = -1;
+  _canReuse = _reuse && !_http10;
+
+  // status line: HTTP/1.1 200 OK
+  String line;
+  if (!_readLine(line))
+    return HTTPC_ERROR_READ_TIMEOUT;
+  const size_t space = line.find(' ');
+  if (line.compare(0, 5, "HTTP/") != 0 || space == std::string::npos)
+    return HTTPC_ERROR_CONNECTION_LOST;
+  const int code = std::atoi(line.c_str() + space + 1);
+
+  while (_readLine(line) && !line.empty()) {
+    const size_t colon = line.find(':');
+    if (colon == std::string::npos)
+      continue;
+    const std::string name = toLower(line.substr(0, colon));
+    const size_t start = line.find_first_not_of(' ', colon + 1);
+    const String value = start == std::string::npos ? "" : line.substr(start);
+    if (name == "content-length")
+      _size = std::atoi(value.c_str());
+    else if (name == "connection")
+      _canReuse = _canReuse && !value.equalsIgnoreCase("close");
+    auto it = _headers.find(name);
+    if (it != _headers.end())
+      it->second = value;
+  }
+
+  return code;
+}
+
+String HTTPClient::header(const char* name) {
+  auto it = _headers.find(toLower(name));
+  return it == _headers.end() ? "" : it->second;
+}
+
+String HTTPClient::errorToString(int error) {
+  switch (error) {
+    case HTTPC_ERROR_CONNECTION_REFUSED:
+      return "connection refused";
+    case HTTPC_ERROR_SEND_HEADER_FAILED:
+      return "send header failed";
+    case HTTPC_ERROR_CONNECTION_LOST:
+      return "connection lost";
+    case HTTPC_ERROR_READ_TIMEOUT:
+      return "read Timeout";
+    default:
+      return "";
+  }
+}
+
+bool HTTPClient::_readLine(String& line) {
+  line.clear();
+  char c;
+  while (_client->readBytes(&c, 1)) {
+    if (c == '\n') {
+      if (!line.empty() && line.back() == '\r')
+        line.pop_back();
+      return true;
+    }
+    line += c;
+  }
+  return false;
+}
@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#pragma once
+
+// Host replacement of the Arduino HTTP client: same API subset, GET requests over a kept-alive WiFiClient.
+// Like on the device, the body is left in the stream after GET() and end() drops what is left of it.
+
+#include <Arduino.h>
+#include <WiFiClient.h>
+
+#include <map>
+
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED (-2)
+#define HTTPC_ERROR_CONNECTION_LOST    (-5)
+#define HTTPC_ERROR_READ_TIMEOUT       (-11)
+
+#define HTTP_CODE_OK 200
+
+class HTTPClient {
+  public:
+    bool begin(WiFiClient& client, String host, uint16_t port, String uri);
+    void end();
+
+    void setReuse(bool reuse) { _reuse = reuse; }
+    void setTimeout(uint16_t timeout) { _timeout = timeout; }
+    void setConnectTimeout(int32_t timeout) { _connectTimeout = timeout; }
+    void useHTTP10(bool http10) { _http10 = http10; }
+    void collectHeaders(const char* headerKeys[], const size_t headerKeysCount);
+
+    int GET();
+    int getSize() const { return _size; }
+    WiFiClient& getStream() { return *_client; }
+    String header(const char* name);
+
+    static String errorToString(int error);
+
+  private:
+    WiFiClient* _client = nullptr;
+    String _host;
+    uint16_t _port = 80;
+    String _uri;
+    bool _reuse = true;
+    bool _canReuse = false;
+    bool _http10 = false;
+    uint16_t _timeout = 5000;
+    int32_t _connectTimeout = 5000;
+    int _size = -1;
+    // collected header names (lower case) and their value in the last response
+    std::map<std::string, String> _headers;
+
+    bool _readLine(String& line);
+};
@@ -0,0 +1,175 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#include <ModbusClientTCPasync.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+std::atomic<bool> ModbusClientTCPasync::lockstep{false};
+
+ModbusError::operator const char*() const {
+  switch (_error) {
+    case SUCCESS:
+      return "Success";
+    case ILLEGAL_FUNCTION:
+      return "Illegal function code";
+    case ILLEGAL_DATA_ADDRESS:
+      return "Illegal data address";
+    case ILLEGAL_DATA_VALUE:
+      return "Illegal data value";
+    case SERVER_DEVICE_FAILURE:
+      return "Server device failure";
+    case TIMEOUT:
+      return "Timeout";
+    case PACKET_LENGTH_ERROR:
+      return "Packet length error";
+    case PARAMETER_LIMIT_ERROR:
+      return "Parameter limit error";
+    case REQUEST_QUEUE_FULL:
+      return "Request queue full";
+    case IP_CONNECTION_FAILED:
+      return "IP connection failed";
+    default:
+      return "Undefined error";
+  }
+}
+
+static bool _readFully(int socket, uint8_t* buffer, size_t len) {
+  while (len) {
+    const ssize_t n = recv(socket, buffer, len, 0);
+    if (n <= 0)
+      return false;
+    buffer += n;
+    len -= n;
+  }
+  return true;
+}
+
+Error ModbusClientTCPasync::addRequest(uint32_t token, uint8_t serverID, uint8_t functionCode, uint16_t address, uint16_t count) {
+  if (functionCode != 0x03 && functionCode != 0x04)
+    return ILLEGAL_FUNCTION;
+  if (count < 1 || count > 125)
+    return PARAMETER_LIMIT_ERROR;
+
+  std::unique_lock<std::mutex> lock(_mutex);
+
+  if (_inflight.size() >= _maxInflight)
+    return REQUEST_QUEUE_FULL;
+  if (_socket < 0 && !_connect())
+    return IP_CONNECTION_FAILED;
+
+  // MBAP header: transaction (2), protocol (2), length (2), unit (1), then the PDU
+  const uint16_t transaction = ++_transaction;
+  const uint8_t request[] = {
+    static_cast<uint8_t>(transaction >> 8),
+    static_cast<uint8_t>(transaction),
+    0,
+    0,
+    0,
+    6,
+    serverID,
+    functionCode,
+    static_cast<uint8_t>(address >> 8),
+    static_cast<uint8_t>(address),
+    static_cast<uint8_t>(count >> 8),
+    static_cast<uint8_t>(count),
+  };
+  _inflight[transaction] = token;
+
+  if (send(_socket, request, sizeof(request), MSG_NOSIGNAL) != sizeof(request)) {
+    _inflight.erase(transaction);
+    return IP_CONNECTION_FAILED;
+  }
+
+  if (lockstep)
+    _received.wait(lock, [&]() { return !_inflight.count(transaction) || _socket < 0; });
+
+  return SUCCESS;
+}
+
+void ModbusClientTCPasync::disconnect(bool /* force */) {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_socket >= 0)
+      shutdown(_socket, SHUT_RDWR);
+  }
+  // the reader closes the socket when it stops
+  if (_reader.joinable())
+    _reader.join();
+}
+
+bool ModbusClientTCPasync::_connect() {
+  sockaddr_in address = {};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(_port);
+  if (inet_pton(AF_INET, _address.c_str(), &address.sin_addr) != 1)
+    return false;
+
+  const int s = socket(AF_INET, SOCK_STREAM, 0);
+  if (s < 0)
+    return false;
+  if (connect(s, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+    close(s);
+    return false;
+  }
+  const int one = 1;
+  setsockopt(s, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+  _socket = s;
+  if (_reader.joinable())
+    _reader.join();
+  _reader = std::thread([this]() { _read(); });
+  return true;
+}
+
+void ModbusClientTCPasync::_read() {
+  for (;;) {
+    uint8_t header[7];
+    if (!_readFully(_socket, header, sizeof(header)))
+      break;
+
+    const uint16_t transaction = (header[0] << 8) | header[1];
+    const uint16_t length = (header[4] << 8) | header[5];
+    if (length < 2)
+      break;
+
+    // message passed to the handler: unit, then the PDU
+    std::vector<uint8_t> message(length);
+    message[0] = header[6];
+    if (!_readFully(_socket, message.data() + 1, length - 1))
+      break;
+
+    uint32_t token;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      auto it = _inflight.find(transaction);
+      if (it == _inflight.end())
+        continue;
+      token = it->second;
+    }
+
+    if (message[1] & 0x80) {
+      if (_onError)
+        _onError(message.size() > 2 ? static_cast<Error>(message[2]) : UNDEFINED_ERROR, token);
+    } else if (_onData) {
+      _onData(ModbusMessage(std::move(message)), token);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _inflight.erase(transaction);
+    }
+    _received.notify_all();
+  }
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  close(_socket);
+  _inflight.clear();
+  _socket = -1;
+  _received.notify_all();
+}
@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#pragma once
+
+// Host replacement of the eModbus async TCP client: same API subset, implemented with a blocking socket and a reader thread.
+// Handlers are called from the reader thread, like they are called from the AsyncTCP task on the device.
+
+#include <Arduino.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+enum Error : uint8_t {
+  SUCCESS = 0x00,
+  ILLEGAL_FUNCTION = 0x01,
+  ILLEGAL_DATA_ADDRESS = 0x02,
+  ILLEGAL_DATA_VALUE = 0x03,
+  SERVER_DEVICE_FAILURE = 0x04,
+  TIMEOUT = 0xE0,
+  PACKET_LENGTH_ERROR = 0xE5,
+  PARAMETER_LIMIT_ERROR = 0xE7,
+  REQUEST_QUEUE_FULL = 0xE8,
+  IP_CONNECTION_FAILED = 0xEA,
+  UNDEFINED_ERROR = 0xFF,
+};
+
+class ModbusError {
+  public:
+    explicit ModbusError(Error error) : _error(error) {}
+    operator Error() const { return _error; }
+    operator const char*() const;
+
+  private:
+    Error _error;
+};
+
+class ModbusMessage {
+  public:
+    ModbusMessage() = default;
+    explicit ModbusMessage(std::vector<uint8_t> data) : _data(std::move(data)) {}
+    const uint8_t* data() const { return _data.data(); }
+    uint16_t size() const { return _data.size(); }
+    uint8_t operator[](uint16_t index) const { return index < _data.size() ? _data[index] : 0; }
+
+  private:
+    std::vector<uint8_t> _data;
+};
+
+class ModbusClientTCPasync {
+  public:
+    typedef std::function<void(ModbusMessage msg, uint32_t token)> MBOnData;
+    typedef std::function<void(Error err, uint32_t token)> MBOnError;
+
+    // host only: when set, addRequest() returns after the handler of its response has been called,
+    // which is the worst case of a response received before addRequest() returns
+    static std::atomic<bool> lockstep;
+
+    ModbusClientTCPasync(IPAddress address, uint16_t port) : _address(address), _port(port) {}
+    ~ModbusClientTCPasync() { disconnect(); }
+
+    void setMaxInflightRequests(uint32_t maxInflightRequests) { _maxInflight = maxInflightRequests; }
+    bool onDataHandler(MBOnData handler) { _onData = handler; return true; }
+    bool onErrorHandler(MBOnError handler) { _onError = handler; return true; }
+
+    // read holding (0x03) or input (0x04) registers
+    Error addRequest(uint32_t token, uint8_t serverID, uint8_t functionCode, uint16_t address, uint16_t count);
+
+    void disconnect(bool force = false);
+
+  private:
+    IPAddress _address;
+    uint16_t _port;
+    uint32_t _maxInflight = 1;
+    MBOnData _onData = nullptr;
+    MBOnError _onError = nullptr;
+    int _socket = -1;
+    std::thread _reader;
+    std::mutex _mutex;
+    std::condition_variable _received;
+    uint16_t _transaction = 0;
+    // token of each transaction waiting for a response
+    std::map<uint16_t, uint32_t> _inflight;
+
+    bool _connect();
+    void _read();
+};
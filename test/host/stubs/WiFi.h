@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#pragma once
+
+// Host replacement of the WiFi object: only IP addresses are resolved
+
+#include <Arduino.h>
+
+#include <arpa/inet.h>
+
+class WiFiClass {
+  public:
+    bool hostByName(const char* host, IPAddress& ip) {
+      in_addr address;
+      if (inet_pton(AF_INET, host, &address) != 1)
+        return false;
+      ip = IPAddress(host);
+      return true;
+    }
+};
+
+inline WiFiClass WiFi;
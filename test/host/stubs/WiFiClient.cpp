@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#include <WiFiClient.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+int WiFiClient::connect(const char* host, uint16_t port, int32_t /* timeout */) {
+  stop();
+
+  sockaddr_in address = {};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(port);
+  if (inet_pton(AF_INET, host, &address.sin_addr) != 1)
+    return 0;
+
+  const int s = socket(AF_INET, SOCK_STREAM, 0);
+  if (s < 0)
+    return 0;
+  if (::connect(s, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+    close(s);
+    return 0;
+  }
+  const int one = 1;
+  setsockopt(s, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  _socket = s;
+  return 1;
+}
+
+uint8_t WiFiClient::connected() {
+  if (_socket < 0)
+    return 0;
+  // the connection is still open if data is pending or if the peer has not closed it
+  char c;
+  const ssize_t n = recv(_socket, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+  if (n > 0 || (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)))
+    return 1;
+  stop();
+  return 0;
+}
+
+void WiFiClient::stop() {
+  if (_socket >= 0) {
+    close(_socket);
+    _socket = -1;
+  }
+}
+
+int WiFiClient::available() {
+  if (_socket < 0)
+    return 0;
+  int count = 0;
+  return ioctl(_socket, FIONREAD, &count) == 0 ? count : 0;
+}
+
+int WiFiClient::read() {
+  if (_socket < 0)
+    return -1;
+  uint8_t c;
+  return recv(_socket, &c, 1, MSG_DONTWAIT) == 1 ? c : -1;
+}
+
+size_t WiFiClient::write(const uint8_t* buffer, size_t size) {
+  if (_socket < 0)
+    return 0;
+  const ssize_t n = send(_socket, buffer, size, MSG_NOSIGNAL);
+  return n < 0 ? 0 : n;
+}
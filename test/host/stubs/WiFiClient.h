@@ -0,0 +1,25 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#pragma once
+
+// Host replacement of the Arduino TCP client, implemented with a non-blocking read on a socket
+
+#include <Arduino.h>
+
+class WiFiClient : public Stream {
+  public:
+    ~WiFiClient() override { stop(); }
+
+    int connect(const char* host, uint16_t port, int32_t timeout);
+    uint8_t connected();
+    void stop();
+
+    int available() override;
+    int read() override;
+    size_t write(const uint8_t* buffer, size_t size);
+
+  private:
+    int _socket = -1;
+};
@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+#pragma once
+
+// Host replacement of the application header for the sources built in test/host (src/yasolr_settings.cpp):
+// the configuration is kept in memory, with the same lookups and parsing as MycilaConfig for a cached key.
+
+#include <yasolr_settings.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+
+class HostConfig {
+  public:
+    void set(const char* key, std::string value) { _values[key] = std::move(value); }
+
+    const std::string& getString(const char* key) const {
+      static const std::string empty;
+      auto it = _values.find(key);
+      return it == _values.end() ? empty : it->second;
+    }
+    const char* get(const char* key) const { return getString(key).c_str(); }
+    long getLong(const char* key) const { return std::strtol(get(key), nullptr, 10); }
+    int getInt(const char* key) const { return static_cast<int>(getLong(key)); }
+    float getFloat(const char* key) const { return std::strtof(get(key), nullptr); }
+    bool getBool(const char* key) const {
+      const std::string& value = getString(key);
+      return value == YASOLR_TRUE || value == "1" || value == "on" || value == "yes";
+    }
+
+  private:
+    struct Less {
+        bool operator()(const char* a, const char* b) const { return std::strcmp(a, b) < 0; }
+    };
+    std::map<const char*, std::string, Less> _values;
+};
+
+extern HostConfig config;
+extern YaSolR::Settings settings;
@@ -0,0 +1,333 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+// Reads simulated DS18 probes on several 1-Wire buses with Mycila::DS18Scheduler
+#include <MycilaDS18Scheduler.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(condition)                                                     \
+  do {                                                                       \
+    if (!(condition)) {                                                      \
+      printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+      failures++;                                                            \
+    }                                                                        \
+  } while (0)
+
+static uint64_t rom(uint8_t family, uint64_t serial) {
+  uint8_t bytes[8] = {family};
+  for (int i = 1; i < 7; i++)
+    bytes[i] = static_cast<uint8_t>(serial >> (8 * (i - 1)));
+  bytes[7] = Mycila::OneWire::crc8(bytes, 7);
+  uint64_t address = 0;
+  for (int i = 0; i < 8; i++)
+    address |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+  return address;
+}
+
+struct FakeProbe {
+    uint64_t address;
+    float temperature;
+    uint8_t config = 0x7F;
+    bool converted = false;
+    bool corrupted = false;
+};
+
+struct Conversion {
+    std::string bus;
+    uint32_t time;
+};
+
+static uint32_t now = 0;
+static std::vector<Conversion> conversions;
+
+/**
+ * Simulates DS18 probes at the time slot level: search, match and skip ROM, convert, read and write scratchpad
+ */
+class FakeBus : public Mycila::OneWire::Bus {
+  public:
+    explicit FakeBus(const char* name) : _name(name) {}
+
+    std::vector<FakeProbe> probes;
+
+    bool reset() override {
+      _phase = Phase::ROM_COMMAND;
+      _selected.assign(probes.size(), true);
+      _bits = 0;
+      return !probes.empty();
+    }
+
+    void writeBit(bool bit) override {
+      if (_phase == Phase::SEARCH) {
+        for (size_t i = 0; i < probes.size(); i++)
+          if (((probes[i].address >> _searchBit) & 1) != bit)
+            _selected[i] = false;
+        _searchStep = 0;
+        if (++_searchBit == 64)
+          _phase = Phase::FUNCTION_COMMAND;
+        return;
+      }
+      _byte = (_byte >> 1) | (bit ? 0x80 : 0);
+      if (++_bits == 8) {
+        _bits = 0;
+        _onByte(_byte);
+      }
+    }
+
+    bool readBit() override {
+      if (_phase == Phase::SEARCH) {
+        // wired-AND of the bit, then of its complement, of all the devices still taking part
+        const bool complement = _searchStep++ == 1;
+        bool value = true;
+        for (size_t i = 0; i < probes.size(); i++)
+          if (_selected[i])
+            value &= (((probes[i].address >> _searchBit) & 1) != 0) != complement;
+        return value;
+      }
+      if (_phase == Phase::READ && _readBit < _output.size() * 8) {
+        const bool bit = (_output[_readBit / 8] >> (_readBit % 8)) & 1;
+        _readBit++;
+        return bit;
+      }
+      return true;
+    }
+
+  private:
+    enum class Phase {
+      ROM_COMMAND,
+      MATCH_ROM,
+      SEARCH,
+      FUNCTION_COMMAND,
+      READ,
+      WRITE_SCRATCHPAD,
+    };
+
+    std::string _name;
+    Phase _phase = Phase::ROM_COMMAND;
+    std::vector<bool> _selected;
+    uint8_t _byte = 0;
+    int _bits = 0;
+    int _count = 0;
+    uint64_t _match = 0;
+    int _searchBit = 0;
+    int _searchStep = 0;
+    std::vector<uint8_t> _output;
+    size_t _readBit = 0;
+
+    void _onByte(uint8_t byte) {
+      switch (_phase) {
+        case Phase::ROM_COMMAND:
+          if (byte == Mycila::OneWire::CMD_SKIP_ROM) {
+            _phase = Phase::FUNCTION_COMMAND;
+          } else if (byte == Mycila::OneWire::CMD_MATCH_ROM) {
+            _phase = Phase::MATCH_ROM;
+            _match = 0;
+            _count = 0;
+          } else if (byte == Mycila::OneWire::CMD_SEARCH_ROM) {
+            _phase = Phase::SEARCH;
+            _searchBit = 0;
+            _searchStep = 0;
+          }
+          break;
+        case Phase::MATCH_ROM:
+          _match |= static_cast<uint64_t>(byte) << (8 * _count);
+          if (++_count == 8) {
+            for (size_t i = 0; i < probes.size(); i++)
+              _selected[i] = probes[i].address == _match;
+            _phase = Phase::FUNCTION_COMMAND;
+          }
+          break;
+        case Phase::FUNCTION_COMMAND:
+          if (byte == 0x44) {
+            conversions.push_back({_name, now});
+            for (size_t i = 0; i < probes.size(); i++)
+              if (_selected[i])
+                probes[i].converted = true;
+          } else if (byte == 0xBE) {
+            _output.assign(9, 0xFF);
+            for (size_t i = 0; i < probes.size(); i++) {
+              if (_selected[i]) {
+                const std::vector<uint8_t> scratchpad = _scratchpad(probes[i]);
+                for (size_t b = 0; b < 9; b++)
+                  _output[b] &= scratchpad[b];
+              }
+            }
+            _readBit = 0;
+            _phase = Phase::READ;
+          } else if (byte == 0x4E) {
+            _count = 0;
+            _phase = Phase::WRITE_SCRATCHPAD;
+          }
+          break;
+        case Phase::WRITE_SCRATCHPAD:
+          // TH, TL, then configuration
+          if (_count++ == 2) {
+            for (size_t i = 0; i < probes.size(); i++)
+              if (_selected[i])
+                probes[i].config = byte;
+          }
+          break;
+        default:
+          break;
+      }
+    }
+
+    static std::vector<uint8_t> _scratchpad(const FakeProbe& probe) {
+      std::vector<uint8_t> scratchpad(9);
+      if ((probe.address & 0xFF) == 0x10) {
+        // DS18S20: 0.5 °C register and count remaining for the extended resolution
+        const int whole = static_cast<int>(std::floor(probe.temperature));
+        const int16_t raw = probe.converted ? whole * 2 : 0x00AA;
+        scratchpad = {static_cast<uint8_t>(raw), static_cast<uint8_t>(raw >> 8), 0x4B, 0x46, 0xFF, 0xFF,
+                      static_cast<uint8_t>(16 - std::lround((probe.temperature - whole + 0.25f) * 16)), 0x10};
+      } else {
+        const uint8_t resolution = 9 + ((probe.config >> 5) & 0x03);
+        const int16_t raw = probe.converted ? static_cast<int16_t>(std::lround(probe.temperature * 16)) & ~((1 << (12 - resolution)) - 1) : 0x0550;
+        scratchpad = {static_cast<uint8_t>(raw), static_cast<uint8_t>(raw >> 8), 0x4B, 0x46, probe.config, 0xFF, 0x0C, 0x10};
+      }
+      scratchpad.push_back(Mycila::OneWire::crc8(scratchpad.data(), 8) ^ (probe.corrupted ? 0x01 : 0x00));
+      return scratchpad;
+    }
+};
+
+static void testSearch() {
+  FakeBus bus("search");
+  for (uint64_t serial : {0x000000000001ULL, 0x000000000003ULL, 0x800000000002ULL, 0x7FFFFFFFFFFFULL})
+    bus.probes.push_back({rom(0x28, serial), 20});
+  // not a temperature probe
+  bus.probes.push_back({rom(0x01, 0x123456), 0});
+
+  uint64_t found[8];
+  CHECK(bus.search(found, 8) == 5);
+  for (const FakeProbe& probe : bus.probes)
+    CHECK(std::find(found, found + 5, probe.address) != found + 5);
+
+  Mycila::DS18Bus ds18(bus);
+  CHECK(ds18.begin());
+  CHECK(ds18.getProbeCount() == 4);
+
+  FakeBus empty("empty");
+  Mycila::DS18Bus none(empty);
+  CHECK(!none.begin(12, 2));
+  CHECK(!none.isEnabled());
+}
+
+static void testScheduler() {
+  conversions.clear();
+  now = 0;
+
+  // output bus: top and bottom of the tank, the bottom one at 12 bits
+  FakeBus outputBus("output");
+  outputBus.probes.push_back({rom(0x28, 0xA1), 61.5625f});
+  outputBus.probes.push_back({rom(0x28, 0xA2), 38.25f});
+  Mycila::DS18Bus output(outputBus);
+  CHECK(output.begin(10));
+  CHECK(outputBus.probes[0].config == 0x3F);
+  CHECK(outputBus.probes[1].config == 0x3F);
+  CHECK(output.getConversionTime() == 188);
+  const size_t bottom = output.getAddress(0) == outputBus.probes[1].address ? 0 : 1;
+  CHECK(output.setResolution(bottom, 12));
+  CHECK(outputBus.probes[1].config == 0x7F);
+  CHECK(output.getConversionTime() == 750);
+  output.setInterval(2000);
+
+  // router bus: one DS18B20 at 9 bits
+  FakeBus routerBus("router");
+  routerBus.probes.push_back({rom(0x28, 0xB1), -10.125f});
+  Mycila::DS18Bus router(routerBus);
+  CHECK(router.begin(9));
+  CHECK(router.getConversionTime() == 94);
+  router.setInterval(10000);
+
+  size_t outputReads = 0;
+  float outputTemperature = NAN;
+  output.listen([&](float temperature, bool /* changed */) {
+    outputReads++;
+    outputTemperature = temperature;
+  });
+
+  Mycila::DS18Scheduler scheduler;
+  scheduler.add(output);
+  scheduler.add(router);
+
+  // conversions start on both buses at once and last as long as the slowest probe
+  CHECK(scheduler.loop(now) == 750);
+  CHECK(conversions.size() == 2);
+  CHECK(conversions[0].time == 0 && conversions[1].time == 0);
+  CHECK(outputReads == 0);
+
+  // nothing is read before the end of the conversion
+  now = 500;
+  CHECK(scheduler.loop(now) == 250);
+  CHECK(outputReads == 0);
+
+  now = 750;
+  CHECK(scheduler.loop(now) == 1250);
+  CHECK(outputReads == 1);
+  // 10 bits: 0.25 °C steps
+  CHECK(outputTemperature == 61.5f);
+  CHECK(output.getTemperature().value() == 61.5f);
+  CHECK(output.getTemperature(bottom).value() == 38.25f);
+  CHECK(output.getLastTime() == 750);
+  CHECK(router.getTemperature().value() == -10.5f);
+
+  // only the output bus is due
+  now = 2000;
+  CHECK(scheduler.loop(now) == 750);
+  CHECK(conversions.size() == 3);
+  CHECK(conversions[2].bus == "output");
+
+  // a corrupted read keeps the last temperature of the probe
+  outputBus.probes[0].corrupted = true;
+  outputBus.probes[0].temperature = 70;
+  now = 2750;
+  scheduler.loop(now);
+  CHECK(outputReads == 2);
+  CHECK(output.getTemperature().value() == 61.5f);
+
+  // ... until it fails too many times
+  for (int i = 0; i < 2; i++) {
+    now += 2000;
+    scheduler.loop(now);
+    now += 750;
+    scheduler.loop(now);
+  }
+  CHECK(output.getTemperature().value() == 38.25f);
+
+  // the router bus is due again after 10 s
+  now = 10750;
+  scheduler.loop(now);
+  CHECK(conversions.back().bus == "router");
+}
+
+static void testDS18S20() {
+  FakeBus bus("ds18s20");
+  bus.probes.push_back({rom(0x10, 0xC1), 21.75f});
+  Mycila::DS18Bus ds18(bus);
+  CHECK(ds18.begin(9));
+  CHECK(ds18.getConversionTime() == 750);
+
+  // power-on value before the first conversion
+  CHECK(ds18.convert());
+  bus.probes[0].converted = false;
+  CHECK(!ds18.read(1));
+  CHECK(!ds18.getTemperature().has_value());
+
+  CHECK(ds18.convert());
+  CHECK(ds18.read(2));
+  CHECK(ds18.getTemperature().value() == 21.75f);
+}
+
+int main() {
+  testSearch();
+  testScheduler();
+  testDS18S20();
+  printf("%s\n", failures ? "FAILED" : "OK");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,333 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+// Reads a local HTTP stand-in server through the host HTTP client: response bodies with Content-Length, chunked or ended by the connection,
+// on a kept-alive connection. With ArduinoJson, also polls the stand-in with Mycila::HTTPMeter.
+#include <HTTPClient.h>
+#include <MycilaHTTPBody.h>
+
+#if __has_include(<ArduinoJson.h>)
+  #include <MycilaHTTPMeter.h>
+#endif
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+
+static int failures = 0;
+
+#define CHECK(condition)                                                     \
+  do {                                                                       \
+    if (!(condition)) {                                                      \
+      printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+      failures++;                                                            \
+    }                                                                        \
+  } while (0)
+
+#define CHECK_NEAR(value, expected) CHECK(std::fabs((value) - (expected)) < 0.01f)
+
+/**
+ * HTTP/1.1 server answering each GET request with the same body, framed according to its mode.
+ */
+class StandInServer {
+  public:
+    enum class Mode {
+      // Content-Length, connection kept alive
+      LENGTH,
+      // Transfer-Encoding: chunked in small chunks with an extension and a trailer, connection kept alive
+      CHUNKED,
+      // no length: the body ends when the connection is closed
+      CLOSE,
+      // Content-Length larger than the body, then the connection is closed
+      TRUNCATED,
+      // 404 with a body, connection kept alive
+      NOT_FOUND,
+    };
+
+    StandInServer() {
+      _listener = socket(AF_INET, SOCK_STREAM, 0);
+      const int one = 1;
+      setsockopt(_listener, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+      sockaddr_in address = {};
+      address.sin_family = AF_INET;
+      address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      bind(_listener, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+      listen(_listener, 4);
+      socklen_t len = sizeof(address);
+      getsockname(_listener, reinterpret_cast<sockaddr*>(&address), &len);
+      _port = ntohs(address.sin_port);
+      _thread = std::thread([this]() { _serve(); });
+    }
+
+    ~StandInServer() {
+      shutdown(_listener, SHUT_RDWR);
+      close(_listener);
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_client >= 0)
+          shutdown(_client, SHUT_RDWR);
+      }
+      _thread.join();
+    }
+
+    uint16_t getPort() const { return _port; }
+
+    void set(Mode mode, std::string body) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _mode = mode;
+      _body = std::move(body);
+    }
+
+    size_t getConnections() {
+      std::lock_guard<std::mutex> lock(_mutex);
+      return _connections;
+    }
+
+    size_t getRequests() {
+      std::lock_guard<std::mutex> lock(_mutex);
+      return _requests;
+    }
+
+  private:
+    int _listener;
+    int _client = -1;
+    uint16_t _port;
+    std::thread _thread;
+    std::mutex _mutex;
+    Mode _mode = Mode::LENGTH;
+    std::string _body;
+    size_t _connections = 0;
+    size_t _requests = 0;
+
+    void _serve() {
+      for (;;) {
+        const int client = accept(_listener, nullptr, nullptr);
+        if (client < 0)
+          return;
+        {
+          std::lock_guard<std::mutex> lock(_mutex);
+          _client = client;
+          _connections++;
+        }
+        while (_readRequest(client)) {
+          std::string response;
+          bool keepAlive = true;
+          {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _requests++;
+            keepAlive = _respond(response);
+          }
+          // sent in small pieces so that the client reads the response across several segments
+          for (size_t i = 0; i < response.size(); i += 7) {
+            send(client, response.data() + i, std::min<size_t>(7, response.size() - i), MSG_NOSIGNAL);
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+          }
+          if (!keepAlive)
+            break;
+        }
+        std::lock_guard<std::mutex> lock(_mutex);
+        close(client);
+        _client = -1;
+      }
+    }
+
+    // reads the request head up to the empty line
+    bool _readRequest(int client) {
+      std::string head;
+      char c;
+      while (head.size() < 4 || head.compare(head.size() - 4, 4, "\r\n\r\n") != 0) {
+        if (recv(client, &c, 1, 0) != 1)
+          return false;
+        head += c;
+      }
+      return head.compare(0, 4, "GET ") == 0;
+    }
+
+    // returns false if the connection must be closed after the response
+    bool _respond(std::string& response) {
+      switch (_mode) {
+        case Mode::LENGTH:
+          response = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: " + std::to_string(_body.size()) + "\r\n\r\n" + _body;
+          return true;
+        case Mode::CHUNKED: {
+          response = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nTransfer-Encoding: chunked\r\n\r\n";
+          char size[16];
+          for (size_t i = 0; i < _body.size(); i += 10) {
+            const size_t n = std::min<size_t>(10, _body.size() - i);
+            snprintf(size, sizeof(size), "%zX", n);
+            response += size;
+            response += i ? "\r\n" : ";part=first\r\n";
+            response += _body.substr(i, n) + "\r\n";
+          }
+          response += "0\r\nX-Checksum: none\r\n\r\n";
+          return true;
+        }
+        case Mode::CLOSE:
+          response = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nConnection: close\r\n\r\n" + _body;
+          return false;
+        case Mode::TRUNCATED:
+          response = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: " + std::to_string(_body.size() + 10) + "\r\n\r\n" + _body;
+          return false;
+        case Mode::NOT_FOUND:
+        default:
+          response = "HTTP/1.1 404 Not Found\r\nContent-Type: text/plain\r\nContent-Length: 9\r\n\r\nNot Found";
+          return true;
+      }
+    }
+};
+
+static const char* BODY = R"({"id":0,"current":5.2,"voltage":230.1,"act_power":1200.5,"aprt_power":1250,"pf":0.96,"freq":50,"calibration":"factory"})";
+
+// GET the body through the HTTP client and the body reader, like the meter does
+static bool get(HTTPClient& http, WiFiClient& client, uint16_t port, std::string& body, bool& complete) {
+  if (!http.begin(client, "127.0.0.1", port, "/rpc/EM1.GetStatus?id=0"))
+    return false;
+  const int code = http.GET();
+  Mycila::HTTP::BodyReader<Stream> reader(http.getStream(), http.getSize(), http.header("Transfer-Encoding").equalsIgnoreCase("chunked"));
+  body.clear();
+  // read in small parts, then through read() to check both paths
+  char buffer[5];
+  size_t n;
+  while (body.size() < 20 && (n = reader.readBytes(buffer, sizeof(buffer))))
+    body.append(buffer, n);
+  int c;
+  while ((c = reader.read()) >= 0)
+    body += static_cast<char>(c);
+  complete = reader.skip();
+  if (!complete)
+    client.stop();
+  http.end();
+  return code == HTTP_CODE_OK;
+}
+
+static void testBody(StandInServer& server) {
+  static const char* headers[] = {"Transfer-Encoding"};
+  HTTPClient http;
+  WiFiClient client;
+  http.setReuse(true);
+  http.setTimeout(200);
+  http.collectHeaders(headers, 1);
+
+  std::string body;
+  bool complete;
+
+  // all the responses of a kept-alive connection are read entirely: the next one starts at its status line
+  server.set(StandInServer::Mode::LENGTH, BODY);
+  for (int i = 0; i < 3; i++) {
+    CHECK(get(http, client, server.getPort(), body, complete));
+    CHECK(complete);
+    CHECK(body == BODY);
+  }
+  server.set(StandInServer::Mode::CHUNKED, BODY);
+  for (int i = 0; i < 3; i++) {
+    CHECK(get(http, client, server.getPort(), body, complete));
+    CHECK(complete);
+    CHECK(body == BODY);
+  }
+  server.set(StandInServer::Mode::NOT_FOUND, "");
+  CHECK(!get(http, client, server.getPort(), body, complete));
+  CHECK(complete);
+  CHECK(body == "Not Found");
+  server.set(StandInServer::Mode::LENGTH, BODY);
+  CHECK(get(http, client, server.getPort(), body, complete));
+  CHECK(body == BODY);
+  CHECK(server.getConnections() == 1);
+
+  // the body is delimited by the end of the connection
+  server.set(StandInServer::Mode::CLOSE, BODY);
+  CHECK(get(http, client, server.getPort(), body, complete));
+  CHECK(complete);
+  CHECK(body == BODY);
+  CHECK(server.getConnections() == 1);
+
+  // a truncated body is an error: the client reconnects for the next request
+  server.set(StandInServer::Mode::TRUNCATED, BODY);
+  CHECK(get(http, client, server.getPort(), body, complete));
+  CHECK(!complete);
+  CHECK(body == BODY);
+  server.set(StandInServer::Mode::CHUNKED, BODY);
+  CHECK(get(http, client, server.getPort(), body, complete));
+  CHECK(complete);
+  CHECK(body == BODY);
+  CHECK(server.getConnections() == 3);
+}
+
+#if __has_include(<ArduinoJson.h>)
+static void testMeter(StandInServer& server) {
+  Mycila::HTTPMeter meter;
+  size_t reads = 0;
+  size_t errors = 0;
+  meter.setCallback([&](Mycila::HTTPMeter::EventType event) {
+    if (event == Mycila::HTTPMeter::EventType::EVT_READ)
+      reads++;
+    else
+      errors++;
+  });
+
+  const size_t connections = server.getConnections();
+  CHECK(meter.begin("127.0.0.1", server.getPort(), Mycila::HTTP::SHELLY_PRO_EM));
+
+  for (StandInServer::Mode mode : {StandInServer::Mode::LENGTH, StandInServer::Mode::CHUNKED}) {
+    server.set(mode, BODY);
+    for (int i = 0; i < 3; i++)
+      CHECK(meter.read());
+  }
+
+  CHECK(reads == 6);
+  CHECK(errors == 0);
+  CHECK(!meter.hasError());
+  CHECK_NEAR(meter.getMetrics().power, 1200.5f);
+  CHECK_NEAR(meter.getMetrics().voltage, 230.1f);
+  CHECK_NEAR(meter.getMetrics().current, 5.2f);
+  CHECK_NEAR(meter.getMetrics().apparentPower, 1250.0f);
+  CHECK_NEAR(meter.getMetrics().powerFactor, 0.96f);
+  CHECK_NEAR(meter.getMetrics().frequency, 50.0f);
+  // the connection is kept alive across chunked and non-chunked responses
+  CHECK(server.getConnections() == connections + 1);
+
+  // the fields outside of the map are filtered out while parsing
+  CHECK(meter.getMetrics().energy != meter.getMetrics().energy);
+
+  server.set(StandInServer::Mode::NOT_FOUND, "");
+  CHECK(!meter.read());
+  CHECK(meter.getLastError() == "HTTP 404");
+
+  server.set(StandInServer::Mode::CHUNKED, R"({"id":0,"voltage":230.1})");
+  CHECK(!meter.read());
+  CHECK(meter.getLastError() == "Power not found in response");
+
+  server.set(StandInServer::Mode::CHUNKED, R"({"id":0,"act_power":)");
+  CHECK(!meter.read());
+  CHECK(meter.hasError());
+
+  // the meter recovers on the next valid response
+  server.set(StandInServer::Mode::LENGTH, BODY);
+  CHECK(meter.read());
+  CHECK(!meter.hasError());
+  CHECK(errors == 3);
+
+  meter.end();
+}
+#endif
+
+int main() {
+  StandInServer server;
+
+  testBody(server);
+#if __has_include(<ArduinoJson.h>)
+  testMeter(server);
+#else
+  printf("ArduinoJson not found: HTTPMeter not tested\n");
+#endif
+
+  printf("%s\n", failures ? "FAILED" : "OK");
+  return failures;
+}
@@ -0,0 +1,279 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+// Reads a local Modbus TCP stand-in server with Mycila::ModbusMeter
+#include <MycilaModbusMeter.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <tuple>
+
+static int failures = 0;
+
+#define CHECK(condition)                                                     \
+  do {                                                                       \
+    if (!(condition)) {                                                      \
+      printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+      failures++;                                                            \
+    }                                                                        \
+  } while (0)
+
+#define CHECK_NEAR(value, expected) CHECK(std::fabs((value) - (expected)) < 0.01f)
+
+/**
+ * Modbus TCP server answering read requests from a register table: unknown registers are read as 0.
+ * A unit can be set to answer with an exception.
+ */
+class StandInServer {
+  public:
+    StandInServer() {
+      _listener = socket(AF_INET, SOCK_STREAM, 0);
+      const int one = 1;
+      setsockopt(_listener, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+      sockaddr_in address = {};
+      address.sin_family = AF_INET;
+      address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      bind(_listener, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+      listen(_listener, 4);
+      socklen_t len = sizeof(address);
+      getsockname(_listener, reinterpret_cast<sockaddr*>(&address), &len);
+      _port = ntohs(address.sin_port);
+      _thread = std::thread([this]() { _serve(); });
+    }
+
+    ~StandInServer() {
+      shutdown(_listener, SHUT_RDWR);
+      close(_listener);
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_client >= 0)
+          shutdown(_client, SHUT_RDWR);
+      }
+      _thread.join();
+    }
+
+    uint16_t getPort() const { return _port; }
+
+    void set(uint8_t unit, uint16_t address, std::initializer_list<uint16_t> words) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      for (uint16_t word : words)
+        _registers[{unit, address++}] = word;
+    }
+
+    void setException(uint8_t unit, uint8_t code) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _exceptions[unit] = code;
+    }
+
+    size_t getRequests() {
+      std::lock_guard<std::mutex> lock(_mutex);
+      return _requests;
+    }
+
+  private:
+    int _listener;
+    int _client = -1;
+    uint16_t _port;
+    std::thread _thread;
+    std::mutex _mutex;
+    std::map<std::tuple<uint8_t, uint16_t>, uint16_t> _registers;
+    std::map<uint8_t, uint8_t> _exceptions;
+    size_t _requests = 0;
+
+    void _serve() {
+      for (;;) {
+        const int client = accept(_listener, nullptr, nullptr);
+        if (client < 0)
+          return;
+        {
+          std::lock_guard<std::mutex> lock(_mutex);
+          _client = client;
+        }
+        uint8_t request[12];
+        while (recv(client, request, sizeof(request), MSG_WAITALL) == sizeof(request)) {
+          const uint8_t unit = request[6];
+          const uint8_t function = request[7];
+          const uint16_t address = (request[8] << 8) | request[9];
+          const uint16_t count = (request[10] << 8) | request[11];
+
+          std::vector<uint8_t> response(request, request + 7);
+          {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _requests++;
+            auto exception = _exceptions.find(unit);
+            if (exception != _exceptions.end()) {
+              response.push_back(function | 0x80);
+              response.push_back(exception->second);
+            } else {
+              response.push_back(function);
+              response.push_back(2 * count);
+              for (uint16_t i = 0; i < count; i++) {
+                auto it = _registers.find({unit, address + i});
+                const uint16_t word = it == _registers.end() ? 0 : it->second;
+                response.push_back(word >> 8);
+                response.push_back(word & 0xFF);
+              }
+            }
+          }
+          const uint16_t length = response.size() - 6;
+          response[4] = length >> 8;
+          response[5] = length & 0xFF;
+          send(client, response.data(), response.size(), MSG_NOSIGNAL);
+        }
+        std::lock_guard<std::mutex> lock(_mutex);
+        close(client);
+        _client = -1;
+      }
+    }
+};
+
+struct Events {
+    std::mutex mutex;
+    size_t reads = 0;
+    size_t errors = 0;
+
+    void listen(Mycila::ModbusMeter& meter) {
+      meter.setCallback([this](Mycila::ModbusMeter::EventType event) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (event == Mycila::ModbusMeter::EventType::EVT_READ)
+          reads++;
+        else
+          errors++;
+      });
+    }
+
+    // waits until reads + errors reach the expected count
+    bool wait(size_t count) {
+      for (int i = 0; i < 200; i++) {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (reads + errors >= count)
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+      return false;
+    }
+};
+
+static void testVictron(StandInServer& server) {
+  // 230.1 V, 5.2 A, 50 Hz, 1200 W on phase 1
+  server.set(228, 3, {2301, 0, 0, 52, 0, 0, 5000, 0, 0, 120, 0, 0});
+
+  Mycila::ModbusMeter meter;
+  Events events;
+  events.listen(meter);
+  meter.begin("127.0.0.1", server.getPort(), Mycila::Modbus::VICTRON);
+
+  for (size_t i = 1; i <= 3; i++) {
+    CHECK(meter.read());
+    CHECK(events.wait(i));
+    CHECK(!meter.isReading());
+  }
+
+  CHECK(events.reads == 3);
+  CHECK(!meter.hasError());
+  CHECK_NEAR(meter.getMetrics().voltage, 230.1f);
+  CHECK_NEAR(meter.getMetrics().current, 5.2f);
+  CHECK_NEAR(meter.getMetrics().frequency, 50.0f);
+  CHECK_NEAR(meter.getMetrics().power, 1200.0f);
+
+  meter.end();
+}
+
+// responses handled before addRequest() returns must complete the read
+static void testResponseBeforeRequestReturns(StandInServer& server) {
+  server.set(3, 30581, {0x0012, 0xD687, 0x000B, 0xADF8});
+  server.set(3, 30865, {0, 1200, 0, 0});
+  server.set(3, 31253, {0, 23010});
+  server.set(3, 31447, {0, 5000});
+
+  Mycila::ModbusMeter meter;
+  Events events;
+  events.listen(meter);
+  meter.begin("127.0.0.1", server.getPort(), Mycila::Modbus::SMA);
+
+  ModbusClientTCPasync::lockstep = true;
+  CHECK(meter.read());
+  ModbusClientTCPasync::lockstep = false;
+
+  CHECK(events.wait(1));
+  CHECK(events.reads == 1);
+  CHECK(!meter.isReading());
+  CHECK_NEAR(meter.getMetrics().power, 1200.0f);
+  CHECK_NEAR(meter.getMetrics().voltage, 230.1f);
+  CHECK_NEAR(meter.getMetrics().energy, 1234567.0f);
+  CHECK_NEAR(meter.getMetrics().energyReturned, 765432.0f);
+
+  meter.end();
+}
+
+static void testException(StandInServer& server) {
+  server.setException(1, 0x02);
+
+  Mycila::ModbusMeter meter;
+  Events events;
+  events.listen(meter);
+  meter.begin("127.0.0.1", server.getPort(), Mycila::Modbus::SOLAREDGE);
+
+  CHECK(meter.read());
+  CHECK(events.wait(1));
+  CHECK(events.errors == 1);
+  CHECK(meter.hasError());
+  // the failed read does not block the next one
+  CHECK(!meter.isReading());
+  CHECK(meter.read());
+
+  meter.end();
+}
+
+// a request that cannot be sent cancels the whole read
+static void testCancelledRead(StandInServer& server) {
+  static const Mycila::Modbus::Register REGISTERS[] = {
+    {Mycila::Modbus::Metric::POWER, 10, 0x03, 0, Mycila::Modbus::Type::INT16, Mycila::Modbus::WordOrder::HIGH_FIRST, 1.0f, 0, 0},
+    // function not supported by the client
+    {Mycila::Modbus::Metric::VOLTAGE, 10, 0x07, 0, Mycila::Modbus::Type::INT16, Mycila::Modbus::WordOrder::HIGH_FIRST, 1.0f, 0, 0},
+  };
+  static const Mycila::Modbus::Map MAP = {"Broken", REGISTERS, 2};
+  server.set(10, 0, {1200});
+
+  Mycila::ModbusMeter meter;
+  Events events;
+  events.listen(meter);
+  meter.begin("127.0.0.1", server.getPort(), MAP);
+
+  const size_t requests = server.getRequests();
+  CHECK(!meter.read());
+  CHECK(!meter.isReading());
+  CHECK(meter.hasError());
+  CHECK(events.errors == 1);
+
+  // the response of the first request is discarded
+  while (server.getRequests() == requests)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  CHECK(events.reads == 0);
+  CHECK(std::isnan(meter.getMetrics().power));
+
+  meter.end();
+}
+
+int main() {
+  StandInServer server;
+  testVictron(server);
+  testResponseBeforeRequestReturns(server);
+  testException(server);
+  testCancelledRead(server);
+  printf("%s\n", failures ? "FAILED" : "OK");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2023-2025 Mathieu Carbou
+ */
+// Rolls samples over the levels of Mycila::TimeSeries and downsamples them
+#include <MycilaTimeSeries.h>
+
+#include <cstdio>
+
+static int failures = 0;
+
+#define CHECK(condition)                                                     \
+  do {                                                                       \
+    if (!(condition)) {                                                      \
+      printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+      failures++;                                                            \
+    }                                                                        \
+  } while (0)
+
+static void testAdd() {
+  // 4 samples, then 3 averages of 2 samples, then 2 averages of 3 averages
+  const uint16_t factors[] = {2, 3};
+  Mycila::TimeSeries<int16_t, 4, 3, 2> series(factors);
+  CHECK(series.capacity(0) == 4 && series.capacity(1) == 3 && series.capacity(2) == 2);
+  CHECK(series.period(0) == 1 && series.period(1) == 2 && series.period(2) == 6);
+
+  series.add(1);
+  CHECK(series.size(0) == 1 && series.size(1) == 0 && series.size(2) == 0);
+
+  for (int16_t i = 2; i <= 12; i++)
+    series.add(i);
+
+  // level 0 keeps the last samples, oldest first
+  CHECK(series.size(0) == 4);
+  CHECK(series.get(0, 0) == 9 && series.get(0, 1) == 10 && series.get(0, 2) == 11 && series.get(0, 3) == 12);
+
+  // level 1 keeps the last 3 of the 6 averages: 7.5, 9.5 and 11.5, rounded
+  CHECK(series.size(1) == 3);
+  CHECK(series.get(1, 0) == 8 && series.get(1, 1) == 10 && series.get(1, 2) == 12);
+
+  // level 2 averages the unrounded averages of level 1: (1.5 + 3.5 + 5.5) / 3 and (7.5 + 9.5 + 11.5) / 3
+  CHECK(series.size(2) == 2);
+  CHECK(series.get(2, 0) == 4 && series.get(2, 1) == 10);
+
+  // an incomplete average is not visible
+  series.add(13);
+  CHECK(series.size(1) == 3 && series.get(1, 2) == 12);
+
+  series.clear();
+  CHECK(series.size(0) == 0 && series.size(1) == 0 && series.size(2) == 0);
+}
+
+static void testDownsample() {
+  const uint16_t factors[] = {10};
+  Mycila::TimeSeries<float, 100, 10> series(factors);
+  for (int i = 0; i < 100; i++)
+    series.add(i == 50 ? 1000 : i);
+
+  int32_t x[100];
+  float y[100];
+
+  // the first and last points are kept, and so is the peak
+  size_t n = series.downsample(0, 100, 10, x, y);
+  CHECK(n == 10);
+  CHECK(x[0] == -100 && y[0] == 0);
+  CHECK(x[9] == -1 && y[9] == 99);
+  bool peak = false;
+  for (size_t i = 0; i < n; i++) {
+    peak |= x[i] == -50 && y[i] == 1000;
+    if (i)
+      CHECK(x[i] > x[i - 1]);
+  }
+  CHECK(peak);
+
+  // no more points than the threshold: the last points are returned as they are
+  n = series.downsample(0, 5, 10, x, y);
+  CHECK(n == 5);
+  for (size_t i = 0; i < n; i++)
+    CHECK(x[i] == static_cast<int32_t>(i) - 5 && y[i] == 95 + i);
+
+  // more points requested than available
+  CHECK(series.downsample(0, 500, 200, x, y) == 100);
+  CHECK(x[0] == -100 && x[99] == -1);
+
+  // a threshold too small for the algorithm keeps the last points
+  n = series.downsample(0, 100, 2, x, y);
+  CHECK(n == 2);
+  CHECK(x[0] == -2 && y[0] == 98 && x[1] == -1 && y[1] == 99);
+
+  // ages are counted in samples of level 0
+  n = series.downsample(1, 3, 10, x, y);
+  CHECK(n == 3);
+  CHECK(x[0] == -30 && x[1] == -20 && x[2] == -10);
+  CHECK(y[0] == 74.5f && y[1] == 84.5f && y[2] == 94.5f);
+
+  // the peak is averaged in its point of level 1
+  n = series.downsample(1, 10, 10, x, y);
+  CHECK(n == 10);
+  CHECK(x[5] == -50 && y[5] == 149.5f);
+}
+
+int main() {
+  testAdd();
+  testDownsample();
+  printf("%s\n", failures ? "FAILED" : "OK");
+  return failures ? 1 : 0;
+}